@@ -0,0 +1,512 @@
+// Benchmark do cJSON: parse, print e extração da resposta da IA.
+// Uso: json_bench [arquivos.json...]  (ex: make bench usa bench/corpus/*.json)
+// Além dos arquivos, gera documentos sintéticos grandes e entradas patológicas.
+
+#include "cJSON.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <pthread.h>
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+#define MIN_SECONDS 0.1
+#define CHUNK_SIZE 16384 // tamanho típico dos blocos entregues pelo cURL
+#define MAX_THREADS 16
+
+typedef struct {
+    char name[64];
+    char* text;
+    size_t length;
+} Document;
+
+// Contagem de alocações feitas através dos hooks do cJSON
+static size_t allocationCount = 0;
+
+static void* countingMalloc(size_t size) {
+    allocationCount++;
+    return malloc(size);
+}
+
+static void countingFree(void* pointer) {
+    free(pointer);
+}
+
+static double nowSeconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+}
+
+static double peakRssMegabytes(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return (double)counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return (double)usage.ru_maxrss / (1024.0 * 1024.0); // bytes no macOS
+#else
+    return (double)usage.ru_maxrss / 1024.0; // KB no Linux
+#endif
+#endif
+}
+
+static void report(const Document* doc, const char* operation, size_t bytesPerRun, int runs, double seconds, size_t allocations) {
+    printf("%-28s %-22s %10.1f MB/s %12.1f aloc/doc\n",
+           doc->name, operation,
+           (double)bytesPerRun * runs / seconds / 1e6,
+           (double)allocations / runs);
+}
+
+// ---------- Operações medidas (cada uma processa o documento uma vez) ----------
+
+static int runParse(const Document* doc, void* scratch) {
+    (void)scratch;
+    cJSON* root = cJSON_ParseWithLength(doc->text, doc->length);
+    int ok = root != NULL;
+    cJSON_Delete(root);
+    return ok;
+}
+
+static int runParseInSitu(const Document* doc, void* scratch) {
+    // A cópia faz parte do custo: o buffer é destruído pelo parse
+    char* buffer = (char*)scratch;
+    memcpy(buffer, doc->text, doc->length + 1);
+    cJSON* root = cJSON_ParseInSitu(buffer, doc->length);
+    int ok = root != NULL;
+    cJSON_Delete(root);
+    return ok;
+}
+
+static int runParseInterned(const Document* doc, void* scratch) {
+    cJSON_Context* context = (cJSON_Context*)scratch;
+    cJSON* root = cJSON_ParseWithContext(context, doc->text, doc->length, NULL, 0);
+    int ok = root != NULL;
+    cJSON_DeleteWithContext(context, root);
+    return ok;
+}
+
+static int runStream(const Document* doc, void* scratch) {
+    (void)scratch;
+    cJSON_Stream* stream = cJSON_CreateStream();
+    for (size_t offset = 0; offset < doc->length; offset += CHUNK_SIZE) {
+        size_t size = doc->length - offset < CHUNK_SIZE ? doc->length - offset : CHUNK_SIZE;
+        cJSON_StreamFeed(stream, doc->text + offset, size);
+    }
+    int ok = cJSON_StreamFinish(stream);
+    cJSON_Delete(cJSON_StreamDetachRoot(stream));
+    cJSON_DeleteStream(stream);
+    return ok;
+}
+
+// Mesmo fluxo de try_model_with_retry: só os dois caminhos que interessam são montados
+static int runStreamPaths(const Document* doc, void* scratch) {
+    (void)scratch;
+    cJSON_Stream* stream = cJSON_CreateStream();
+    int errorPath = cJSON_StreamAddPath(stream, "error/message");
+    int textPath = cJSON_StreamAddPath(stream, "candidates/0/content/parts/0/text");
+    for (size_t offset = 0; offset < doc->length; offset += CHUNK_SIZE) {
+        size_t size = doc->length - offset < CHUNK_SIZE ? doc->length - offset : CHUNK_SIZE;
+        cJSON_StreamFeed(stream, doc->text + offset, size);
+    }
+    int ok = cJSON_StreamFinish(stream);
+    cJSON_Delete(cJSON_StreamDetachPathValue(stream, errorPath));
+    cJSON_Delete(cJSON_StreamDetachPathValue(stream, textPath));
+    cJSON_DeleteStream(stream);
+    return ok;
+}
+
+static int runExtractPath(const Document* doc, void* scratch) {
+    (void)scratch;
+    char* text = cJSON_ExtractPath(doc->text, doc->length, "candidates/0/content/parts/0/text");
+    cJSON_free(text);
+    return 1;
+}
+
+static int runPrintUnformatted(const Document* doc, void* scratch) {
+    (void)doc;
+    char* printed = cJSON_PrintUnformatted((const cJSON*)scratch);
+    int ok = printed != NULL;
+    cJSON_free(printed);
+    return ok;
+}
+
+static int runPrintFormatted(const Document* doc, void* scratch) {
+    (void)doc;
+    char* printed = cJSON_Print((const cJSON*)scratch);
+    int ok = printed != NULL;
+    cJSON_free(printed);
+    return ok;
+}
+
+typedef int (*Operation)(const Document* doc, void* scratch);
+
+// Repete a operação até passar MIN_SECONDS e imprime a vazão
+static void measure(const Document* doc, const char* name, Operation operation, void* scratch, size_t bytesPerRun) {
+    int runs = 0;
+    double start = nowSeconds();
+    double elapsed = 0.0;
+
+    allocationCount = 0;
+    do {
+        if (!operation(doc, scratch) && runs == 0) {
+            printf("%-28s %-22s (entrada rejeitada)\n", doc->name, name);
+        }
+        runs++;
+        elapsed = nowSeconds() - start;
+    } while (elapsed < MIN_SECONDS);
+
+    report(doc, name, bytesPerRun, runs, elapsed, allocationCount);
+}
+
+static void benchDocument(const Document* doc) {
+    char* buffer = (char*)malloc(doc->length + 1);
+    cJSON_Hooks hooks = { countingMalloc, countingFree };
+    cJSON_Context* interning = cJSON_CreateContext(&hooks);
+    cJSON_EnableKeyInterning(interning);
+
+    measure(doc, "parse", runParse, NULL, doc->length);
+    measure(doc, "parse in situ", runParseInSitu, buffer, doc->length);
+    measure(doc, "parse chaves internas", runParseInterned, interning, doc->length);
+    measure(doc, "stream 16KB", runStream, NULL, doc->length);
+    // Os caminhos da resposta da IA só fazem sentido quando a raiz é um objeto
+    const char* first = doc->text + strspn(doc->text, " \t\r\n");
+    if (*first == '{') {
+        measure(doc, "stream caminhos IA", runStreamPaths, NULL, doc->length);
+        measure(doc, "extract path IA", runExtractPath, NULL, doc->length);
+    }
+
+    cJSON* root = cJSON_ParseWithLength(doc->text, doc->length);
+    if (root != NULL) {
+        char* printed = cJSON_PrintUnformatted(root);
+        size_t unformattedLength = strlen(printed);
+        cJSON_free(printed);
+        printed = cJSON_Print(root);
+        size_t formattedLength = strlen(printed);
+        cJSON_free(printed);
+
+        measure(doc, "print compacto", runPrintUnformatted, root, unformattedLength);
+        measure(doc, "print formatado", runPrintFormatted, root, formattedLength);
+        cJSON_Delete(root);
+    }
+
+    cJSON_DeleteContext(interning);
+    free(buffer);
+}
+
+// ---------- Documentos sintéticos ----------
+
+static void setDocument(Document* doc, const char* name, char* text) {
+    snprintf(doc->name, sizeof(doc->name), "%s", name);
+    doc->text = text;
+    doc->length = strlen(text);
+}
+
+static char* makeLeaderboard(int records) {
+    cJSON* root = cJSON_CreateArray();
+    for (int i = 0; i < records; i++) {
+        cJSON* player = cJSON_CreateObject();
+        char name[32];
+        sprintf(name, "Jogador %d", i);
+        cJSON_AddStringToObject(player, "name", name);
+        cJSON_AddNumberToObject(player, "totalScore", (i * 37) % 5000);
+        cJSON_AddStringToObject(player, "lastWord", "casa");
+        cJSON_AddNumberToObject(player, "round", i % 10);
+        cJSON_AddItemToArray(root, player);
+    }
+    char* text = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    return text;
+}
+
+static char* makeWideObject(int keys) {
+    cJSON* root = cJSON_CreateObject();
+    for (int i = 0; i < keys; i++) {
+        char key[32];
+        sprintf(key, "chave_%d", i);
+        cJSON_AddNumberToObject(root, key, i);
+    }
+    char* text = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    return text;
+}
+
+// Uma resposta com um texto enorme e cheio de escapes
+static char* makeLongEscapes(size_t pieces) {
+    const char* piece = "Linha com \\\"aspas\\\", \\\\barras\\\\ e acentos \\u00e9\\u00e7\\u00e3\\n";
+    const char* head = "{\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"";
+    const char* tail = "\"}],\"role\":\"model\"}}]}";
+    size_t pieceLength = strlen(piece);
+    char* text = (char*)malloc(strlen(head) + pieces * pieceLength + strlen(tail) + 1);
+    char* out = text;
+    out += sprintf(out, "%s", head);
+    for (size_t i = 0; i < pieces; i++) {
+        memcpy(out, piece, pieceLength);
+        out += pieceLength;
+    }
+    strcpy(out, tail);
+    return text;
+}
+
+static char* makeDeepNesting(int depth) {
+    char* text = (char*)malloc((size_t)depth * 2 + 1);
+    for (int i = 0; i < depth; i++) {
+        text[i] = '[';
+        text[2 * depth - 1 - i] = ']';
+    }
+    text[2 * depth] = '\0';
+    return text;
+}
+
+static char* makeHugeNumbers(int count) {
+    const char* samples[] = {
+        "123456789012345678901234567890", "-0.000000000000000000000000000001234567890123456789",
+        "1.7976931348623157e308", "4.9406564584124654e-324", "2.2250738585072011e-308",
+        "9007199254740993", "0.1e-400", "123456789e-350", "1e308", "-98765432109876543210.123456789e-20"
+    };
+    size_t capacity = (size_t)count * 64 + 16;
+    char* text = (char*)malloc(capacity);
+    char* out = text;
+    *out++ = '[';
+    for (int i = 0; i < count; i++) {
+        out += sprintf(out, "%s%s", i ? "," : "", samples[i % 10]);
+    }
+    strcpy(out, "]");
+    return text;
+}
+
+// ---------- Índices de objetos e arrays ----------
+
+#define LOOKUP_KEYS 4096
+#define LOOKUP_SECONDS 0.3 // orçamento de cada medida sem índice, que custa O(n) por busca
+
+static unsigned int lookupState = 2463534242u;
+static long lookupSink = 0;
+
+static unsigned int nextLookup(void) {
+    lookupState ^= lookupState << 13;
+    lookupState ^= lookupState >> 17;
+    lookupState ^= lookupState << 5;
+    return lookupState;
+}
+
+// Quantas buscas cabem no orçamento, supondo uns 2 ns por filho percorrido
+static int lookupsFor(int children, int indexed) {
+    long count = indexed ? 200000 : (long)(LOOKUP_SECONDS / (children * 1e-9));
+    if (count > 200000) count = 200000;
+    if (count < 100) count = 100;
+    return (int)count;
+}
+
+static double timeObjectLookups(const cJSON* object, char (*keys)[32], int lookups) {
+    double start = nowSeconds();
+    for (int i = 0; i < lookups; i++) {
+        lookupSink += cJSON_GetObjectItemCaseSensitive(object, keys[i % LOOKUP_KEYS]) != NULL;
+    }
+    return (nowSeconds() - start) * 1e9 / lookups;
+}
+
+static double timeArrayLookups(const cJSON* array, const int* positions, int lookups) {
+    double start = nowSeconds();
+    for (int i = 0; i < lookups; i++) {
+        lookupSink += cJSON_GetArrayItem(array, positions[i % LOOKUP_KEYS]) != NULL;
+    }
+    return (nowSeconds() - start) * 1e9 / lookups;
+}
+
+// Mesmas buscas aleatórias no mesmo objeto e no mesmo array, primeiro andando pela
+// lista e depois com o índice de cJSON_BuildIndex. O make bench compila com
+// CJSON_INDEX_THRESHOLD=0 para medir o índice também abaixo do limite padrão.
+static void benchLookups(void) {
+    int sizes[] = { 4, 8, 16, 32, 64, 256, 1024, 16384, 262144, 1048576 };
+    char (*keys)[32] = (char (*)[32])malloc(sizeof(*keys) * LOOKUP_KEYS);
+    int* positions = (int*)malloc(sizeof(int) * LOOKUP_KEYS);
+    if (keys == NULL || positions == NULL) {
+        free(keys);
+        free(positions);
+        return;
+    }
+
+    printf("\nBuscas (ns por busca, CJSON_INDEX_THRESHOLD=%d; indices em ms)\n", (int)CJSON_INDEX_THRESHOLD);
+    printf("%10s %14s %14s %14s %14s %12s\n", "filhos", "objeto lista", "objeto indice", "array lista", "array indice", "criar");
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int size = sizes[s];
+        cJSON* object = cJSON_CreateObject();
+        cJSON* array = cJSON_CreateArray();
+        char key[32];
+        for (int i = 0; i < size; i++) {
+            sprintf(key, "chave_%d", i);
+            cJSON_AddNumberToObject(object, key, i);
+            cJSON_AddItemToArray(array, cJSON_CreateNumber(i));
+        }
+        for (int i = 0; i < LOOKUP_KEYS; i++) {
+            positions[i] = (int)(nextLookup() % (unsigned int)size);
+            sprintf(keys[i], "chave_%d", positions[i]);
+        }
+
+        double objectList = timeObjectLookups(object, keys, lookupsFor(size, 0));
+        double arrayList = timeArrayLookups(array, positions, lookupsFor(size, 0));
+        double start = nowSeconds();
+        cJSON_BuildIndex(object);
+        cJSON_BuildIndex(array);
+        double buildSeconds = nowSeconds() - start;
+        double objectIndexed = timeObjectLookups(object, keys, lookupsFor(size, 1));
+        double arrayIndexed = timeArrayLookups(array, positions, lookupsFor(size, 1));
+
+        printf("%10d %14.1f %14.1f %14.1f %14.1f %12.3f\n", size, objectList, objectIndexed, arrayList, arrayIndexed, buildSeconds * 1000);
+        cJSON_Delete(object);
+        cJSON_Delete(array);
+    }
+    printf("(%ld encontradas)\n", lookupSink);
+
+    free(keys);
+    free(positions);
+}
+
+// ---------- Parse em várias threads, cada uma com o seu contexto ----------
+
+typedef struct {
+    const Document* doc;
+    int runs;
+    int failures;
+} ThreadJob;
+
+#ifdef _WIN32
+static DWORD WINAPI parseWorker(LPVOID argument)
+#else
+static void* parseWorker(void* argument)
+#endif
+{
+    ThreadJob* job = (ThreadJob*)argument;
+    cJSON_Context* context = cJSON_CreateContext(NULL);
+    for (int i = 0; i < job->runs; i++) {
+        cJSON* root = cJSON_ParseWithContext(context, job->doc->text, job->doc->length, NULL, 0);
+        if (root == NULL) {
+            job->failures++;
+        }
+        cJSON_DeleteWithContext(context, root);
+    }
+    cJSON_DeleteContext(context);
+    return 0;
+}
+
+static void benchThreads(const Document* doc, int maxThreads) {
+    const int runsPerThread = 20;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        ThreadJob jobs[MAX_THREADS];
+        int failures = 0;
+        double start = nowSeconds();
+#ifdef _WIN32
+        HANDLE handles[MAX_THREADS];
+        for (int i = 0; i < threads; i++) {
+            jobs[i] = (ThreadJob){ doc, runsPerThread, 0 };
+            handles[i] = CreateThread(NULL, 0, parseWorker, &jobs[i], 0, NULL);
+        }
+        WaitForMultipleObjects((DWORD)threads, handles, TRUE, INFINITE);
+        for (int i = 0; i < threads; i++) {
+            CloseHandle(handles[i]);
+        }
+#else
+        pthread_t handles[MAX_THREADS];
+        for (int i = 0; i < threads; i++) {
+            jobs[i] = (ThreadJob){ doc, runsPerThread, 0 };
+            pthread_create(&handles[i], NULL, parseWorker, &jobs[i]);
+        }
+        for (int i = 0; i < threads; i++) {
+            pthread_join(handles[i], NULL);
+        }
+#endif
+        double elapsed = nowSeconds() - start;
+        for (int i = 0; i < threads; i++) {
+            failures += jobs[i].failures;
+        }
+        char label[32];
+        sprintf(label, "parse %d thread(s)", threads);
+        printf("%-28s %-22s %10.1f MB/s agregado%s\n", doc->name, label,
+               (double)doc->length * runsPerThread * threads / elapsed / 1e6,
+               failures ? " (FALHAS!)" : "");
+    }
+}
+
+static char* readFile(const char* path, size_t* length) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = (char*)malloc((size_t)size + 1);
+    *length = fread(text, 1, (size_t)size, file);
+    text[*length] = '\0';
+    fclose(file);
+    return text;
+}
+
+int main(int argc, char** argv) {
+    Document docs[64];
+    int docCount = 0;
+    int maxThreads = 4;
+
+    for (int i = 1; i < argc && docCount < 59; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            maxThreads = atoi(argv[++i]);
+            if (maxThreads < 1) maxThreads = 1;
+            if (maxThreads > MAX_THREADS) maxThreads = MAX_THREADS;
+            continue;
+        }
+        size_t length = 0;
+        char* text = readFile(argv[i], &length);
+        if (text == NULL) {
+            fprintf(stderr, "Erro ao abrir %s\n", argv[i]);
+            continue;
+        }
+        const char* base = strrchr(argv[i], '/');
+        setDocument(&docs[docCount], base ? base + 1 : argv[i], text);
+        docs[docCount].length = length;
+        docCount++;
+    }
+
+    setDocument(&docs[docCount++], "placar 100k registros", makeLeaderboard(100000));
+    setDocument(&docs[docCount++], "objeto 20k chaves", makeWideObject(20000));
+    setDocument(&docs[docCount++], "texto longo com escapes", makeLongEscapes(50000));
+    setDocument(&docs[docCount++], "aninhamento 900 niveis", makeDeepNesting(900));
+    setDocument(&docs[docCount++], "numeros enormes", makeHugeNumbers(50000));
+
+    cJSON_Hooks hooks = { countingMalloc, countingFree };
+    cJSON_InitHooks(&hooks);
+
+    printf("%-28s %-22s %15s %21s\n", "documento", "operacao", "vazao", "alocacoes");
+    for (int i = 0; i < docCount; i++) {
+        benchDocument(&docs[i]);
+    }
+
+    benchLookups();
+    benchThreads(&docs[docCount - 5], maxThreads);
+
+    printf("\nPico de memoria (RSS): %.1f MB\n", peakRssMegabytes());
+
+    for (int i = 0; i < docCount; i++) {
+        free(docs[i].text);
+    }
+    return 0;
+}
@@ -0,0 +1,269 @@
+// Harness de fuzzing do cJSON no formato do libFuzzer (LLVMFuzzerTestOneInput).
+// Compara os caminhos rápidos (in situ, chaves internas, stream, ExtractPath, PrintBuffered)
+// com o parse normal e aborta na primeira divergência.
+//
+// Com libFuzzer: clang -fsanitize=fuzzer,address -DJSON_FUZZ_LIBFUZZER ...
+// Sem libFuzzer: json_fuzz [-n mutacoes] arquivos.json...  (roda o corpus e mutações aleatórias)
+
+#include "cJSON.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FUZZ_CHUNK 7 // blocos pequenos para exercitar os cortes no meio de tokens
+
+static void fail(const char* check, const uint8_t* data, size_t size) {
+    fprintf(stderr, "Divergência em %s (entrada de %lu bytes):\n%.*s\n",
+            check, (unsigned long)size, (int)(size > 512 ? 512 : size), (const char*)data);
+    abort();
+}
+
+static cJSON_bool sameTree(const cJSON* a, const cJSON* b) {
+    if (a == NULL || b == NULL) {
+        return a == b;
+    }
+    char* printedA = cJSON_PrintUnformatted(a);
+    char* printedB = cJSON_PrintUnformatted(b);
+    cJSON_bool same = printedA != NULL && printedB != NULL && strcmp(printedA, printedB) == 0;
+    cJSON_free(printedA);
+    cJSON_free(printedB);
+    return same;
+}
+
+// parse -> print -> parse -> print precisa chegar ao mesmo texto
+static void checkRoundTrip(const cJSON* root, const uint8_t* data, size_t size) {
+    char* first = cJSON_PrintUnformatted(root);
+    if (first == NULL) {
+        fail("print", data, size);
+    }
+    cJSON* again = cJSON_Parse(first);
+    char* second = again != NULL ? cJSON_PrintUnformatted(again) : NULL;
+    if (second == NULL || strcmp(first, second) != 0) {
+        fail("ida e volta do print", data, size);
+    }
+    cJSON_free(second);
+    cJSON_Delete(again);
+
+    // O print formatado também precisa ser relido como a mesma árvore
+    char* formatted = cJSON_Print(root);
+    again = formatted != NULL ? cJSON_Parse(formatted) : NULL;
+    if (!sameTree(root, again)) {
+        fail("print formatado", data, size);
+    }
+    cJSON_Delete(again);
+    cJSON_free(formatted);
+    cJSON_free(first);
+}
+
+// O buffer inicial do PrintBuffered não pode mudar o texto: testa todos os tamanhos
+// de 0 até strlen + 1. Em textos grandes, as pontas inteiras e o meio em saltos.
+#define FULL_PREBUFFER_SWEEP 128
+#define PREBUFFER_EDGE 32
+#define PREBUFFER_STRIDE 29
+
+static void checkPrintBuffered(const cJSON* root, const uint8_t* data, size_t size) {
+    for (int format = 0; format <= 1; format++) {
+        char* expected = format ? cJSON_Print(root) : cJSON_PrintUnformatted(root);
+        if (expected == NULL) {
+            fail("print", data, size);
+        }
+        int length = (int)strlen(expected);
+        for (int prebuffer = 0; prebuffer <= length + 1; prebuffer++) {
+            if (length > FULL_PREBUFFER_SWEEP && prebuffer > PREBUFFER_EDGE && prebuffer < length - PREBUFFER_EDGE) {
+                prebuffer += PREBUFFER_STRIDE - 1;
+            }
+            char* printed = cJSON_PrintBuffered(root, prebuffer, format);
+            if (printed == NULL || strcmp(printed, expected) != 0) {
+                fail(format ? "print buffered formatado" : "print buffered", data, size);
+            }
+            cJSON_free(printed);
+        }
+        cJSON_free(expected);
+    }
+}
+
+static void checkInSitu(const cJSON* root, const uint8_t* data, size_t size) {
+    char* buffer = (char*)malloc(size + 1);
+    memcpy(buffer, data, size);
+    buffer[size] = '\0';
+    cJSON* inSitu = cJSON_ParseInSitu(buffer, size);
+    if (!sameTree(root, inSitu)) {
+        fail("parse in situ", data, size);
+    }
+    cJSON_Delete(inSitu);
+    free(buffer);
+}
+
+static void checkInterned(const cJSON* root, const uint8_t* data, size_t size) {
+    cJSON_Context* context = cJSON_CreateContext(NULL);
+    cJSON_EnableKeyInterning(context);
+    cJSON* interned = cJSON_ParseWithContext(context, (const char*)data, size, NULL, 0);
+    if (!sameTree(root, interned)) {
+        fail("parse com chaves internas", data, size);
+    }
+    cJSON_DeleteWithContext(context, interned);
+    cJSON_DeleteContext(context);
+}
+
+// O stream rejeita lixo depois do valor, então a referência só vale se o resto for espaço
+static void checkStream(const uint8_t* data, size_t size) {
+    const char* end = NULL;
+    cJSON* root = cJSON_ParseWithLengthOpts((const char*)data, size, &end, 0);
+    if (root != NULL) {
+        while (end < (const char*)data + size && (unsigned char)*end <= 32) {
+            end++;
+        }
+        if (end != (const char*)data + size) {
+            cJSON_Delete(root);
+            root = NULL;
+        }
+    }
+    cJSON_Stream* stream = cJSON_CreateStream();
+    for (size_t offset = 0; offset < size; offset += FUZZ_CHUNK) {
+        size_t chunk = size - offset < FUZZ_CHUNK ? size - offset : FUZZ_CHUNK;
+        if (!cJSON_StreamFeed(stream, (const char*)data + offset, chunk)) {
+            break;
+        }
+    }
+    cJSON_bool ok = cJSON_StreamFinish(stream);
+    cJSON* streamed = cJSON_StreamDetachRoot(stream);
+    if ((ok != 0) != (root != NULL) || (ok && !sameTree(root, streamed))) {
+        fail("stream", data, size);
+    }
+    cJSON_Delete(streamed);
+    cJSON_DeleteStream(stream);
+    cJSON_Delete(root);
+}
+
+// Mesmo caminho usado em try_model_with_retry
+static void checkExtractPath(const cJSON* root, const uint8_t* data, size_t size) {
+    const cJSON* node = cJSON_GetObjectItemCaseSensitive(root, "candidates");
+    node = cJSON_GetArrayItem(node, 0);
+    node = cJSON_GetObjectItemCaseSensitive(node, "content");
+    node = cJSON_GetObjectItemCaseSensitive(node, "parts");
+    node = cJSON_GetArrayItem(node, 0);
+    node = cJSON_GetObjectItemCaseSensitive(node, "text");
+    const char* expected = cJSON_IsString(node) ? node->valuestring : NULL;
+
+    char* extracted = cJSON_ExtractPath((const char*)data, size, "candidates/0/content/parts/0/text");
+    if ((expected == NULL) != (extracted == NULL) ||
+        (expected != NULL && strcmp(expected, extracted) != 0)) {
+        fail("extract path", data, size);
+    }
+    cJSON_free(extracted);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    cJSON* root = cJSON_ParseWithLength((const char*)data, size);
+
+    checkStream(data, size);
+    if (root != NULL) {
+        checkRoundTrip(root, data, size);
+        checkPrintBuffered(root, data, size);
+        checkInSitu(root, data, size);
+        checkInterned(root, data, size);
+        // Com chaves duplicadas a busca na árvore e o ExtractPath podem escolher ocorrências diferentes
+        if (cJSON_IsObject(root)) {
+            checkExtractPath(root, data, size);
+        }
+    }
+
+    cJSON_Delete(root);
+    return 0;
+}
+
+#ifndef JSON_FUZZ_LIBFUZZER
+
+static uint32_t randomState = 2463534242u;
+
+static uint32_t nextRandom(void) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+// Troca, apaga ou duplica alguns bytes, preferindo os caracteres estruturais do JSON
+static size_t mutate(uint8_t* out, const uint8_t* in, size_t size, size_t capacity) {
+    static const char alphabet[] = "{}[]\":,\\ntfu0123456789-+.eE ";
+    size_t length = size;
+    memcpy(out, in, size);
+
+    int edits = 1 + (int)(nextRandom() % 4);
+    for (int i = 0; i < edits && length > 0; i++) {
+        size_t position = nextRandom() % length;
+        switch (nextRandom() % 3) {
+        case 0:
+            out[position] = (uint8_t)alphabet[nextRandom() % (sizeof(alphabet) - 1)];
+            break;
+        case 1:
+            memmove(out + position, out + position + 1, length - position - 1);
+            length--;
+            break;
+        default:
+            if (length < capacity) {
+                memmove(out + position + 1, out + position, length - position);
+                length++;
+            }
+            break;
+        }
+    }
+    return length;
+}
+
+static uint8_t* readFile(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t* data = (uint8_t*)malloc((size_t)length + 1);
+    *size = fread(data, 1, (size_t)length, file);
+    fclose(file);
+    return data;
+}
+
+int main(int argc, char** argv) {
+    long mutations = 1000;
+    int files = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            mutations = atol(argv[++i]);
+            continue;
+        }
+
+        size_t size = 0;
+        uint8_t* data = readFile(argv[i], &size);
+        if (data == NULL) {
+            fprintf(stderr, "Erro ao abrir %s\n", argv[i]);
+            continue;
+        }
+
+        LLVMFuzzerTestOneInput(data, size);
+
+        size_t capacity = size + 64;
+        uint8_t* mutated = (uint8_t*)malloc(capacity);
+        for (long m = 0; m < mutations; m++) {
+            size_t length = mutate(mutated, data, size, capacity);
+            LLVMFuzzerTestOneInput(mutated, length);
+        }
+        printf("%s: ok (%ld mutações)\n", argv[i], mutations);
+
+        free(mutated);
+        free(data);
+        files++;
+    }
+
+    if (files == 0) {
+        fprintf(stderr, "Uso: %s [-n mutacoes] arquivos.json...\n", argv[0]);
+        return 1;
+    }
+    return 0;
+}
+
+#endif
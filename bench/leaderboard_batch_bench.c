@@ -0,0 +1,130 @@
+// Benchmark das atualizações em lote: custo por ponto aplicado com updateScore
+// um a um e com applyScoreBatch, para vários tamanhos de placar e de lote.
+// Metade dos nomes de cada lote aparece duas vezes, como bots pontuando em vários temas.
+// Uso: leaderboard_batch_bench [maximo_de_jogadores]  (padrão 1000000)
+
+#include "leaderboard.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define DELTAS_PER_RUN 200000
+
+static double nowSeconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+}
+
+static unsigned int randomState = 2463534242u;
+
+static unsigned int nextRandom(void) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+static int loadBoard(Leaderboard* board, int playerCount, char (*names)[50]) {
+    PlayerScore* players = (PlayerScore*)malloc(sizeof(PlayerScore) * (size_t)playerCount);
+    if (players == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < playerCount; i++) {
+        players[i].name = names[i];
+        players[i].totalScore = (int)(nextRandom() % 100000);
+    }
+    int ok = bulkLoadLeaderboard(board, players, playerCount);
+    free(players);
+    return ok;
+}
+
+static void fillDeltas(ScoreDelta* deltas, int batchSize, int playerCount, char (*names)[50]) {
+    for (int i = 0; i < batchSize; i++) {
+        if (i % 2 == 1) {
+            deltas[i].name = deltas[i - 1].name;
+        } else {
+            deltas[i].name = names[nextRandom() % (unsigned int)playerCount];
+        }
+        deltas[i].points = (int)(nextRandom() % 50);
+    }
+}
+
+static void benchSize(int playerCount, char (*names)[50]) {
+    int batchSizes[] = { 1, 4, 16, 64, 512, 4096 };
+    ScoreDelta* deltas = (ScoreDelta*)malloc(sizeof(ScoreDelta) * DELTAS_PER_RUN);
+    if (deltas == NULL) {
+        return;
+    }
+
+    for (int b = 0; b < (int)(sizeof(batchSizes) / sizeof(batchSizes[0])); b++) {
+        int batchSize = batchSizes[b];
+        int batches = DELTAS_PER_RUN / batchSize;
+        fillDeltas(deltas, batches * batchSize, playerCount, names);
+
+        Leaderboard single = {0};
+        Leaderboard batched = {0};
+        if (!loadBoard(&single, playerCount, names) || !loadBoard(&batched, playerCount, names)) {
+            printf("%10d  sem memória\n", playerCount);
+            freeLeaderboard(&single);
+            freeLeaderboard(&batched);
+            break;
+        }
+
+        double start = nowSeconds();
+        for (int i = 0; i < batches * batchSize; i++) {
+            updateScore(&single, deltas[i].name, deltas[i].points);
+        }
+        double singleSeconds = nowSeconds() - start;
+
+        start = nowSeconds();
+        for (int i = 0; i < batches; i++) {
+            applyScoreBatch(&batched, deltas + (size_t)i * batchSize, batchSize);
+        }
+        double batchSeconds = nowSeconds() - start;
+
+        double total = (double)batches * batchSize;
+        printf("%10d %8d %14.1f %14.1f %10.2fx\n", playerCount, batchSize,
+               singleSeconds * 1e9 / total, batchSeconds * 1e9 / total, singleSeconds / batchSeconds);
+        freeLeaderboard(&single);
+        freeLeaderboard(&batched);
+    }
+    free(deltas);
+}
+
+int main(int argc, char** argv) {
+    int maxPlayers = argc > 1 ? atoi(argv[1]) : 1000000;
+    if (maxPlayers < 1) {
+        maxPlayers = 1000000;
+    }
+
+    char (*names)[50] = (char (*)[50])malloc(sizeof(*names) * (size_t)maxPlayers);
+    if (names == NULL) {
+        fprintf(stderr, "Sem memória\n");
+        return 1;
+    }
+    for (int i = 0; i < maxPlayers; i++) {
+        snprintf(names[i], sizeof(names[i]), "Jogador %d", i);
+    }
+
+    printf("%10s %8s %14s %14s %11s\n", "jogadores", "lote", "um a um ns", "em lote ns", "ganho");
+    for (int playerCount = 1000; playerCount <= maxPlayers; playerCount *= 10) {
+        benchSize(playerCount, names);
+    }
+
+    free(names);
+    return 0;
+}
@@ -0,0 +1,273 @@
+// Benchmark do placar: carga (uma a uma e em lote), busca por nome, atualização,
+// posição de um jogador, k-ésimo lugar, top 10, vizinhança (2 acima e 2 abaixo
+// de um jogador pelo nome) e varredura de todas as posições em ordem (por
+// jogador), de 10 até 10M jogadores. A varredura roda também sobre uma cópia
+// da mesma árvore no nó antigo, de 80 bytes com o nome dentro.
+// Uso: leaderboard_bench [maximo_de_jogadores] [novo|antigo]  (padrão 10000000)
+// Com novo ou antigo, monta só o placar do tamanho máximo e repete a varredura
+// naquele layout, para medir com perf stat -e cache-misses,cache-references.
+
+#include "leaderboard.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define OPERATIONS 200000
+#define SCAN_REPEATS 20
+
+// O nó antes de os nomes irem para a tabela à parte: mesmos campos e o nome dentro
+typedef struct {
+    int totalScore;
+    uint32_t priority;
+    uint32_t sequence;
+    uint32_t size;
+    uint32_t self;
+    uint32_t left;
+    uint32_t right;
+    char name[50];
+} OldPlayerNode;
+
+static double nowSeconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+}
+
+static unsigned int randomState = 12345u;
+
+static unsigned int nextRandom(void) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+static void addScore(const PlayerNode* player, void* checksum) {
+    *(long*)checksum += player->totalScore;
+}
+
+// Mesma árvore e mesma ordem na memória (o índice do slab, que começa em 1), só com o nó antigo
+static OldPlayerNode* copyToOldLayout(const Leaderboard* board, PlayerNode** players, int playerCount) {
+    OldPlayerNode* nodes = (OldPlayerNode*)calloc((size_t)playerCount + 1, sizeof(OldPlayerNode));
+    if (nodes == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < playerCount; i++) {
+        const PlayerNode* player = players[i];
+        OldPlayerNode* node = &nodes[player->self];
+        node->totalScore = player->totalScore;
+        node->priority = player->priority;
+        node->sequence = player->sequence;
+        node->size = player->size;
+        node->self = player->self;
+        node->left = player->left;
+        node->right = player->right;
+        snprintf(node->name, sizeof(node->name), "%s", getPlayerName(board, player));
+    }
+    return nodes;
+}
+
+static void addOldScore(const OldPlayerNode* player, void* checksum) {
+    *(long*)checksum += player->totalScore;
+}
+
+// Igual ao forEachPlayer, só que sobre o nó antigo
+static void visitOldInOrder(const OldPlayerNode* nodes, uint32_t index, void (*visit)(const OldPlayerNode* player, void* userData), void* userData) {
+    while (index != LEADERBOARD_NO_PLAYER) {
+        const OldPlayerNode* node = &nodes[index];
+        visitOldInOrder(nodes, node->left, visit, userData);
+        visit(node, userData);
+        index = node->right;
+    }
+}
+
+static void loadPlayers(Leaderboard* board, PlayerNode** players, int playerCount) {
+    for (int i = 0; i < playerCount; i++) {
+        char name[50];
+        snprintf(name, sizeof(name), "Jogador %d", i);
+        players[i] = createPlayer(board, name);
+        players[i]->totalScore = (int)(nextRandom() % 100000);
+        insertSorted(board, players[i]);
+    }
+}
+
+static void benchSize(int playerCount) {
+    Leaderboard board = {0};
+    PlayerNode** players = (PlayerNode**)malloc(sizeof(PlayerNode*) * (size_t)playerCount);
+    if (players == NULL) {
+        printf("%10d  sem memória\n", playerCount);
+        return;
+    }
+
+    // Os nomes são únicos, então a carga vai direto para insertSorted sem procurar pelo nome
+    double start = nowSeconds();
+    loadPlayers(&board, players, playerCount);
+    double buildSeconds = nowSeconds() - start;
+
+    // Mesmos jogadores pela carga em lote, fora de ordem como viriam de uma importação
+    PlayerScore* scores = (PlayerScore*)malloc(sizeof(PlayerScore) * (size_t)playerCount);
+    for (int i = 0; i < playerCount; i++) {
+        scores[i].name = getPlayerName(&board, players[i]);
+        scores[i].totalScore = players[i]->totalScore;
+    }
+    Leaderboard bulkBoard = {0};
+    start = nowSeconds();
+    bulkLoadLeaderboard(&bulkBoard, scores, playerCount);
+    double bulkSeconds = nowSeconds() - start;
+    freeLeaderboard(&bulkBoard);
+    free(scores);
+
+    // Nomes sorteados antes, para não medir o snprintf
+    char (*names)[50] = (char (*)[50])malloc(sizeof(*names) * OPERATIONS);
+    for (int i = 0; i < OPERATIONS; i++) {
+        snprintf(names[i], sizeof(names[i]), "Jogador %u", nextRandom() % (unsigned int)playerCount);
+    }
+
+    long checksum = 0;
+    start = nowSeconds();
+    for (int i = 0; i < OPERATIONS; i++) {
+        checksum += findByName(&board, names[i])->totalScore;
+    }
+    double findSeconds = nowSeconds() - start;
+
+    start = nowSeconds();
+    for (int i = 0; i < OPERATIONS; i++) {
+        updateScore(&board, names[i], (int)(nextRandom() % 100));
+    }
+    double updateSeconds = nowSeconds() - start;
+    free(names);
+
+    start = nowSeconds();
+    for (int i = 0; i < OPERATIONS; i++) {
+        checksum += getPlayerRank(&board, players[nextRandom() % (unsigned int)playerCount]);
+    }
+    double rankSeconds = nowSeconds() - start;
+
+    start = nowSeconds();
+    for (int i = 0; i < OPERATIONS; i++) {
+        checksum += getPlayerAtRank(&board, 1 + (int)(nextRandom() % (unsigned int)playerCount))->totalScore;
+    }
+    double kthSeconds = nowSeconds() - start;
+
+    // O que a tela do placar pede quando a versão muda
+    LeaderboardEntry top[10];
+    start = nowSeconds();
+    for (int i = 0; i < OPERATIONS; i++) {
+        checksum += getTopK(&board, 10, top);
+    }
+    double topSeconds = nowSeconds() - start;
+
+    LeaderboardEntry around[5];
+    start = nowSeconds();
+    for (int i = 0; i < OPERATIONS; i++) {
+        checksum += getNeighborhood(&board, getPlayerName(&board, players[nextRandom() % (unsigned int)playerCount]), 2, around);
+    }
+    double neighborSeconds = nowSeconds() - start;
+
+    // Só as pontuações, na ordem do placar: mede o quanto de cada nó a árvore arrasta pelo cache
+    int scans = playerCount < OPERATIONS ? OPERATIONS / playerCount : 1;
+    start = nowSeconds();
+    for (int i = 0; i < scans; i++) {
+        forEachPlayer(&board, addScore, &checksum);
+    }
+    double scanSeconds = nowSeconds() - start;
+
+    double oldScanSeconds = 0.0;
+    OldPlayerNode* oldNodes = copyToOldLayout(&board, players, playerCount);
+    if (oldNodes != NULL) {
+        start = nowSeconds();
+        for (int i = 0; i < scans; i++) {
+            visitOldInOrder(oldNodes, board.root, addOldScore, &checksum);
+        }
+        oldScanSeconds = nowSeconds() - start;
+        free(oldNodes);
+    }
+
+    printf("%10d %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f   (%ld)\n", playerCount,
+           buildSeconds * 1e9 / playerCount,
+           bulkSeconds * 1e9 / playerCount,
+           findSeconds * 1e9 / OPERATIONS,
+           updateSeconds * 1e9 / OPERATIONS,
+           rankSeconds * 1e9 / OPERATIONS,
+           kthSeconds * 1e9 / OPERATIONS,
+           topSeconds * 1e9 / OPERATIONS,
+           neighborSeconds * 1e9 / OPERATIONS,
+           scanSeconds * 1e9 / ((double)scans * playerCount),
+           oldScanSeconds * 1e9 / ((double)scans * playerCount),
+           checksum % 1000);
+
+    freeLeaderboard(&board);
+    free(players);
+}
+
+// Só a varredura, num layout: o que sobra no perf stat além da carga é ela
+static int benchScanOnly(int playerCount, int oldLayout) {
+    Leaderboard board = {0};
+    PlayerNode** players = (PlayerNode**)malloc(sizeof(PlayerNode*) * (size_t)playerCount);
+    if (players == NULL) {
+        fprintf(stderr, "sem memória\n");
+        return 1;
+    }
+    loadPlayers(&board, players, playerCount);
+    OldPlayerNode* oldNodes = NULL;
+    if (oldLayout) {
+        oldNodes = copyToOldLayout(&board, players, playerCount);
+        if (oldNodes == NULL) {
+            fprintf(stderr, "sem memória\n");
+            freeLeaderboard(&board);
+            free(players);
+            return 1;
+        }
+    }
+
+    long checksum = 0;
+    double start = nowSeconds();
+    for (int i = 0; i < SCAN_REPEATS; i++) {
+        if (oldLayout) {
+            visitOldInOrder(oldNodes, board.root, addOldScore, &checksum);
+        } else {
+            forEachPlayer(&board, addScore, &checksum);
+        }
+    }
+    double scanSeconds = nowSeconds() - start;
+    printf("%s: %d jogadores, %zu bytes por nó, varredura %.1f ns por jogador   (%ld)\n",
+           oldLayout ? "antigo" : "novo", playerCount, oldLayout ? sizeof(OldPlayerNode) : sizeof(PlayerNode),
+           scanSeconds * 1e9 / ((double)SCAN_REPEATS * playerCount), checksum % 1000);
+
+    free(oldNodes);
+    freeLeaderboard(&board);
+    free(players);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int maxPlayers = argc > 1 ? atoi(argv[1]) : 10000000;
+
+    if (argc > 2) {
+        if (strcmp(argv[2], "novo") != 0 && strcmp(argv[2], "antigo") != 0) {
+            fprintf(stderr, "uso: %s [maximo_de_jogadores] [novo|antigo]\n", argv[0]);
+            return 1;
+        }
+        return benchScanOnly(maxPlayers > 0 ? maxPlayers : 1, strcmp(argv[2], "antigo") == 0);
+    }
+
+    printf("%10s %12s %12s %12s %12s %12s %12s %12s %12s %12s %12s\n", "jogadores", "carga ns", "lote ns", "busca ns", "update ns", "posicao ns", "k-esimo ns", "top 10 ns", "vizinhos ns", "varredura ns", "antigo ns");
+    for (int playerCount = 10; playerCount <= maxPlayers && playerCount > 0; playerCount *= 10) {
+        benchSize(playerCount);
+    }
+    return 0;
+}
@@ -0,0 +1,214 @@
+// Teste de estresse e benchmark do placar concorrente: escritores atualizando
+// pontuações enquanto leitores conferem cada snapshot publicado.
+// Uso: leaderboard_concurrent_bench [segundos_por_configuracao]  (padrão 0.5)
+
+#include "leaderboard_concurrent.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define INITIAL_PLAYERS 100000
+#define MAX_THREADS 16
+
+typedef struct {
+    ConcurrentLeaderboard* shared;
+    unsigned int seed;
+    long operations;
+} Worker;
+
+static atomic_int stopFlag;
+
+static double nowSeconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+}
+
+static unsigned int nextRandom(unsigned int* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void fail(const char* reason) {
+    fprintf(stderr, "Snapshot inconsistente: %s\n", reason);
+    abort();
+}
+
+static void runWriter(Worker* worker) {
+    while (!atomic_load(&stopFlag)) {
+        char name[50];
+        snprintf(name, sizeof(name), "Jogador %u", nextRandom(&worker->seed) % INITIAL_PLAYERS);
+        concurrentUpdateScore(worker->shared, name, (int)(nextRandom(&worker->seed) % 100));
+        worker->operations++;
+    }
+}
+
+// Cada snapshot precisa estar ordenado e a versão nunca pode voltar
+static void runReader(Worker* worker) {
+    int reader = registerLeaderboardReader(worker->shared);
+    if (reader < 0) {
+        fail("sem vaga para leitor");
+    }
+
+    uint32_t lastVersion = 0;
+    while (!atomic_load(&stopFlag)) {
+        const LeaderboardSnapshot* snapshot = beginLeaderboardRead(worker->shared, reader);
+        if (snapshot == NULL) {
+            fail("snapshot nulo");
+        }
+        const SnapshotView* view = &snapshot->views[SNAPSHOT_ALL_TIME];
+        if ((int32_t)(view->version - lastVersion) < 0) {
+            fail("versão voltou");
+        }
+        if (view->count > CONCURRENT_TOP_ENTRIES || view->count > snapshot->playerCount) {
+            fail("contagem");
+        }
+        for (int i = 0; i < view->count; i++) {
+            if (view->top[i].rank != i + 1 ||
+                (i > 0 && view->top[i].totalScore > view->top[i - 1].totalScore)) {
+                fail("ordem do topo");
+            }
+        }
+        for (int i = 1; i < view->neighborCount; i++) {
+            if (view->neighbors[i].rank != view->neighbors[i - 1].rank + 1 ||
+                view->neighbors[i].totalScore > view->neighbors[i - 1].totalScore) {
+                fail("ordem da vizinhança");
+            }
+        }
+        lastVersion = view->version;
+        endLeaderboardRead(worker->shared, reader);
+        worker->operations++;
+    }
+
+    unregisterLeaderboardReader(worker->shared, reader);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI writerThread(LPVOID argument) {
+    runWriter((Worker*)argument);
+    return 0;
+}
+
+static DWORD WINAPI readerThread(LPVOID argument) {
+    runReader((Worker*)argument);
+    return 0;
+}
+#else
+static void* writerThread(void* argument) {
+    runWriter((Worker*)argument);
+    return NULL;
+}
+
+static void* readerThread(void* argument) {
+    runReader((Worker*)argument);
+    return NULL;
+}
+#endif
+
+static void runConfiguration(ConcurrentLeaderboard* shared, int writers, int readers, double seconds) {
+    Worker workers[MAX_THREADS];
+#ifdef _WIN32
+    HANDLE threads[MAX_THREADS];
+#else
+    pthread_t threads[MAX_THREADS];
+#endif
+    int total = writers + readers;
+
+    atomic_store(&stopFlag, 0);
+    for (int i = 0; i < total; i++) {
+        workers[i].shared = shared;
+        workers[i].seed = 2463534242u + (unsigned int)i * 7919u;
+        workers[i].operations = 0;
+#ifdef _WIN32
+        threads[i] = CreateThread(NULL, 0, i < writers ? writerThread : readerThread, &workers[i], 0, NULL);
+#else
+        pthread_create(&threads[i], NULL, i < writers ? writerThread : readerThread, &workers[i]);
+#endif
+    }
+
+    double start = nowSeconds();
+    while (nowSeconds() - start < seconds) {
+#ifdef _WIN32
+        Sleep(10);
+#else
+        struct timespec pause = { 0, 10000000 };
+        nanosleep(&pause, NULL);
+#endif
+    }
+    atomic_store(&stopFlag, 1);
+
+    long writes = 0;
+    long reads = 0;
+    for (int i = 0; i < total; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+        if (i < writers) {
+            writes += workers[i].operations;
+        } else {
+            reads += workers[i].operations;
+        }
+    }
+    double elapsed = nowSeconds() - start;
+
+    printf("%2d escritor(es) %2d leitor(es) %12.0f escritas/s %14.0f leituras/s\n",
+           writers, readers, writes / elapsed, reads / elapsed);
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : 0.5;
+
+    Leaderboard board = {0};
+    PlayerScore* players = (PlayerScore*)malloc(sizeof(PlayerScore) * INITIAL_PLAYERS);
+    char (*names)[50] = (char (*)[50])malloc(sizeof(*names) * INITIAL_PLAYERS);
+    for (int i = 0; i < INITIAL_PLAYERS; i++) {
+        snprintf(names[i], sizeof(names[i]), "Jogador %d", i);
+        players[i].name = names[i];
+        players[i].totalScore = (i * 7919) % 100000;
+    }
+    bulkLoadLeaderboard(&board, players, INITIAL_PLAYERS);
+    free(players);
+    free(names);
+
+    // As janelas entram para o custo da escrita ser o mesmo do jogo
+    LeaderboardWindows windows;
+    ConcurrentLeaderboard shared;
+    if (!initLeaderboardWindows(&windows, (int64_t)time(NULL)) ||
+        !initConcurrentLeaderboard(&shared, &board, NULL, &windows)) {
+        fprintf(stderr, "Erro ao criar o placar concorrente\n");
+        return 1;
+    }
+    concurrentSetLocalPlayer(&shared, "Jogador 0");
+
+    int writerCounts[] = { 1, 2, 4 };
+    int readerCounts[] = { 1, 4, 8 };
+    for (int w = 0; w < 3; w++) {
+        for (int r = 0; r < 3; r++) {
+            runConfiguration(&shared, writerCounts[w], readerCounts[r], seconds);
+        }
+    }
+
+    destroyConcurrentLeaderboard(&shared);
+    freeLeaderboardWindows(&windows);
+    freeLeaderboard(&board);
+    return 0;
+}
@@ -0,0 +1,170 @@
+// Benchmark do placar dividido em shards: vazão de atualizações com várias
+// threads e custo do top-K global (merge dos shards) com 1, 2, 4 e 8 shards.
+// Uso: leaderboard_sharded_bench [threads] [segundos]  (padrão 8 e 0.5)
+
+#include "leaderboard_sharded.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#define PLAYERS 1000000
+#define MAX_THREADS 64
+#define TOP_QUERIES 100000
+
+typedef struct {
+    ShardedLeaderboard* sharded;
+    unsigned int seed;
+    long operations;
+} Worker;
+
+static atomic_int stopFlag;
+
+static double nowSeconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+}
+
+static unsigned int nextRandom(unsigned int* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void runWriter(Worker* worker) {
+    while (!atomic_load(&stopFlag)) {
+        char name[50];
+        snprintf(name, sizeof(name), "Jogador %u", nextRandom(&worker->seed) % PLAYERS);
+        shardedUpdateScore(worker->sharded, name, (int)(nextRandom(&worker->seed) % 100));
+        worker->operations++;
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI writerThread(LPVOID argument) {
+    runWriter((Worker*)argument);
+    return 0;
+}
+#else
+static void* writerThread(void* argument) {
+    runWriter((Worker*)argument);
+    return NULL;
+}
+#endif
+
+static double measureUpdates(ShardedLeaderboard* sharded, int threadCount, double seconds) {
+    Worker workers[MAX_THREADS];
+#ifdef _WIN32
+    HANDLE threads[MAX_THREADS];
+#else
+    pthread_t threads[MAX_THREADS];
+#endif
+
+    atomic_store(&stopFlag, 0);
+    for (int i = 0; i < threadCount; i++) {
+        workers[i].sharded = sharded;
+        workers[i].seed = 2463534242u + (unsigned int)i * 7919u;
+        workers[i].operations = 0;
+#ifdef _WIN32
+        threads[i] = CreateThread(NULL, 0, writerThread, &workers[i], 0, NULL);
+#else
+        pthread_create(&threads[i], NULL, writerThread, &workers[i]);
+#endif
+    }
+
+    double start = nowSeconds();
+    while (nowSeconds() - start < seconds) {
+#ifdef _WIN32
+        Sleep(10);
+#else
+        struct timespec pause = { 0, 10000000 };
+        nanosleep(&pause, NULL);
+#endif
+    }
+    atomic_store(&stopFlag, 1);
+
+    long total = 0;
+    for (int i = 0; i < threadCount; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+        total += workers[i].operations;
+    }
+    return total / (nowSeconds() - start);
+}
+
+static double measureTopK(ShardedLeaderboard* sharded, int k, LeaderboardEntry* out, long* checksum) {
+    double start = nowSeconds();
+    for (int i = 0; i < TOP_QUERIES; i++) {
+        *checksum += shardedGetTopK(sharded, k, out);
+    }
+    return (nowSeconds() - start) * 1e9 / TOP_QUERIES;
+}
+
+int main(int argc, char** argv) {
+    int threadCount = argc > 1 ? atoi(argv[1]) : 8;
+    double seconds = argc > 2 ? atof(argv[2]) : 0.5;
+    if (threadCount < 1 || threadCount > MAX_THREADS) {
+        threadCount = 8;
+    }
+
+    PlayerScore* players = (PlayerScore*)malloc(sizeof(PlayerScore) * PLAYERS);
+    char (*names)[50] = (char (*)[50])malloc(sizeof(*names) * PLAYERS);
+    LeaderboardEntry* top = (LeaderboardEntry*)malloc(sizeof(LeaderboardEntry) * 100);
+    if (players == NULL || names == NULL || top == NULL) {
+        fprintf(stderr, "Sem memória\n");
+        return 1;
+    }
+    for (int i = 0; i < PLAYERS; i++) {
+        snprintf(names[i], sizeof(names[i]), "Jogador %d", i);
+        players[i].name = names[i];
+        players[i].totalScore = (int)(((unsigned int)i * 7919u) % 100000u);
+    }
+
+    printf("%d jogadores, %d thread(s) atualizando\n", PLAYERS, threadCount);
+    printf("%8s %16s %12s %12s %12s\n", "shards", "atualizacoes/s", "carga ms", "top 10 ns", "top 100 ns");
+    long checksum = 0;
+    int shardCounts[] = { 1, 2, 4, 8 };
+    for (int i = 0; i < 4; i++) {
+        ShardedLeaderboard sharded;
+        if (!initShardedLeaderboard(&sharded, shardCounts[i])) {
+            fprintf(stderr, "Sem memória\n");
+            return 1;
+        }
+
+        double start = nowSeconds();
+        bulkLoadShardedLeaderboard(&sharded, players, PLAYERS);
+        double loadMs = (nowSeconds() - start) * 1e3;
+
+        double updates = measureUpdates(&sharded, threadCount, seconds);
+        double top10 = measureTopK(&sharded, 10, top, &checksum);
+        double top100 = measureTopK(&sharded, 100, top, &checksum);
+
+        printf("%8d %16.0f %12.1f %12.1f %12.1f   (%ld)\n", shardCounts[i], updates, loadMs, top10, top100, checksum % 1000);
+        freeShardedLeaderboard(&sharded);
+    }
+
+    free(players);
+    free(names);
+    free(top);
+    return 0;
+}
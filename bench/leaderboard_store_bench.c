@@ -0,0 +1,172 @@
+// Benchmark da persistência do placar: custo por atualização em cada modo de
+// fsync, tempo de abertura (snapshot mapeado + eventos do WAL reaplicados),
+// tamanho do log por evento e a pausa da compactação na hora e em segundo plano.
+// Uso: leaderboard_store_bench [pasta]  (padrão: pasta atual)
+
+#include "leaderboard_store.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+static double nowSeconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+}
+
+#define COMPACT_EVERY 4096
+
+static char basePath[300];
+
+static void removeFiles(void) {
+    char path[320];
+    snprintf(path, sizeof(path), "%s.dat", basePath);
+    remove(path);
+    snprintf(path, sizeof(path), "%s.wal", basePath);
+    remove(path);
+    snprintf(path, sizeof(path), "%s.wal.1", basePath);
+    remove(path);
+}
+
+static long walBytes(void) {
+    char path[320];
+    snprintf(path, sizeof(path), "%s.wal", basePath);
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+static void benchSyncMode(const char* label, StoreSyncMode mode, int updates) {
+    Leaderboard board = {0};
+    LeaderboardStore store;
+    removeFiles();
+    openLeaderboardStore(&store, &board, basePath, mode);
+    store.compactEvery = 0; // só o custo do WAL
+
+    double start = nowSeconds();
+    for (int i = 0; i < updates; i++) {
+        char name[50];
+        snprintf(name, sizeof(name), "Jogador %d", i % 1000);
+        storeUpdateScore(&store, name, i % 50);
+    }
+    double seconds = nowSeconds() - start;
+
+    printf("fsync %-8s %8d atualizações %10.2f us/atualização\n", label, updates, seconds * 1e6 / updates);
+    closeLeaderboardStore(&store);
+    freeLeaderboard(&board);
+}
+
+static void benchStartup(int players, int walRecords) {
+    Leaderboard board = {0};
+    LeaderboardStore store;
+    removeFiles();
+
+    // Monta o snapshot com 'players' jogadores e deixa 'walRecords' registros no WAL
+    openLeaderboardStore(&store, &board, basePath, STORE_SYNC_OFF);
+    store.compactEvery = 0;
+    for (int i = 0; i < players; i++) {
+        char name[50];
+        snprintf(name, sizeof(name), "Jogador %d", i);
+        storeUpdateScore(&store, name, (int)((i * 7919u) % 100000u));
+    }
+    compactLeaderboardStore(&store);
+    for (int i = 0; i < walRecords; i++) {
+        char name[50];
+        snprintf(name, sizeof(name), "Jogador %d", i % (players > 0 ? players : 1));
+        storeUpdateScore(&store, name, 1);
+    }
+    fclose(store.wal); // simula o jogo fechando sem compactar
+    freeLeaderboard(&board);
+
+    double start = nowSeconds();
+    openLeaderboardStore(&store, &board, basePath, STORE_SYNC_OFF);
+    double seconds = nowSeconds() - start;
+
+    printf("abertura %8d jogadores + %7d eventos (%8.1f KB de WAL) %10.2f ms\n",
+           getPlayerCount(&board), walRecords, walBytes() / 1024.0, seconds * 1e3);
+    fclose(store.wal);
+    freeLeaderboard(&board);
+}
+
+// Atualizações seguidas num placar grande, compactando a cada 'compactEvery' eventos:
+// a pior atualização é a que dispara a compactação
+static void benchCompaction(const char* label, int background, int players, int updates) {
+    Leaderboard board = {0};
+    LeaderboardStore store;
+    removeFiles();
+    openLeaderboardStore(&store, &board, basePath, STORE_SYNC_BATCHED);
+    store.compactEvery = 0;
+    for (int i = 0; i < players; i++) {
+        char name[50];
+        snprintf(name, sizeof(name), "Jogador %d", i);
+        storeUpdateScore(&store, name, (int)((i * 7919u) % 100000u));
+    }
+    compactLeaderboardStore(&store);
+
+    store.compactEvery = COMPACT_EVERY;
+    store.backgroundCompaction = background;
+    double worst = 0;
+    long largestWal = 0;
+    double start = nowSeconds();
+    for (int i = 0; i < updates; i++) {
+        char name[50];
+        snprintf(name, sizeof(name), "Jogador %d", (i * 31) % players);
+        double before = nowSeconds();
+        storeUpdateScore(&store, name, 1);
+        double elapsed = nowSeconds() - before;
+        if (elapsed > worst) {
+            worst = elapsed;
+        }
+        if (i % 256 == 0) {
+            long bytes = walBytes();
+            if (bytes > largestWal) {
+                largestWal = bytes;
+            }
+        }
+    }
+    double seconds = nowSeconds() - start;
+
+    printf("compactação %-8s %8d jogadores %10.2f us/atualização, pior %8.2f ms, WAL até %7.1f KB\n",
+           label, players, seconds * 1e6 / updates, worst * 1e3, largestWal / 1024.0);
+    closeLeaderboardStore(&store);
+    freeLeaderboard(&board);
+}
+
+int main(int argc, char** argv) {
+    snprintf(basePath, sizeof(basePath), "%s/placar_bench", argc > 1 ? argv[1] : ".");
+
+    benchSyncMode("sempre", STORE_SYNC_ALWAYS, 2000);
+    benchSyncMode("lote", STORE_SYNC_BATCHED, 100000);
+    benchSyncMode("desligado", STORE_SYNC_OFF, 100000);
+
+    int sizes[] = { 1000, 100000, 1000000 };
+    for (int i = 0; i < 3; i++) {
+        benchStartup(sizes[i], 0);
+        benchStartup(sizes[i], 10000);
+        benchStartup(sizes[i], 100000);
+    }
+
+    benchCompaction("na hora", 0, 1000000, 50000);
+    benchCompaction("em fundo", 1, 1000000, 50000);
+
+    removeFiles();
+    return 0;
+}
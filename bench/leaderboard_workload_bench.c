@@ -0,0 +1,335 @@
+// Benchmark do placar com misturas de operações parecidas com o uso real:
+// carga jogador a jogador (createPlayer + insertSorted), carga em lote, misturas
+// de top 10 / busca por nome com posição / updateScore / jogador novo, com os
+// jogadores sorteados de forma uniforme ou Zipf (poucos jogadores concentram a
+// maior parte das partidas), e freeLeaderboard no fim.
+// Para cada fase: operações por segundo, latência por operação (p50, p99, p99.9,
+// máximo), alocações feitas pelo placar e bytes do placar por jogador.
+//
+// Uso: leaderboard_workload_bench [maximo_de_jogadores] [mistura...]
+//   maximo_de_jogadores: padrão 1000000 (roda 1000, 10000, ... até ele)
+//   mistura: leitura, escrita, zipf, novos, ou "top/busca/update/novo" em
+//            porcentagens, com 'z' no fim para sortear por Zipf (ex: 10/20/70/0z)
+//   sem misturas, roda as quatro pré-definidas.
+//
+// Cada operação é cronometrada sozinha, então as latências incluem o custo de
+// ler o relógio (mostrado no início); as operações por segundo também.
+// As misturas rodam uma depois da outra no mesmo placar.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// Contagem de alocações do placar: o leaderboard.c entra neste arquivo com
+// malloc/calloc/realloc trocados pelas versões que contam (sem mudar a biblioteca)
+static size_t allocationCount = 0;
+
+static void* countingMalloc(size_t size) {
+    allocationCount++;
+    return malloc(size);
+}
+
+static void* countingCalloc(size_t count, size_t size) {
+    allocationCount++;
+    return calloc(count, size);
+}
+
+static void* countingRealloc(void* pointer, size_t size) {
+    allocationCount++;
+    return realloc(pointer, size);
+}
+
+#define malloc(size) countingMalloc(size)
+#define calloc(count, size) countingCalloc(count, size)
+#define realloc(pointer, size) countingRealloc(pointer, size)
+#include "leaderboard.c"
+#undef malloc
+#undef calloc
+#undef realloc
+
+#define OPERATIONS 200000
+#define MAX_MIXES 16
+#define ZIPF_EXPONENT 1.0
+
+typedef struct {
+    char name[16];
+    int top;    // porcentagem de getTopK(10)
+    int lookup; // findByName + getPlayerRank
+    int update; // updateScore de quem já está no placar
+    int insert; // jogador novo (createPlayer + insertSorted)
+    int zipf;   // 1 = jogadores sorteados por Zipf, 0 = uniforme
+} Workload;
+
+static const Workload presets[] = {
+    { "leitura", 90, 8, 2, 0, 0 },  // tela do placar aberta, poucas partidas
+    { "escrita", 5, 5, 90, 0, 0 },  // fim de rodada de muitos jogadores
+    { "zipf", 10, 20, 70, 0, 1 },   // os mesmos poucos jogadores jogando sem parar
+    { "novos", 10, 10, 40, 40, 0 }, // placar crescendo
+};
+
+static double nowSeconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+}
+
+static unsigned int randomState = 12345u;
+static long checksum = 0; // impede o compilador de descartar as leituras
+
+static unsigned int nextRandom(void) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+// Bytes que o placar segura: blocos de nós, tabela de nomes, blocos de texto e os vetores de ponteiros
+static size_t boardBytes(const Leaderboard* board) {
+    return (size_t)board->chunkCount * sizeof(PlayerNode) * CHUNK_NODES +
+           (size_t)board->chunkCapacity * sizeof(PlayerNode*) +
+           (size_t)board->nameCapacity * sizeof(NameSlot) +
+           (size_t)board->nameBlockCount * NAME_BLOCK_BYTES +
+           (size_t)board->nameBlockCapacity * sizeof(char*);
+}
+
+static int compareFloats(const void* a, const void* b) {
+    float x = *(const float*)a;
+    float y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+static float percentile(const float* sorted, int count, double fraction) {
+    int index = (int)(fraction * (count - 1) + 0.5);
+    return sorted[index];
+}
+
+// latencies == NULL para as fases de uma operação só (lote e liberação)
+static void report(int playerCount, const char* phase, int operations, double seconds,
+                   float* latencies, size_t allocations, const Leaderboard* board) {
+    char percentiles[64] = "       -        -        -        -";
+    if (latencies != NULL && operations > 0) {
+        qsort(latencies, (size_t)operations, sizeof(float), compareFloats);
+        snprintf(percentiles, sizeof(percentiles), "%8.0f %8.0f %8.0f %8.0f",
+                 percentile(latencies, operations, 0.50),
+                 percentile(latencies, operations, 0.99),
+                 percentile(latencies, operations, 0.999),
+                 latencies[operations - 1]);
+    }
+
+    int players = getPlayerCount(board);
+    printf("%10d %-16s %12.0f %s %10zu %12.1f\n", playerCount, phase,
+           operations / seconds, percentiles, allocations,
+           players > 0 ? (double)boardBytes(board) / players : 0.0);
+}
+
+static void playerName(char* name, size_t size, unsigned int id) {
+    snprintf(name, size, "Jogador %u", id);
+}
+
+// Distribuição acumulada de Zipf sobre as posições de popularidade 0..count-1
+static double* buildZipf(int count) {
+    double* cumulative = (double*)malloc(sizeof(double) * (size_t)count);
+    if (cumulative == NULL) {
+        return NULL;
+    }
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += 1.0 / pow(i + 1, ZIPF_EXPONENT);
+        cumulative[i] = sum;
+    }
+    for (int i = 0; i < count; i++) {
+        cumulative[i] /= sum;
+    }
+    return cumulative;
+}
+
+static unsigned int pickPlayer(const double* zipf, int playerCount) {
+    if (zipf == NULL) {
+        return nextRandom() % (unsigned int)playerCount;
+    }
+
+    double target = (double)nextRandom() / 4294967296.0;
+    int low = 0;
+    int high = playerCount - 1;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (zipf[middle] < target) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    // Espalha os populares pelos ids (7919 é primo com 10^k), senão seriam os primeiros do slab
+    return (unsigned int)(((unsigned long long)low * 7919u) % (unsigned int)playerCount);
+}
+
+static void runMix(Leaderboard* board, int playerCount, const Workload* mix, const double* zipf,
+                   float* latencies, unsigned int* nextNewPlayer) {
+    LeaderboardEntry top[10];
+    size_t allocationsBefore = allocationCount;
+    double total = 0.0;
+
+    for (int i = 0; i < OPERATIONS; i++) {
+        // Sorteio e nome montados fora do tempo medido
+        int choice = (int)(nextRandom() % 100);
+        char name[50];
+        int points = (int)(nextRandom() % 100);
+        if (choice >= mix->top + mix->lookup + mix->update) {
+            snprintf(name, sizeof(name), "Novo %u", (*nextNewPlayer)++);
+        } else {
+            playerName(name, sizeof(name), pickPlayer(zipf, playerCount));
+        }
+
+        double start = nowSeconds();
+        if (choice < mix->top) {
+            checksum += getTopK(board, 10, top);
+        } else if (choice < mix->top + mix->lookup) {
+            checksum += getPlayerRank(board, findByName(board, name));
+        } else if (choice < mix->top + mix->lookup + mix->update) {
+            updateScore(board, name, points);
+        } else {
+            PlayerNode* player = createPlayer(board, name);
+            if (player != NULL) {
+                player->totalScore = points;
+                insertSorted(board, player);
+            }
+        }
+        double elapsed = nowSeconds() - start;
+        latencies[i] = (float)(elapsed * 1e9);
+        total += elapsed;
+    }
+
+    report(playerCount, mix->name, OPERATIONS, total, latencies, allocationCount - allocationsBefore, board);
+}
+
+static void benchSize(int playerCount, const Workload* mixes, int mixCount) {
+    int samples = playerCount > OPERATIONS ? playerCount : OPERATIONS;
+    float* latencies = (float*)malloc(sizeof(float) * (size_t)samples);
+    PlayerScore* scores = (PlayerScore*)malloc(sizeof(PlayerScore) * (size_t)playerCount);
+    char (*names)[50] = (char (*)[50])malloc(sizeof(*names) * (size_t)playerCount);
+    if (latencies == NULL || scores == NULL || names == NULL) {
+        printf("%10d  sem memória\n", playerCount);
+        free(latencies);
+        free(scores);
+        free(names);
+        return;
+    }
+    for (int i = 0; i < playerCount; i++) {
+        playerName(names[i], sizeof(names[i]), (unsigned int)i);
+        scores[i].name = names[i];
+        scores[i].totalScore = (int)(nextRandom() % 100000);
+    }
+
+    // Carga em lote num placar à parte, só para comparar com a de um em um
+    Leaderboard bulkBoard = {0};
+    size_t allocationsBefore = allocationCount;
+    double start = nowSeconds();
+    bulkLoadLeaderboard(&bulkBoard, scores, playerCount);
+    double bulkSeconds = nowSeconds() - start;
+    report(playerCount, "lote", playerCount, bulkSeconds, NULL, allocationCount - allocationsBefore, &bulkBoard);
+    freeLeaderboard(&bulkBoard);
+
+    Leaderboard board = {0};
+    allocationsBefore = allocationCount;
+    double total = 0.0;
+    for (int i = 0; i < playerCount; i++) {
+        start = nowSeconds();
+        PlayerNode* player = createPlayer(&board, names[i]);
+        player->totalScore = scores[i].totalScore;
+        insertSorted(&board, player);
+        double elapsed = nowSeconds() - start;
+        latencies[i] = (float)(elapsed * 1e9);
+        total += elapsed;
+    }
+    report(playerCount, "carga", playerCount, total, latencies, allocationCount - allocationsBefore, &board);
+    free(scores);
+    free(names);
+
+    double* zipf = NULL;
+    unsigned int nextNewPlayer = 0;
+    for (int m = 0; m < mixCount; m++) {
+        if (mixes[m].zipf && zipf == NULL) {
+            zipf = buildZipf(playerCount);
+        }
+        runMix(&board, playerCount, &mixes[m], mixes[m].zipf ? zipf : NULL, latencies, &nextNewPlayer);
+    }
+    free(zipf);
+
+    int finalCount = getPlayerCount(&board);
+    Leaderboard empty = {0};
+    start = nowSeconds();
+    freeLeaderboard(&board);
+    double freeSeconds = nowSeconds() - start;
+    report(playerCount, "liberar", finalCount, freeSeconds, NULL, 0, &empty);
+    free(latencies);
+}
+
+// "top/busca/update/novo" com 'z' opcional no fim; 0 se o texto não for uma mistura válida
+static int parseWorkload(const char* text, Workload* mix) {
+    for (size_t i = 0; i < sizeof(presets) / sizeof(presets[0]); i++) {
+        if (strcmp(text, presets[i].name) == 0) {
+            *mix = presets[i];
+            return 1;
+        }
+    }
+
+    char zipf = '\0';
+    int matched = sscanf(text, "%d/%d/%d/%d%c", &mix->top, &mix->lookup, &mix->update, &mix->insert, &zipf);
+    if (matched < 4 || (matched == 5 && zipf != 'z') ||
+        mix->top < 0 || mix->lookup < 0 || mix->update < 0 || mix->insert < 0 ||
+        mix->top + mix->lookup + mix->update + mix->insert != 100) {
+        return 0;
+    }
+    mix->zipf = zipf == 'z';
+    snprintf(mix->name, sizeof(mix->name), "%s", text);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    int maxPlayers = 1000000;
+    Workload mixes[MAX_MIXES];
+    int mixCount = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (i == 1 && argv[i][0] >= '0' && argv[i][0] <= '9' && strchr(argv[i], '/') == NULL) {
+            maxPlayers = atoi(argv[i]);
+        } else if (mixCount == MAX_MIXES || !parseWorkload(argv[i], &mixes[mixCount])) {
+            fprintf(stderr, "Mistura inválida: %s (use leitura, escrita, zipf, novos ou top/busca/update/novo somando 100)\n", argv[i]);
+            return 1;
+        } else {
+            mixCount++;
+        }
+    }
+    if (mixCount == 0) {
+        mixCount = (int)(sizeof(presets) / sizeof(presets[0]));
+        memcpy(mixes, presets, sizeof(presets));
+    }
+
+    // Custo de uma leitura do relógio, que entra em cada latência medida
+    double start = nowSeconds();
+    for (int i = 0; i < OPERATIONS; i++) {
+        checksum += (long)nowSeconds();
+    }
+    printf("Relogio: %.1f ns por leitura\n\n", (nowSeconds() - start) * 1e9 / OPERATIONS);
+
+    printf("%10s %-16s %12s %8s %8s %8s %8s %10s %12s\n", "jogadores", "fase", "ops/s", "p50 ns", "p99 ns", "p999 ns", "max ns", "alocacoes", "bytes/jog");
+    for (int playerCount = 1000; playerCount <= maxPlayers && playerCount > 0; playerCount *= 10) {
+        benchSize(playerCount, mixes, mixCount);
+    }
+    printf("\n(%ld)\n", checksum % 1000);
+    return 0;
+}
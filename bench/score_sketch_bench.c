@@ -0,0 +1,140 @@
+// Benchmark do histograma de pontuações: custo de atualizar e consultar, memória
+// e erro da posição aproximada comparada com a exata da treap.
+// Uso: score_sketch_bench [jogadores]  (padrão 1000000)
+
+#include "leaderboard.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define OPERATIONS 1000000
+
+static double nowSeconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+}
+
+static unsigned int randomState = 2463534242u;
+
+static unsigned int nextRandom(void) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+// Primeira posição com pontuação <= score (as posições estão em ordem decrescente)
+static int firstRankAtOrBelow(const Leaderboard* board, int score) {
+    int low = 1;
+    int high = getPlayerCount(board) + 1;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (getPlayerAtRank(board, middle)->totalScore <= score) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+int main(int argc, char** argv) {
+    int playerCount = argc > 1 ? atoi(argv[1]) : 1000000;
+    if (playerCount < 1) {
+        playerCount = 1000000;
+    }
+
+    // Poucos jogadores com muitos pontos, muitos com poucos
+    PlayerScore* players = (PlayerScore*)malloc(sizeof(PlayerScore) * (size_t)playerCount);
+    char (*names)[50] = (char (*)[50])malloc(sizeof(*names) * (size_t)playerCount);
+    if (players == NULL || names == NULL) {
+        fprintf(stderr, "Sem memória\n");
+        return 1;
+    }
+    for (int i = 0; i < playerCount; i++) {
+        double u = (nextRandom() % 1000000 + 1) / 1e6;
+        snprintf(names[i], sizeof(names[i]), "Jogador %d", i);
+        players[i].name = names[i];
+        double score = 100.0 / (u * u);
+        players[i].totalScore = score > 1e9 ? 1000000000 : (int)score;
+    }
+
+    Leaderboard board = {0};
+    static ScoreSketch sketch;
+    setScoreSketch(&board, &sketch);
+    bulkLoadLeaderboard(&board, players, playerCount);
+
+    long checksum = 0;
+    double start = nowSeconds();
+    for (int i = 0; i < OPERATIONS; i++) {
+        int score = players[nextRandom() % (unsigned int)playerCount].totalScore;
+        sketchRemoveScore(&sketch, score);
+        sketchAddScore(&sketch, score + 1);
+        sketchRemoveScore(&sketch, score + 1);
+        sketchAddScore(&sketch, score);
+    }
+    double updateNs = (nowSeconds() - start) * 1e9 / (OPERATIONS * 2.0);
+
+    start = nowSeconds();
+    for (int i = 0; i < OPERATIONS; i++) {
+        checksum += (long)sketchApproximateRank(&sketch, players[nextRandom() % (unsigned int)playerCount].totalScore);
+    }
+    double rankNs = (nowSeconds() - start) * 1e9 / OPERATIONS;
+
+    start = nowSeconds();
+    for (int i = 0; i < OPERATIONS; i++) {
+        checksum += sketchScoreAtPercentile(&sketch, (nextRandom() % 10001) / 100.0);
+    }
+    double percentileNs = (nowSeconds() - start) * 1e9 / OPERATIONS;
+
+    start = nowSeconds();
+    for (int i = 0; i < OPERATIONS; i++) {
+        checksum += getPlayerRank(&board, findByName(&board, players[nextRandom() % (unsigned int)playerCount].name));
+    }
+    double exactNs = (nowSeconds() - start) * 1e9 / OPERATIONS;
+
+    // Nos empates qualquer posição do grupo serve; o erro é a distância até ele
+    double maxError = 0.0;
+    double sumError = 0.0;
+    int samples = 0;
+    for (int rank = 1; rank <= playerCount; rank += 1 + playerCount / 10000) {
+        int score = getPlayerAtRank(&board, rank)->totalScore;
+        int first = firstRankAtOrBelow(&board, score);
+        int last = score == INT32_MIN ? playerCount : firstRankAtOrBelow(&board, score - 1) - 1;
+        int64_t approximate = sketchApproximateRank(&sketch, score);
+        double error = 0.0;
+        if (approximate < first) {
+            error = (double)(first - approximate) / playerCount;
+        } else if (approximate > last) {
+            error = (double)(approximate - last) / playerCount;
+        }
+        maxError = error > maxError ? error : maxError;
+        sumError += error;
+        samples++;
+    }
+
+    printf("%d jogadores, histograma de %zu bytes (%d baldes)\n", playerCount, sizeof(ScoreSketch), SKETCH_BUCKETS);
+    printf("atualizar %8.1f ns   posição aprox. %8.1f ns   percentil %8.1f ns   posição exata %8.1f ns\n",
+           updateNs, rankNs, percentileNs, exactNs);
+    printf("erro da posição (fração do placar): máximo %.4f%%  médio %.4f%%   (%ld)\n",
+           maxError * 100.0, sumError / samples * 100.0, checksum % 1000);
+
+    freeLeaderboard(&board);
+    free(players);
+    free(names);
+    return 0;
+}
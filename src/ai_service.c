@@ -33,6 +33,16 @@ static size_t writeMemoryCallback(void* contents, size_t size, size_t nmemb, voi
     return actualSize;
 }
 
+// Analisa a resposta à medida que chega, sem juntar o corpo inteiro em memória
+static size_t writeStreamCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    size_t actualSize = size * nmemb;
+    cJSON_Stream* stream = (cJSON_Stream*)userp;
+
+    // Um erro de sintaxe fica registrado no stream; o download continua até o fim
+    cJSON_StreamFeed(stream, (const char*)contents, actualSize);
+    return actualSize;
+}
+
 static char* duplicateString(const char* source) {
     if (!source) {
         return NULL;
@@ -53,11 +63,13 @@ static char* try_model_with_retry(const char* model_name, const char* prompt, in
             return NULL;
         }
 
-        MemoryStruct chunk = { .memory = (char*)malloc(1), .size = 0 };
-        if (!chunk.memory) {
+        cJSON_Stream* stream = cJSON_CreateStream();
+        if (!stream) {
             curl_easy_cleanup(curl);
             return NULL;
         }
+        int errorPath = cJSON_StreamAddPath(stream, "error/message");
+        int textPath = cJSON_StreamAddPath(stream, "candidates/0/content/parts/0/text");
 
         char api_url[200];
         sprintf(api_url, "https://generativelanguage.googleapis.com/v1beta/models/%s:generateContent?key=%s", model_name, API_KEY);
@@ -82,8 +94,8 @@ static char* try_model_with_retry(const char* model_name, const char* prompt, in
         curl_easy_setopt(curl, CURLOPT_URL, api_url);
         curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
         curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_string);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeMemoryCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void*)&chunk);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeStreamCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void*)stream);
         curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
         curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
 
@@ -98,47 +110,36 @@ static char* try_model_with_retry(const char* model_name, const char* prompt, in
                 res == CURLE_COULDNT_RESOLVE_HOST) {
                 shouldRetry = 1;
             }
+        } else if (!cJSON_StreamFinish(stream)) {
+            // Resposta cortada ou inválida: o que já chegou não vale como resposta
+            fprintf(stderr, "Erro ao analisar JSON: resposta inválida ou incompleta (byte %lu)\n", (unsigned long)cJSON_StreamGetErrorOffset(stream));
+            shouldRetry = 1;
         } else {
-            cJSON* json_response = cJSON_Parse(chunk.memory);
-            if (json_response == NULL) {
-                fprintf(stderr, "Erro ao analisar JSON: %s\n", cJSON_GetErrorPtr());
+            cJSON* errorMessage = cJSON_StreamDetachPathValue(stream, errorPath);
+            if (cJSON_IsString(errorMessage)) {
+                fprintf(stderr, "ERRO DA API: %s\n", errorMessage->valuestring);
+                if (strstr(errorMessage->valuestring, "overloaded") != NULL ||
+                    strstr(errorMessage->valuestring, "busy") != NULL) {
+                    shouldRetry = 1;
+                }
             } else {
-                cJSON* error = cJSON_GetObjectItem(json_response, "error");
-                if (error) {
-                    cJSON* errorMessage = cJSON_GetObjectItem(error, "message");
-                    if (cJSON_IsString(errorMessage)) {
-                        fprintf(stderr, "ERRO DA API: %s\n", errorMessage->valuestring);
-                        if (strstr(errorMessage->valuestring, "overloaded") != NULL ||
-                            strstr(errorMessage->valuestring, "busy") != NULL) {
-                            shouldRetry = 1;
-                        }
-                    }
+                cJSON* text = cJSON_StreamDetachPathValue(stream, textPath);
+                if (cJSON_IsString(text) && (text->valuestring != NULL)) {
+                    // Cópia com malloc: quem chama libera com free, não com os hooks do cJSON
+                    response_text = duplicateString(text->valuestring);
                 } else {
-                    cJSON* candidates = cJSON_GetObjectItem(json_response, "candidates");
-                    if (cJSON_IsArray(candidates)) {
-                        cJSON* candidate = cJSON_GetArrayItem(candidates, 0);
-                        if (candidate) {
-                            cJSON* content = cJSON_GetObjectItem(candidate, "content");
-                            cJSON* parts = cJSON_GetObjectItem(content, "parts");
-                            if (cJSON_IsArray(parts)) {
-                                cJSON* part = cJSON_GetArrayItem(parts, 0);
-                                cJSON* text = cJSON_GetObjectItem(part, "text");
-                                if (cJSON_IsString(text) && (text->valuestring != NULL)) {
-                                    response_text = duplicateString(text->valuestring);
-                                }
-                            }
-                        }
-                    }
+                    fprintf(stderr, "Erro ao analisar JSON: texto da resposta não encontrado\n");
                 }
-                cJSON_Delete(json_response);
+                cJSON_Delete(text);
             }
+            cJSON_Delete(errorMessage);
         }
 
         curl_easy_cleanup(curl);
         curl_slist_free_all(headers);
         free(json_string);
         cJSON_Delete(json_payload);
-        free(chunk.memory);
+        cJSON_DeleteStream(stream);
 
         if (response_text != NULL) {
             return response_text;
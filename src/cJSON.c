@@ -44,6 +44,7 @@
 #include <limits.h>
 #include <ctype.h>
 #include <float.h>
+#include <stdint.h>
 
 #ifdef ENABLE_LOCALES
 #include <locale.h>
@@ -85,11 +86,22 @@
 #endif
 #endif
 
+/* the error position of the global functions is kept per thread where the compiler supports it */
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define CJSON_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define CJSON_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define CJSON_THREAD_LOCAL __declspec(thread)
+#else
+#define CJSON_THREAD_LOCAL
+#endif
+
 typedef struct {
     const unsigned char *json;
     size_t position;
 } error;
-static error global_error = { NULL, 0 };
+static CJSON_THREAD_LOCAL error global_error = { NULL, 0 };
 
 CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void)
 {
@@ -185,6 +197,16 @@ static void * CJSON_CDECL internal_realloc(void *pointer, size_t size)
 
 static internal_hooks global_hooks = { internal_malloc, internal_free, internal_realloc };
 
+/* hooks and error state of one user of the context functions, e.g. a worker thread */
+struct cJSON_Context
+{
+    internal_hooks hooks;
+    error error;
+    struct intern_table *keys; /* NULL unless keys are interned */
+};
+
+static void free_intern_table(struct intern_table *table, const internal_hooks * const hooks);
+
 static unsigned char* cJSON_strdup(const unsigned char* string, const internal_hooks * const hooks)
 {
     size_t length = 0;
@@ -206,34 +228,66 @@ static unsigned char* cJSON_strdup(const unsigned char* string, const internal_h
     return copy;
 }
 
-CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
+static void set_hooks(internal_hooks * const target, const cJSON_Hooks * const hooks)
 {
     if (hooks == NULL)
     {
         /* Reset hooks */
-        global_hooks.allocate = malloc;
-        global_hooks.deallocate = free;
-        global_hooks.reallocate = realloc;
+        target->allocate = malloc;
+        target->deallocate = free;
+        target->reallocate = realloc;
         return;
     }
 
-    global_hooks.allocate = malloc;
+    target->allocate = malloc;
     if (hooks->malloc_fn != NULL)
     {
-        global_hooks.allocate = hooks->malloc_fn;
+        target->allocate = hooks->malloc_fn;
     }
 
-    global_hooks.deallocate = free;
+    target->deallocate = free;
     if (hooks->free_fn != NULL)
     {
-        global_hooks.deallocate = hooks->free_fn;
+        target->deallocate = hooks->free_fn;
     }
 
     /* use realloc only if both free and malloc are used */
-    global_hooks.reallocate = NULL;
-    if ((global_hooks.allocate == malloc) && (global_hooks.deallocate == free))
+    target->reallocate = NULL;
+    if ((target->allocate == malloc) && (target->deallocate == free))
+    {
+        target->reallocate = realloc;
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
+{
+    set_hooks(&global_hooks, hooks);
+}
+
+CJSON_PUBLIC(cJSON_Context *) cJSON_CreateContext(const cJSON_Hooks *hooks)
+{
+    internal_hooks context_hooks;
+    cJSON_Context *context = NULL;
+
+    set_hooks(&context_hooks, hooks);
+    context = (cJSON_Context*)context_hooks.allocate(sizeof(cJSON_Context));
+    if (context != NULL)
+    {
+        context->hooks = context_hooks;
+        context->error.json = NULL;
+        context->error.position = 0;
+        context->keys = NULL;
+    }
+
+    return context;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteContext(cJSON_Context *context)
+{
+    if (context != NULL)
     {
-        global_hooks.reallocate = realloc;
+        free_intern_table(context->keys, &context->hooks);
+        context->hooks.deallocate(context);
     }
 }
 
@@ -249,2934 +303,6535 @@ static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
     return node;
 }
 
-/* Delete a cJSON structure. */
-CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
+/* Lookup index for the children of large objects (hashed keys) and arrays (child pointers in order). */
+typedef struct
 {
-    cJSON *next = NULL;
-    while (item != NULL)
+    size_t hash;
+    size_t position; /* order among the children, lookups return the first match like the linear scan does */
+    cJSON *item;
+} index_slot;
+
+struct cJSON_Index
+{
+    size_t count; /* number of children in the table */
+    size_t next_position; /* position handed to the next appended child */
+    size_t mask; /* number of slots - 1, always a power of two */
+    index_slot *slots;
+
+    /* arrays: items[first] .. items[first + item_count - 1] are the children in order.
+     * Leaving room in front makes removing or inserting near the start as cheap as at the end. */
+    cJSON **items;
+    size_t first;
+    size_t item_count;
+    size_t item_capacity;
+
+    /* the children changed in a way the index couldn't follow; cJSON_BuildIndex refills it in place */
+    cJSON_bool stale;
+
+    /* the hooks it was built with, which also grow and free it */
+    internal_hooks hooks;
+};
+
+/* FNV-1a over the lowercased key, so that case sensitive and insensitive lookups can share the table */
+static size_t hash_key(const unsigned char *key)
+{
+    size_t hash = (size_t)2166136261u;
+
+    for (; *key != '\0'; key++)
     {
-        next = item->next;
-        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
-        {
-            cJSON_Delete(item->child);
-        }
-        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
+        hash ^= (size_t)tolower(*key);
+        hash *= (size_t)16777619u;
+    }
+
+    return hash;
+}
+
+static void free_index(struct cJSON_Index *index)
+{
+    if (index != NULL)
+    {
+        void (CJSON_CDECL *deallocate)(void *pointer) = index->hooks.deallocate;
+        if (index->slots != NULL)
         {
-            global_hooks.deallocate(item->valuestring);
-            item->valuestring = NULL;
+            deallocate(index->slots);
         }
-        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
+        if (index->items != NULL)
         {
-            global_hooks.deallocate(item->string);
-            item->string = NULL;
+            deallocate(index->items);
         }
-        global_hooks.deallocate(item);
-        item = next;
+        deallocate(index);
     }
 }
 
-/* get the decimal point character of the current locale */
-static unsigned char get_decimal_point(void)
+static void index_insert_slot(struct cJSON_Index * const index, size_t hash, size_t position, cJSON * const item)
 {
-#ifdef ENABLE_LOCALES
-    struct lconv *lconv = localeconv();
-    return (unsigned char) lconv->decimal_point[0];
-#else
-    return '.';
-#endif
-}
+    size_t slot = hash & index->mask;
 
-typedef struct
-{
-    const unsigned char *content;
-    size_t length;
-    size_t offset;
-    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
-    internal_hooks hooks;
-} parse_buffer;
+    while (index->slots[slot].item != NULL)
+    {
+        slot = (slot + 1) & index->mask;
+    }
 
-/* check if the given size is left to read in a given parse buffer (starting with 1) */
-#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
-/* check if the buffer can be accessed at the given index (starting with 0) */
-#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
-#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
-/* get a pointer to the buffer at the position */
-#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+    index->slots[slot].hash = hash;
+    index->slots[slot].position = position;
+    index->slots[slot].item = item;
+    index->count++;
+}
 
-/* Parse the input text to generate a number, and populate the result into item. */
-static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+/* resize the slot table so that it stays at most half full with "count" entries */
+static cJSON_bool index_reserve(struct cJSON_Index * const index, size_t count)
 {
-    double number = 0;
-    unsigned char *after_end = NULL;
-    unsigned char *number_c_string;
-    unsigned char decimal_point = get_decimal_point();
+    index_slot *old_slots = index->slots;
+    size_t old_size = (old_slots != NULL) ? (index->mask + 1) : 0;
+    size_t new_size = 32;
     size_t i = 0;
-    size_t number_string_length = 0;
-    cJSON_bool has_decimal_point = false;
 
-    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    if (count <= (old_size / 2))
     {
-        return false;
+        return true;
     }
 
-    /* copy the number into a temporary buffer and replace '.' with the decimal point
-     * of the current locale (for strtod)
-     * This also takes care of '\0' not necessarily being available for marking the end of the input */
-    for (i = 0; can_access_at_index(input_buffer, i); i++)
-    {
-        switch (buffer_at_offset(input_buffer)[i])
-        {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '+':
-            case '-':
-            case 'e':
-            case 'E':
-                number_string_length++;
-                break;
-
-            case '.':
-                number_string_length++;
-                has_decimal_point = true;
-                break;
-
-            default:
-                goto loop_end;
+    while (new_size < (count * 2))
+    {
+        if (new_size > (((size_t)-1) / (2 * sizeof(index_slot))))
+        {
+            return false;
         }
+        new_size *= 2;
     }
-loop_end:
-    /* malloc for temporary buffer, add 1 for '\0' */
-    number_c_string = (unsigned char *) input_buffer->hooks.allocate(number_string_length + 1);
-    if (number_c_string == NULL)
+
+    index->slots = (index_slot*)index->hooks.allocate(new_size * sizeof(index_slot));
+    if (index->slots == NULL)
     {
-        return false; /* allocation failure */
+        index->slots = old_slots;
+        return false;
     }
+    memset(index->slots, '\0', new_size * sizeof(index_slot));
+    index->mask = new_size - 1;
+    index->count = 0;
 
-    memcpy(number_c_string, buffer_at_offset(input_buffer), number_string_length);
-    number_c_string[number_string_length] = '\0';
-
-    if (has_decimal_point)
+    for (i = 0; i < old_size; i++)
     {
-        for (i = 0; i < number_string_length; i++)
+        if (old_slots[i].item != NULL)
         {
-            if (number_c_string[i] == '.')
-            {
-                /* replace '.' with the decimal point of the current locale (for strtod) */
-                number_c_string[i] = decimal_point;
-            }
+            index_insert_slot(index, old_slots[i].hash, old_slots[i].position, old_slots[i].item);
         }
     }
-
-    number = strtod((const char*)number_c_string, (char**)&after_end);
-    if (number_c_string == after_end)
+    if (old_slots != NULL)
     {
-        /* free the temporary buffer */
-        input_buffer->hooks.deallocate(number_c_string);
-        return false; /* parse_error */
+        index->hooks.deallocate(old_slots);
     }
 
-    item->valuedouble = number;
+    return true;
+}
 
-    /* use saturation in case of overflow */
-    if (number >= INT_MAX)
+/* put every child of object into an empty key table */
+static cJSON_bool fill_object_index(struct cJSON_Index * const index, const cJSON * const object)
+{
+    cJSON *child = NULL;
+    size_t count = 0;
+    size_t position = 0;
+
+    for (child = object->child; child != NULL; child = child->next)
     {
-        item->valueint = INT_MAX;
+        count++;
     }
-    else if (number <= (double)INT_MIN)
+
+    if (!index_reserve(index, count))
     {
-        item->valueint = INT_MIN;
+        return false;
     }
-    else
+
+    for (child = object->child; child != NULL; child = child->next, position++)
     {
-        item->valueint = (int)number;
+        if (child->string != NULL)
+        {
+            index_insert_slot(index, hash_key((const unsigned char*)child->string), position, child);
+        }
     }
+    index->next_position = position;
 
-    item->type = cJSON_Number;
-
-    input_buffer->offset += (size_t)(after_end - number_c_string);
-    /* free the temporary buffer */
-    input_buffer->hooks.deallocate(number_c_string);
     return true;
 }
 
-/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
-CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
+static void build_object_index(cJSON * const object, const internal_hooks * const hooks)
 {
-    if (number >= INT_MAX)
-    {
-        object->valueint = INT_MAX;
-    }
-    else if (number <= (double)INT_MIN)
+    struct cJSON_Index *index = (struct cJSON_Index*)hooks->allocate(sizeof(struct cJSON_Index));
+    if (index == NULL)
     {
-        object->valueint = INT_MIN;
+        return;
     }
-    else
+    memset(index, '\0', sizeof(struct cJSON_Index));
+    index->hooks = *hooks;
+
+    if (!fill_object_index(index, object))
     {
-        object->valueint = (int)number;
+        free_index(index);
+        return;
     }
 
-    return object->valuedouble = number;
+    object->index = index;
 }
 
-/* Note: when passing a NULL valuestring, cJSON_SetValuestring treats this as an error and return NULL */
-CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
+/* make room for "count" children behind index->first */
+static cJSON_bool index_items_reserve(struct cJSON_Index * const index, size_t count)
 {
-    char *copy = NULL;
-    size_t v1_len;
-    size_t v2_len;
-    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
-    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    cJSON **new_items = NULL;
+    size_t new_capacity = 16;
+
+    if ((index->first + count) <= index->item_capacity)
     {
-        return NULL;
+        return true;
     }
-    /* return NULL if the object is corrupted or valuestring is NULL */
-    if (object->valuestring == NULL || valuestring == NULL)
+
+    if (count <= (index->item_capacity / 2))
     {
-        return NULL;
+        /* plenty of space, it is just all in front */
+        memmove(index->items, index->items + index->first, index->item_count * sizeof(cJSON*));
+        index->first = 0;
+        return true;
     }
 
-    v1_len = strlen(valuestring);
-    v2_len = strlen(object->valuestring);
-
-    if (v1_len <= v2_len)
+    while (new_capacity < count)
     {
-        /* strcpy does not handle overlapping string: [X1, X2] [Y1, Y2] => X2 < Y1 or Y2 < X1 */
-        if (!( valuestring + v1_len < object->valuestring || object->valuestring + v2_len < valuestring ))
+        if (new_capacity > (((size_t)-1) / (2 * sizeof(cJSON*))))
         {
-            return NULL;
+            return false;
         }
-        strcpy(object->valuestring, valuestring);
-        return object->valuestring;
+        new_capacity *= 2;
     }
-    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
-    if (copy == NULL)
+    if (new_capacity < (index->item_capacity * 2))
     {
-        return NULL;
+        new_capacity = index->item_capacity * 2;
     }
-    if (object->valuestring != NULL)
+
+    new_items = (cJSON**)index->hooks.allocate(new_capacity * sizeof(cJSON*));
+    if (new_items == NULL)
     {
-        cJSON_free(object->valuestring);
+        return false;
     }
-    object->valuestring = copy;
+    if (index->items != NULL)
+    {
+        memcpy(new_items, index->items + index->first, index->item_count * sizeof(cJSON*));
+        index->hooks.deallocate(index->items);
+    }
+    index->items = new_items;
+    index->first = 0;
+    index->item_capacity = new_capacity;
 
-    return copy;
+    return true;
 }
 
-typedef struct
+/* put every child of array into an empty vector */
+static cJSON_bool fill_array_index(struct cJSON_Index * const index, const cJSON * const array)
 {
-    unsigned char *buffer;
-    size_t length;
-    size_t offset;
-    size_t depth; /* current nesting depth (for formatted printing) */
-    cJSON_bool noalloc;
-    cJSON_bool format; /* is this print a formatted print */
-    internal_hooks hooks;
-} printbuffer;
+    cJSON *child = NULL;
+    size_t count = 0;
 
-/* realloc printbuffer if necessary to have at least "needed" bytes more */
-static unsigned char* ensure(printbuffer * const p, size_t needed)
-{
-    unsigned char *newbuffer = NULL;
-    size_t newsize = 0;
+    for (child = array->child; child != NULL; child = child->next)
+    {
+        count++;
+    }
 
-    if ((p == NULL) || (p->buffer == NULL))
+    if (!index_items_reserve(index, count))
     {
-        return NULL;
+        return false;
     }
 
-    if ((p->length > 0) && (p->offset >= p->length))
+    for (child = array->child; child != NULL; child = child->next)
     {
-        /* make sure that offset is valid */
-        return NULL;
+        index->items[index->item_count++] = child;
     }
 
-    if (needed > INT_MAX)
+    return true;
+}
+
+static void build_array_index(cJSON * const array, const internal_hooks * const hooks)
+{
+    struct cJSON_Index *index = (struct cJSON_Index*)hooks->allocate(sizeof(struct cJSON_Index));
+    if (index == NULL)
     {
-        /* sizes bigger than INT_MAX are currently not supported */
-        return NULL;
+        return;
     }
+    memset(index, '\0', sizeof(struct cJSON_Index));
+    index->hooks = *hooks;
 
-    needed += p->offset + 1;
-    if (needed <= p->length)
+    if (!fill_array_index(index, array))
     {
-        return p->buffer + p->offset;
+        free_index(index);
+        return;
     }
 
-    if (p->noalloc) {
-        return NULL;
+    array->index = index;
+}
+
+/* rebuild a stale index in place, or drop it if that fails */
+static cJSON_bool refill_index(cJSON * const item)
+{
+    struct cJSON_Index *index = item->index;
+    cJSON_bool filled = false;
+
+    if (!index->stale)
+    {
+        return true;
     }
 
-    /* calculate new buffer size */
-    if (needed > (INT_MAX / 2))
+    index->stale = false;
+    if (index->items != NULL)
     {
-        /* overflow of int, use INT_MAX if possible */
-        if (needed <= INT_MAX)
-        {
-            newsize = INT_MAX;
-        }
-        else
-        {
-            return NULL;
-        }
+        index->first = 0;
+        index->item_count = 0;
+        filled = fill_array_index(index, item);
     }
     else
     {
-        newsize = needed * 2;
+        memset(index->slots, '\0', (index->mask + 1) * sizeof(index_slot));
+        index->count = 0;
+        filled = fill_object_index(index, item);
     }
 
-    if (p->hooks.reallocate != NULL)
+    if (!filled)
     {
-        /* reallocate with realloc if available */
-        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
-        if (newbuffer == NULL)
-        {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
-
-            return NULL;
-        }
+        cJSON_InvalidateIndex(item);
+        return false;
     }
-    else
-    {
-        /* otherwise reallocate manually */
-        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
-        if (!newbuffer)
-        {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
-
-            return NULL;
-        }
 
-        memcpy(newbuffer, p->buffer, p->offset + 1);
-        p->hooks.deallocate(p->buffer);
-    }
-    p->length = newsize;
-    p->buffer = newbuffer;
+    return true;
+}
 
-    return newbuffer + p->offset;
+/* the index of item if lookups can use it and mutations have to keep it in sync */
+static struct cJSON_Index *live_index(const cJSON * const item)
+{
+    return ((item->index != NULL) && !item->index->stale) ? item->index : NULL;
 }
 
-/* calculate the new length of the string in a printbuffer and update the offset */
-static void update_offset(printbuffer * const buffer)
+/* find the position of item in the array index from the caller's guess or the ends.
+ * Anywhere else it would be a linear search, so the caller lets the index go stale instead. */
+static size_t index_items_find(const struct cJSON_Index * const index, const cJSON * const item, size_t hint)
 {
-    const unsigned char *buffer_pointer = NULL;
-    if ((buffer == NULL) || (buffer->buffer == NULL))
+    if (index->item_count == 0)
     {
-        return;
+        return 0;
     }
-    buffer_pointer = buffer->buffer + buffer->offset;
 
-    buffer->offset += strlen((const char*)buffer_pointer);
+    if ((hint < index->item_count) && (index->items[index->first + hint] == item))
+    {
+        return hint;
+    }
+    if (index->items[index->first] == item)
+    {
+        return 0;
+    }
+    if (index->items[index->first + index->item_count - 1] == item)
+    {
+        return index->item_count - 1;
+    }
+
+    return index->item_count;
 }
 
-/* securely comparison of floating-point variables */
-static cJSON_bool compare_double(double a, double b)
+static void index_items_insert(cJSON * const array, size_t position, cJSON * const item)
 {
-    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
-    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+    struct cJSON_Index *index = array->index;
+
+    if (position > index->item_count)
+    {
+        index->stale = true;
+        return;
+    }
+
+    if ((position < (index->item_count / 2)) && (index->first > 0))
+    {
+        /* shift the front part forward */
+        index->first--;
+        memmove(index->items + index->first, index->items + index->first + 1, position * sizeof(cJSON*));
+    }
+    else
+    {
+        if (!index_items_reserve(index, index->item_count + 1))
+        {
+            cJSON_InvalidateIndex(array);
+            return;
+        }
+        memmove(index->items + index->first + position + 1, index->items + index->first + position, (index->item_count - position) * sizeof(cJSON*));
+    }
+
+    index->items[index->first + position] = item;
+    index->item_count++;
 }
 
-/* Render the number nicely from the given item into a string. */
-static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+static void index_items_remove(cJSON * const array, const cJSON * const item, size_t hint)
 {
-    unsigned char *output_pointer = NULL;
-    double d = item->valuedouble;
-    int length = 0;
-    size_t i = 0;
-    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
-    unsigned char decimal_point = get_decimal_point();
-    double test = 0.0;
+    struct cJSON_Index *index = array->index;
+    size_t position = index_items_find(index, item, hint);
 
-    if (output_buffer == NULL)
+    if (position >= index->item_count)
     {
-        return false;
+        index->stale = true;
+        return;
     }
 
-    /* This checks for NaN and Infinity */
-    if (isnan(d) || isinf(d))
+    if (position < (index->item_count / 2))
     {
-        length = sprintf((char*)number_buffer, "null");
+        /* close the gap from the front */
+        memmove(index->items + index->first + 1, index->items + index->first, position * sizeof(cJSON*));
+        index->first++;
     }
-    else if(d == (double)item->valueint)
+    else
     {
-        length = sprintf((char*)number_buffer, "%d", item->valueint);
+        memmove(index->items + index->first + position, index->items + index->first + position + 1, (index->item_count - position - 1) * sizeof(cJSON*));
     }
-    else
+    index->item_count--;
+}
+
+/* keep an existing index in sync when an item is appended, or drop it if that fails */
+static void index_append(cJSON * const object, cJSON * const item)
+{
+    struct cJSON_Index *index = live_index(object);
+
+    if ((index != NULL) && (index->items != NULL))
     {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
+        index_items_insert(object, index->item_count, item);
+        return;
+    }
 
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
-        {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
-        }
+    if ((index == NULL) || (item->string == NULL))
+    {
+        return;
+    }
+
+    if (!index_reserve(index, index->count + 1))
+    {
+        free_index(index);
+        object->index = NULL;
+        return;
     }
 
-    /* sprintf failed or buffer overrun occurred */
-    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    index_insert_slot(index, hash_key((const unsigned char*)item->string), index->next_position++, item);
+}
+
+/* take item out of the key table and report its position, false if it isn't in there */
+static cJSON_bool index_remove_slot(struct cJSON_Index * const index, const cJSON * const item, size_t * const position)
+{
+    size_t slot = 0;
+    size_t next = 0;
+
+    if (item->string == NULL)
     {
         return false;
     }
 
-    /* reserve appropriate space in the output */
-    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
-    if (output_pointer == NULL)
+    slot = hash_key((const unsigned char*)item->string) & index->mask;
+    while ((index->slots[slot].item != NULL) && (index->slots[slot].item != item))
+    {
+        slot = (slot + 1) & index->mask;
+    }
+    if (index->slots[slot].item == NULL)
     {
         return false;
     }
+    *position = index->slots[slot].position;
 
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
+    /* shift the rest of the probe run back into the hole, so that later lookups don't stop at it */
+    next = (slot + 1) & index->mask;
+    while (index->slots[next].item != NULL)
     {
-        if (number_buffer[i] == decimal_point)
+        size_t home = index->slots[next].hash & index->mask;
+        if (((next - home) & index->mask) >= ((next - slot) & index->mask))
         {
-            output_pointer[i] = '.';
-            continue;
+            index->slots[slot] = index->slots[next];
+            slot = next;
         }
-
-        output_pointer[i] = number_buffer[i];
+        next = (next + 1) & index->mask;
     }
-    output_pointer[i] = '\0';
-
-    output_buffer->offset += (size_t)length;
+    index->slots[slot].item = NULL;
+    index->count--;
 
     return true;
 }
 
-/* parse 4 digit hexadecimal number */
-static unsigned parse_hex4(const unsigned char * const input)
+static cJSON *index_lookup(const struct cJSON_Index * const index, const char * const name, const cJSON_bool case_sensitive)
 {
-    unsigned int h = 0;
-    size_t i = 0;
+    size_t hash = hash_key((const unsigned char*)name);
+    size_t slot = hash & index->mask;
+    cJSON *found = NULL;
+    size_t found_position = 0;
 
-    for (i = 0; i < 4; i++)
+    while (index->slots[slot].item != NULL)
     {
-        /* parse digit */
-        if ((input[i] >= '0') && (input[i] <= '9'))
-        {
-            h += (unsigned int) input[i] - '0';
-        }
-        else if ((input[i] >= 'A') && (input[i] <= 'F'))
-        {
-            h += (unsigned int) 10 + input[i] - 'A';
-        }
-        else if ((input[i] >= 'a') && (input[i] <= 'f'))
-        {
-            h += (unsigned int) 10 + input[i] - 'a';
-        }
-        else /* invalid */
-        {
-            return 0;
-        }
-
-        if (i < 3)
+        const index_slot *current = &index->slots[slot];
+        if ((current->hash == hash) && ((found == NULL) || (current->position < found_position)))
         {
-            /* shift left to make place for the next nibble */
-            h = h << 4;
+            /* interned keys match by address */
+            int difference = 0;
+            if (current->item->string != name)
+            {
+                difference = case_sensitive
+                    ? strcmp(name, current->item->string)
+                    : case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)current->item->string);
+            }
+            if (difference == 0)
+            {
+                found = current->item;
+                found_position = current->position;
+            }
         }
+        slot = (slot + 1) & index->mask;
     }
 
-    return h;
+    return found;
 }
 
-/* converts a UTF-16 literal to UTF-8
- * A literal can be one or two sequences of the form \uXXXX */
-static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *item)
 {
-    long unsigned int codepoint = 0;
-    unsigned int first_code = 0;
-    const unsigned char *first_sequence = input_pointer;
-    unsigned char utf8_length = 0;
-    unsigned char utf8_position = 0;
-    unsigned char sequence_length = 0;
-    unsigned char first_byte_mark = 0;
-
-    if ((input_end - first_sequence) < 6)
+    if ((item != NULL) && (item->index != NULL))
     {
-        /* input ends unexpectedly */
-        goto fail;
+        free_index(item->index);
+        item->index = NULL;
     }
+}
 
-    /* get the first utf16 sequence */
-    first_code = parse_hex4(first_sequence + 2);
+/* index item and every array/object below it with more than CJSON_INDEX_THRESHOLD children, and refill stale indexes.
+ * References share their children with another item, so they can't know when the children change. */
+static cJSON_bool build_indexes(cJSON * const item, const internal_hooks * const hooks)
+{
+    cJSON *child = NULL;
+    size_t count = 0;
+    cJSON_bool built = true;
 
-    /* check that the code is valid */
-    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+    if ((item->type & cJSON_IsReference) || !(item->type & (cJSON_Array | cJSON_Object)))
     {
-        goto fail;
+        return true;
     }
 
-    /* UTF16 surrogate pair */
-    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
+    for (child = item->child; child != NULL; child = child->next)
     {
-        const unsigned char *second_sequence = first_sequence + 6;
-        unsigned int second_code = 0;
-        sequence_length = 12; /* \uXXXX\uXXXX */
-
-        if ((input_end - second_sequence) < 6)
-        {
-            /* input ends unexpectedly */
-            goto fail;
-        }
-
-        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
-        {
-            /* missing second half of the surrogate pair */
-            goto fail;
-        }
-
-        /* get the second utf16 sequence */
-        second_code = parse_hex4(second_sequence + 2);
-        /* check that the code is valid */
-        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
-        {
-            /* invalid second half of the surrogate pair */
-            goto fail;
-        }
+        count++;
+        built = build_indexes(child, hooks) && built;
+    }
 
+    if (item->index != NULL)
+    {
+        return refill_index(item) && built;
+    }
+    if (count <= CJSON_INDEX_THRESHOLD)
+    {
+        return built;
+    }
 
-        /* calculate the unicode codepoint from the surrogate pair */
-        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
+    if (item->type & cJSON_Array)
+    {
+        build_array_index(item, hooks);
     }
     else
     {
-        sequence_length = 6; /* \uXXXX */
-        codepoint = first_code;
+        build_object_index(item, hooks);
     }
+    return (item->index != NULL) && built;
+}
 
-    /* encode as UTF-8
-     * takes at maximum 4 bytes to encode:
-     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
-    if (codepoint < 0x80)
+CJSON_PUBLIC(cJSON_bool) cJSON_BuildIndex(cJSON *item)
+{
+    if (item == NULL)
     {
-        /* normal ascii, encoding 0xxxxxxx */
-        utf8_length = 1;
+        return false;
     }
-    else if (codepoint < 0x800)
+
+    return build_indexes(item, &global_hooks);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_BuildIndexWithContext(cJSON_Context *context, cJSON *item)
+{
+    if (item == NULL)
     {
-        /* two bytes, encoding 110xxxxx 10xxxxxx */
-        utf8_length = 2;
-        first_byte_mark = 0xC0; /* 11000000 */
+        return false;
     }
-    else if (codepoint < 0x10000)
+
+    return build_indexes(item, (context != NULL) ? &context->hooks : &global_hooks);
+}
+
+/* keep the key table of an object in sync when a child leaves */
+static void index_slots_remove(cJSON * const object, const cJSON * const item)
+{
+    size_t position = 0;
+
+    if ((item->string != NULL) && !index_remove_slot(object->index, item, &position))
     {
-        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 3;
-        first_byte_mark = 0xE0; /* 11100000 */
+        object->index->stale = true;
     }
-    else if (codepoint <= 0x10FFFF)
+}
+
+/* a child inserted before others gets a fresh position, which only matters if its key is already there */
+static void index_slots_insert(cJSON * const object, cJSON * const item)
+{
+    struct cJSON_Index *index = object->index;
+
+    if (item->string == NULL)
     {
-        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 4;
-        first_byte_mark = 0xF0; /* 11110000 */
+        return;
     }
-    else
+
+    if (index_lookup(index, item->string, false) != NULL)
     {
-        /* invalid unicode codepoint */
-        goto fail;
+        index->stale = true;
+        return;
+    }
+    if (!index_reserve(index, index->count + 1))
+    {
+        cJSON_InvalidateIndex(object);
+        return;
     }
 
-    /* encode as utf8 */
-    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
+    index_insert_slot(index, hash_key((const unsigned char*)item->string), index->next_position++, item);
+}
+
+/* the replacement takes over the position of the child it replaces.
+ * Under another key that is only right if no other child has that key. */
+static void index_slots_replace(cJSON * const object, const cJSON * const item, cJSON * const replacement)
+{
+    struct cJSON_Index *index = object->index;
+    size_t position = 0;
+
+    if (!index_remove_slot(index, item, &position))
     {
-        /* 10xxxxxx */
-        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
-        codepoint >>= 6;
+        index->stale = true;
+        return;
     }
-    /* encode first byte */
-    if (utf8_length > 1)
+
+    if (replacement->string == NULL)
     {
-        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+        return;
     }
-    else
+
+    if ((case_insensitive_strcmp((const unsigned char*)replacement->string, (const unsigned char*)item->string) != 0)
+        && (index_lookup(index, replacement->string, false) != NULL))
     {
-        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+        index->stale = true;
+        return;
     }
 
-    *output_pointer += utf8_length;
+    index_insert_slot(index, hash_key((const unsigned char*)replacement->string), position, replacement);
+}
 
-    return sequence_length;
+/* Interned keys: one immutable copy of each distinct key, shared by every object that is parsed with the table */
+typedef struct
+{
+    size_t hash;
+    size_t length;
+    char *string; /* NULL if the entry is empty */
+} intern_entry;
 
-fail:
-    return 0;
-}
+typedef struct intern_table
+{
+    intern_entry *entries;
+    size_t count;
+    size_t mask; /* capacity - 1, the capacity is a power of two */
+} intern_table;
 
-/* Parse the input text into an unescaped cinput, and populate item. */
-static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+static size_t hash_span(const unsigned char *key, size_t length)
 {
-    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
-    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
-    unsigned char *output_pointer = NULL;
-    unsigned char *output = NULL;
+    size_t hash = (size_t)2166136261u;
 
-    /* not a string */
-    if (buffer_at_offset(input_buffer)[0] != '\"')
+    for (; length > 0; (void)key++, length--)
     {
-        goto fail;
+        hash ^= (size_t)*key;
+        hash *= (size_t)16777619u;
     }
 
-    {
-        /* calculate approximate size of the output (overestimate) */
-        size_t allocation_length = 0;
-        size_t skipped_bytes = 0;
-        while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
-        {
-            /* is escape sequence */
-            if (input_end[0] == '\\')
-            {
-                if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
-                {
-                    /* prevent buffer overflow when last input character is a backslash */
-                    goto fail;
-                }
-                skipped_bytes++;
-                input_end++;
-            }
-            input_end++;
-        }
-        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
-        {
-            goto fail; /* string ended unexpectedly */
-        }
-
-        /* This is at most how much we need for the output */
-        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
-        if (output == NULL)
-        {
-            goto fail; /* allocation failure */
-        }
-    }
-
-    output_pointer = output;
-    /* loop through the string literal */
-    while (input_pointer < input_end)
-    {
-        if (*input_pointer != '\\')
-        {
-            *output_pointer++ = *input_pointer++;
-        }
-        /* escape sequence */
-        else
-        {
-            unsigned char sequence_length = 2;
-            if ((input_end - input_pointer) < 1)
-            {
-                goto fail;
-            }
-
-            switch (input_pointer[1])
-            {
-                case 'b':
-                    *output_pointer++ = '\b';
-                    break;
-                case 'f':
-                    *output_pointer++ = '\f';
-                    break;
-                case 'n':
-                    *output_pointer++ = '\n';
-                    break;
-                case 'r':
-                    *output_pointer++ = '\r';
-                    break;
-                case 't':
-                    *output_pointer++ = '\t';
-                    break;
-                case '\"':
-                case '\\':
-                case '/':
-                    *output_pointer++ = input_pointer[1];
-                    break;
-
-                /* UTF-16 literal */
-                case 'u':
-                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
-                    if (sequence_length == 0)
-                    {
-                        /* failed to convert UTF16-literal to UTF-8 */
-                        goto fail;
-                    }
-                    break;
-
-                default:
-                    goto fail;
-            }
-            input_pointer += sequence_length;
-        }
-    }
-
-    /* zero terminate the output */
-    *output_pointer = '\0';
-
-    item->type = cJSON_String;
-    item->valuestring = (char*)output;
-
-    input_buffer->offset = (size_t) (input_end - input_buffer->content);
-    input_buffer->offset++;
-
-    return true;
+    return hash;
+}
 
-fail:
-    if (output != NULL)
+static intern_table *create_intern_table(const internal_hooks * const hooks)
+{
+    const size_t capacity = 64;
+    intern_table *table = (intern_table*)hooks->allocate(sizeof(intern_table));
+    if (table == NULL)
     {
-        input_buffer->hooks.deallocate(output);
-        output = NULL;
+        return NULL;
     }
 
-    if (input_pointer != NULL)
+    table->entries = (intern_entry*)hooks->allocate(capacity * sizeof(intern_entry));
+    if (table->entries == NULL)
     {
-        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+        hooks->deallocate(table);
+        return NULL;
     }
+    memset(table->entries, '\0', capacity * sizeof(intern_entry));
+    table->count = 0;
+    table->mask = capacity - 1;
 
-    return false;
+    return table;
 }
 
-/* Render the cstring provided to an escaped version that can be printed. */
-static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+static void free_intern_table(intern_table *table, const internal_hooks * const hooks)
 {
-    const unsigned char *input_pointer = NULL;
-    unsigned char *output = NULL;
-    unsigned char *output_pointer = NULL;
-    size_t output_length = 0;
-    /* numbers of additional characters needed for escaping */
-    size_t escape_characters = 0;
+    size_t i = 0;
 
-    if (output_buffer == NULL)
+    if (table == NULL)
     {
-        return false;
+        return;
     }
 
-    /* empty string */
-    if (input == NULL)
+    for (i = 0; i <= table->mask; i++)
     {
-        output = ensure(output_buffer, sizeof("\"\""));
-        if (output == NULL)
+        if (table->entries[i].string != NULL)
         {
-            return false;
+            hooks->deallocate(table->entries[i].string);
         }
-        strcpy((char*)output, "\"\"");
-
-        return true;
     }
+    hooks->deallocate(table->entries);
+    hooks->deallocate(table);
+}
 
-    /* set "flag" to 1 if something needs to be escaped */
-    for (input_pointer = input; *input_pointer; input_pointer++)
+/* Returns the interned copy of the length bytes at key, adding it if it is new */
+static const char *intern_span(intern_table * const table, const unsigned char * const key, const size_t length, const internal_hooks * const hooks)
+{
+    size_t hash = hash_span(key, length);
+    size_t slot = hash & table->mask;
+    char *copy = NULL;
+
+    while (table->entries[slot].string != NULL)
     {
-        switch (*input_pointer)
+        const intern_entry *entry = &table->entries[slot];
+        if ((entry->hash == hash) && (entry->length == length) && (memcmp(entry->string, key, length) == 0))
         {
-            case '\"':
-            case '\\':
-            case '\b':
-            case '\f':
-            case '\n':
-            case '\r':
-            case '\t':
-                /* one character escape sequence */
-                escape_characters++;
-                break;
-            default:
-                if (*input_pointer < 32)
-                {
-                    /* UTF-16 escape sequence uXXXX */
-                    escape_characters += 5;
-                }
-                break;
+            return entry->string;
         }
-    }
-    output_length = (size_t)(input_pointer - input) + escape_characters;
-
-    output = ensure(output_buffer, output_length + sizeof("\"\""));
-    if (output == NULL)
-    {
-        return false;
+        slot = (slot + 1) & table->mask;
     }
 
-    /* no characters have to be escaped */
-    if (escape_characters == 0)
+    /* keep the table at most half full */
+    if (((table->count + 1) * 2) > (table->mask + 1))
     {
-        output[0] = '\"';
-        memcpy(output + 1, input, output_length);
-        output[output_length + 1] = '\"';
-        output[output_length + 2] = '\0';
-
-        return true;
-    }
+        size_t new_capacity = (table->mask + 1) * 2;
+        intern_entry *new_entries = (intern_entry*)hooks->allocate(new_capacity * sizeof(intern_entry));
+        size_t i = 0;
 
-    output[0] = '\"';
-    output_pointer = output + 1;
-    /* copy the string */
-    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
-    {
-        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
+        if (new_entries == NULL)
         {
-            /* normal character, copy */
-            *output_pointer = *input_pointer;
+            return NULL;
         }
-        else
+        memset(new_entries, '\0', new_capacity * sizeof(intern_entry));
+        for (i = 0; i <= table->mask; i++)
         {
-            /* character needs to be escaped */
-            *output_pointer++ = '\\';
-            switch (*input_pointer)
+            if (table->entries[i].string != NULL)
             {
-                case '\\':
-                    *output_pointer = '\\';
-                    break;
-                case '\"':
-                    *output_pointer = '\"';
-                    break;
-                case '\b':
-                    *output_pointer = 'b';
-                    break;
-                case '\f':
-                    *output_pointer = 'f';
-                    break;
-                case '\n':
-                    *output_pointer = 'n';
-                    break;
-                case '\r':
-                    *output_pointer = 'r';
-                    break;
-                case '\t':
-                    *output_pointer = 't';
-                    break;
-                default:
-                    /* escape and print as unicode codepoint */
-                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
-                    output_pointer += 4;
-                    break;
+                size_t new_slot = table->entries[i].hash & (new_capacity - 1);
+                while (new_entries[new_slot].string != NULL)
+                {
+                    new_slot = (new_slot + 1) & (new_capacity - 1);
+                }
+                new_entries[new_slot] = table->entries[i];
             }
         }
-    }
-    output[output_length + 1] = '\"';
-    output[output_length + 2] = '\0';
-
-    return true;
-}
-
-/* Invoke print_string_ptr (which is useful) on an item. */
-static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
-{
-    return print_string_ptr((unsigned char*)item->valuestring, p);
-}
+        hooks->deallocate(table->entries);
+        table->entries = new_entries;
+        table->mask = new_capacity - 1;
 
-/* Predeclare these prototypes. */
-static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
+        slot = hash & table->mask;
+        while (table->entries[slot].string != NULL)
+        {
+            slot = (slot + 1) & table->mask;
+        }
+    }
 
-/* Utility to jump whitespace and cr/lf */
-static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
-{
-    if ((buffer == NULL) || (buffer->content == NULL))
+    copy = (char*)hooks->allocate(length + sizeof(""));
+    if (copy == NULL)
     {
         return NULL;
     }
+    memcpy(copy, key, length);
+    copy[length] = '\0';
 
-    if (cannot_access_at_index(buffer, 0))
-    {
-        return buffer;
-    }
+    table->entries[slot].hash = hash;
+    table->entries[slot].length = length;
+    table->entries[slot].string = copy;
+    table->count++;
 
-    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
+    return copy;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_EnableKeyInterning(cJSON_Context *context)
+{
+    if (context == NULL)
     {
-       buffer->offset++;
+        return false;
     }
-
-    if (buffer->offset == buffer->length)
+    if (context->keys == NULL)
     {
-        buffer->offset--;
+        context->keys = create_intern_table(&context->hooks);
     }
 
-    return buffer;
+    return context->keys != NULL;
 }
 
-/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
-static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+CJSON_PUBLIC(const char *) cJSON_InternKey(cJSON_Context *context, const char *key)
 {
-    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
+    if ((key == NULL) || !cJSON_EnableKeyInterning(context))
     {
         return NULL;
     }
 
-    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
-    {
-        buffer->offset += 3;
-    }
-
-    return buffer;
+    return intern_span(context->keys, (const unsigned char*)key, strlen(key), &context->hooks);
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+static void delete_item(cJSON *item, const internal_hooks * const hooks)
 {
-    size_t buffer_length;
-
-    if (NULL == value)
+    cJSON *next = NULL;
+    while (item != NULL)
     {
-        return NULL;
+        next = item->next;
+        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
+        {
+            delete_item(item->child, hooks);
+        }
+        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
+        {
+            hooks->deallocate(item->valuestring);
+            item->valuestring = NULL;
+        }
+        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
+        {
+            hooks->deallocate(item->string);
+            item->string = NULL;
+        }
+        free_index(item->index);
+        hooks->deallocate(item);
+        item = next;
     }
-
-    /* Adding null character size due to require_null_terminated. */
-    buffer_length = strlen(value) + sizeof("");
-
-    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
 }
 
-/* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+/* Delete a cJSON structure. */
+CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
-    cJSON *item = NULL;
-
-    /* reset error position */
-    global_error.json = NULL;
-    global_error.position = 0;
-
-    if (value == NULL || 0 == buffer_length)
-    {
-        goto fail;
-    }
-
-    buffer.content = (const unsigned char*)value;
-    buffer.length = buffer_length;
-    buffer.offset = 0;
-    buffer.hooks = global_hooks;
+    delete_item(item, &global_hooks);
+}
 
-    item = cJSON_New_Item(&global_hooks);
-    if (item == NULL) /* memory fail */
-    {
-        goto fail;
-    }
+CJSON_PUBLIC(void) cJSON_DeleteWithContext(cJSON_Context *context, cJSON *item)
+{
+    delete_item(item, (context != NULL) ? &context->hooks : &global_hooks);
+}
 
-    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
-    {
-        /* parse failure. ep is set. */
-        goto fail;
-    }
+/* Number conversion works on the binary representation of doubles:
+ * parsing uses the Clinger fast path and the Eisel-Lemire algorithm, printing uses Grisu2.
+ * Both only fall back to the C library (and the locale) for inputs they can't decide exactly. */
 
-    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
-    if (require_null_terminated)
-    {
-        buffer_skip_whitespace(&buffer);
-        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
-        {
-            goto fail;
-        }
-    }
-    if (return_parse_end)
-    {
-        *return_parse_end = (const char*)buffer_at_offset(&buffer);
-    }
+/* 128 bit approximations (rounded down) of the powers of ten from 1e-348 to 1e347,
+ * normalized so that the most significant bit is set. { high 64 bits, low 64 bits } */
+#define POWER_OF_TEN_MIN_EXPONENT (-348)
+#define POWER_OF_TEN_MAX_EXPONENT 347
+static const uint64_t power_of_ten_table[][2] =
+{
+    { 0xFA8FD5A0081C0288u, 0x1732C869CD60E453u }, /* 1e-348 */
+    { 0x9C99E58405118195u, 0x0E7FBD42205C8EB4u }, /* 1e-347 */
+    { 0xC3C05EE50655E1FAu, 0x521FAC92A873B261u }, /* 1e-346 */
+    { 0xF4B0769E47EB5A78u, 0xE6A797B752909EF9u }, /* 1e-345 */
+    { 0x98EE4A22ECF3188Bu, 0x9028BED2939A635Cu }, /* 1e-344 */
+    { 0xBF29DCABA82FDEAEu, 0x7432EE873880FC33u }, /* 1e-343 */
+    { 0xEEF453D6923BD65Au, 0x113FAA2906A13B3Fu }, /* 1e-342 */
+    { 0x9558B4661B6565F8u, 0x4AC7CA59A424C507u }, /* 1e-341 */
+    { 0xBAAEE17FA23EBF76u, 0x5D79BCF00D2DF649u }, /* 1e-340 */
+    { 0xE95A99DF8ACE6F53u, 0xF4D82C2C107973DCu }, /* 1e-339 */
+    { 0x91D8A02BB6C10594u, 0x79071B9B8A4BE869u }, /* 1e-338 */
+    { 0xB64EC836A47146F9u, 0x9748E2826CDEE284u }, /* 1e-337 */
+    { 0xE3E27A444D8D98B7u, 0xFD1B1B2308169B25u }, /* 1e-336 */
+    { 0x8E6D8C6AB0787F72u, 0xFE30F0F5E50E20F7u }, /* 1e-335 */
+    { 0xB208EF855C969F4Fu, 0xBDBD2D335E51A935u }, /* 1e-334 */
+    { 0xDE8B2B66B3BC4723u, 0xAD2C788035E61382u }, /* 1e-333 */
+    { 0x8B16FB203055AC76u, 0x4C3BCB5021AFCC31u }, /* 1e-332 */
+    { 0xADDCB9E83C6B1793u, 0xDF4ABE242A1BBF3Du }, /* 1e-331 */
+    { 0xD953E8624B85DD78u, 0xD71D6DAD34A2AF0Du }, /* 1e-330 */
+    { 0x87D4713D6F33AA6Bu, 0x8672648C40E5AD68u }, /* 1e-329 */
+    { 0xA9C98D8CCB009506u, 0x680EFDAF511F18C2u }, /* 1e-328 */
+    { 0xD43BF0EFFDC0BA48u, 0x0212BD1B2566DEF2u }, /* 1e-327 */
+    { 0x84A57695FE98746Du, 0x014BB630F7604B57u }, /* 1e-326 */
+    { 0xA5CED43B7E3E9188u, 0x419EA3BD35385E2Du }, /* 1e-325 */
+    { 0xCF42894A5DCE35EAu, 0x52064CAC828675B9u }, /* 1e-324 */
+    { 0x818995CE7AA0E1B2u, 0x7343EFEBD1940993u }, /* 1e-323 */
+    { 0xA1EBFB4219491A1Fu, 0x1014EBE6C5F90BF8u }, /* 1e-322 */
+    { 0xCA66FA129F9B60A6u, 0xD41A26E077774EF6u }, /* 1e-321 */
+    { 0xFD00B897478238D0u, 0x8920B098955522B4u }, /* 1e-320 */
+    { 0x9E20735E8CB16382u, 0x55B46E5F5D5535B0u }, /* 1e-319 */
+    { 0xC5A890362FDDBC62u, 0xEB2189F734AA831Du }, /* 1e-318 */
+    { 0xF712B443BBD52B7Bu, 0xA5E9EC7501D523E4u }, /* 1e-317 */
+    { 0x9A6BB0AA55653B2Du, 0x47B233C92125366Eu }, /* 1e-316 */
+    { 0xC1069CD4EABE89F8u, 0x999EC0BB696E840Au }, /* 1e-315 */
+    { 0xF148440A256E2C76u, 0xC00670EA43CA250Du }, /* 1e-314 */
+    { 0x96CD2A865764DBCAu, 0x380406926A5E5728u }, /* 1e-313 */
+    { 0xBC807527ED3E12BCu, 0xC605083704F5ECF2u }, /* 1e-312 */
+    { 0xEBA09271E88D976Bu, 0xF7864A44C633682Eu }, /* 1e-311 */
+    { 0x93445B8731587EA3u, 0x7AB3EE6AFBE0211Du }, /* 1e-310 */
+    { 0xB8157268FDAE9E4Cu, 0x5960EA05BAD82964u }, /* 1e-309 */
+    { 0xE61ACF033D1A45DFu, 0x6FB92487298E33BDu }, /* 1e-308 */
+    { 0x8FD0C16206306BABu, 0xA5D3B6D479F8E056u }, /* 1e-307 */
+    { 0xB3C4F1BA87BC8696u, 0x8F48A4899877186Cu }, /* 1e-306 */
+    { 0xE0B62E2929ABA83Cu, 0x331ACDABFE94DE87u }, /* 1e-305 */
+    { 0x8C71DCD9BA0B4925u, 0x9FF0C08B7F1D0B14u }, /* 1e-304 */
+    { 0xAF8E5410288E1B6Fu, 0x07ECF0AE5EE44DD9u }, /* 1e-303 */
+    { 0xDB71E91432B1A24Au, 0xC9E82CD9F69D6150u }, /* 1e-302 */
+    { 0x892731AC9FAF056Eu, 0xBE311C083A225CD2u }, /* 1e-301 */
+    { 0xAB70FE17C79AC6CAu, 0x6DBD630A48AAF406u }, /* 1e-300 */
+    { 0xD64D3D9DB981787Du, 0x092CBBCCDAD5B108u }, /* 1e-299 */
+    { 0x85F0468293F0EB4Eu, 0x25BBF56008C58EA5u }, /* 1e-298 */
+    { 0xA76C582338ED2621u, 0xAF2AF2B80AF6F24Eu }, /* 1e-297 */
+    { 0xD1476E2C07286FAAu, 0x1AF5AF660DB4AEE1u }, /* 1e-296 */
+    { 0x82CCA4DB847945CAu, 0x50D98D9FC890ED4Du }, /* 1e-295 */
+    { 0xA37FCE126597973Cu, 0xE50FF107BAB528A0u }, /* 1e-294 */
+    { 0xCC5FC196FEFD7D0Cu, 0x1E53ED49A96272C8u }, /* 1e-293 */
+    { 0xFF77B1FCBEBCDC4Fu, 0x25E8E89C13BB0F7Au }, /* 1e-292 */
+    { 0x9FAACF3DF73609B1u, 0x77B191618C54E9ACu }, /* 1e-291 */
+    { 0xC795830D75038C1Du, 0xD59DF5B9EF6A2417u }, /* 1e-290 */
+    { 0xF97AE3D0D2446F25u, 0x4B0573286B44AD1Du }, /* 1e-289 */
+    { 0x9BECCE62836AC577u, 0x4EE367F9430AEC32u }, /* 1e-288 */
+    { 0xC2E801FB244576D5u, 0x229C41F793CDA73Fu }, /* 1e-287 */
+    { 0xF3A20279ED56D48Au, 0x6B43527578C1110Fu }, /* 1e-286 */
+    { 0x9845418C345644D6u, 0x830A13896B78AAA9u }, /* 1e-285 */
+    { 0xBE5691EF416BD60Cu, 0x23CC986BC656D553u }, /* 1e-284 */
+    { 0xEDEC366B11C6CB8Fu, 0x2CBFBE86B7EC8AA8u }, /* 1e-283 */
+    { 0x94B3A202EB1C3F39u, 0x7BF7D71432F3D6A9u }, /* 1e-282 */
+    { 0xB9E08A83A5E34F07u, 0xDAF5CCD93FB0CC53u }, /* 1e-281 */
+    { 0xE858AD248F5C22C9u, 0xD1B3400F8F9CFF68u }, /* 1e-280 */
+    { 0x91376C36D99995BEu, 0x23100809B9C21FA1u }, /* 1e-279 */
+    { 0xB58547448FFFFB2Du, 0xABD40A0C2832A78Au }, /* 1e-278 */
+    { 0xE2E69915B3FFF9F9u, 0x16C90C8F323F516Cu }, /* 1e-277 */
+    { 0x8DD01FAD907FFC3Bu, 0xAE3DA7D97F6792E3u }, /* 1e-276 */
+    { 0xB1442798F49FFB4Au, 0x99CD11CFDF41779Cu }, /* 1e-275 */
+    { 0xDD95317F31C7FA1Du, 0x40405643D711D583u }, /* 1e-274 */
+    { 0x8A7D3EEF7F1CFC52u, 0x482835EA666B2572u }, /* 1e-273 */
+    { 0xAD1C8EAB5EE43B66u, 0xDA3243650005EECFu }, /* 1e-272 */
+    { 0xD863B256369D4A40u, 0x90BED43E40076A82u }, /* 1e-271 */
+    { 0x873E4F75E2224E68u, 0x5A7744A6E804A291u }, /* 1e-270 */
+    { 0xA90DE3535AAAE202u, 0x711515D0A205CB36u }, /* 1e-269 */
+    { 0xD3515C2831559A83u, 0x0D5A5B44CA873E03u }, /* 1e-268 */
+    { 0x8412D9991ED58091u, 0xE858790AFE9486C2u }, /* 1e-267 */
+    { 0xA5178FFF668AE0B6u, 0x626E974DBE39A872u }, /* 1e-266 */
+    { 0xCE5D73FF402D98E3u, 0xFB0A3D212DC8128Fu }, /* 1e-265 */
+    { 0x80FA687F881C7F8Eu, 0x7CE66634BC9D0B99u }, /* 1e-264 */
+    { 0xA139029F6A239F72u, 0x1C1FFFC1EBC44E80u }, /* 1e-263 */
+    { 0xC987434744AC874Eu, 0xA327FFB266B56220u }, /* 1e-262 */
+    { 0xFBE9141915D7A922u, 0x4BF1FF9F0062BAA8u }, /* 1e-261 */
+    { 0x9D71AC8FADA6C9B5u, 0x6F773FC3603DB4A9u }, /* 1e-260 */
+    { 0xC4CE17B399107C22u, 0xCB550FB4384D21D3u }, /* 1e-259 */
+    { 0xF6019DA07F549B2Bu, 0x7E2A53A146606A48u }, /* 1e-258 */
+    { 0x99C102844F94E0FBu, 0x2EDA7444CBFC426Du }, /* 1e-257 */
+    { 0xC0314325637A1939u, 0xFA911155FEFB5308u }, /* 1e-256 */
+    { 0xF03D93EEBC589F88u, 0x793555AB7EBA27CAu }, /* 1e-255 */
+    { 0x96267C7535B763B5u, 0x4BC1558B2F3458DEu }, /* 1e-254 */
+    { 0xBBB01B9283253CA2u, 0x9EB1AAEDFB016F16u }, /* 1e-253 */
+    { 0xEA9C227723EE8BCBu, 0x465E15A979C1CADCu }, /* 1e-252 */
+    { 0x92A1958A7675175Fu, 0x0BFACD89EC191EC9u }, /* 1e-251 */
+    { 0xB749FAED14125D36u, 0xCEF980EC671F667Bu }, /* 1e-250 */
+    { 0xE51C79A85916F484u, 0x82B7E12780E7401Au }, /* 1e-249 */
+    { 0x8F31CC0937AE58D2u, 0xD1B2ECB8B0908810u }, /* 1e-248 */
+    { 0xB2FE3F0B8599EF07u, 0x861FA7E6DCB4AA15u }, /* 1e-247 */
+    { 0xDFBDCECE67006AC9u, 0x67A791E093E1D49Au }, /* 1e-246 */
+    { 0x8BD6A141006042BDu, 0xE0C8BB2C5C6D24E0u }, /* 1e-245 */
+    { 0xAECC49914078536Du, 0x58FAE9F773886E18u }, /* 1e-244 */
+    { 0xDA7F5BF590966848u, 0xAF39A475506A899Eu }, /* 1e-243 */
+    { 0x888F99797A5E012Du, 0x6D8406C952429603u }, /* 1e-242 */
+    { 0xAAB37FD7D8F58178u, 0xC8E5087BA6D33B83u }, /* 1e-241 */
+    { 0xD5605FCDCF32E1D6u, 0xFB1E4A9A90880A64u }, /* 1e-240 */
+    { 0x855C3BE0A17FCD26u, 0x5CF2EEA09A55067Fu }, /* 1e-239 */
+    { 0xA6B34AD8C9DFC06Fu, 0xF42FAA48C0EA481Eu }, /* 1e-238 */
+    { 0xD0601D8EFC57B08Bu, 0xF13B94DAF124DA26u }, /* 1e-237 */
+    { 0x823C12795DB6CE57u, 0x76C53D08D6B70858u }, /* 1e-236 */
+    { 0xA2CB1717B52481EDu, 0x54768C4B0C64CA6Eu }, /* 1e-235 */
+    { 0xCB7DDCDDA26DA268u, 0xA9942F5DCF7DFD09u }, /* 1e-234 */
+    { 0xFE5D54150B090B02u, 0xD3F93B35435D7C4Cu }, /* 1e-233 */
+    { 0x9EFA548D26E5A6E1u, 0xC47BC5014A1A6DAFu }, /* 1e-232 */
+    { 0xC6B8E9B0709F109Au, 0x359AB6419CA1091Bu }, /* 1e-231 */
+    { 0xF867241C8CC6D4C0u, 0xC30163D203C94B62u }, /* 1e-230 */
+    { 0x9B407691D7FC44F8u, 0x79E0DE63425DCF1Du }, /* 1e-229 */
+    { 0xC21094364DFB5636u, 0x985915FC12F542E4u }, /* 1e-228 */
+    { 0xF294B943E17A2BC4u, 0x3E6F5B7B17B2939Du }, /* 1e-227 */
+    { 0x979CF3CA6CEC5B5Au, 0xA705992CEECF9C42u }, /* 1e-226 */
+    { 0xBD8430BD08277231u, 0x50C6FF782A838353u }, /* 1e-225 */
+    { 0xECE53CEC4A314EBDu, 0xA4F8BF5635246428u }, /* 1e-224 */
+    { 0x940F4613AE5ED136u, 0x871B7795E136BE99u }, /* 1e-223 */
+    { 0xB913179899F68584u, 0x28E2557B59846E3Fu }, /* 1e-222 */
+    { 0xE757DD7EC07426E5u, 0x331AEADA2FE589CFu }, /* 1e-221 */
+    { 0x9096EA6F3848984Fu, 0x3FF0D2C85DEF7621u }, /* 1e-220 */
+    { 0xB4BCA50B065ABE63u, 0x0FED077A756B53A9u }, /* 1e-219 */
+    { 0xE1EBCE4DC7F16DFBu, 0xD3E8495912C62894u }, /* 1e-218 */
+    { 0x8D3360F09CF6E4BDu, 0x64712DD7ABBBD95Cu }, /* 1e-217 */
+    { 0xB080392CC4349DECu, 0xBD8D794D96AACFB3u }, /* 1e-216 */
+    { 0xDCA04777F541C567u, 0xECF0D7A0FC5583A0u }, /* 1e-215 */
+    { 0x89E42CAAF9491B60u, 0xF41686C49DB57244u }, /* 1e-214 */
+    { 0xAC5D37D5B79B6239u, 0x311C2875C522CED5u }, /* 1e-213 */
+    { 0xD77485CB25823AC7u, 0x7D633293366B828Bu }, /* 1e-212 */
+    { 0x86A8D39EF77164BCu, 0xAE5DFF9C02033197u }, /* 1e-211 */
+    { 0xA8530886B54DBDEBu, 0xD9F57F830283FDFCu }, /* 1e-210 */
+    { 0xD267CAA862A12D66u, 0xD072DF63C324FD7Bu }, /* 1e-209 */
+    { 0x8380DEA93DA4BC60u, 0x4247CB9E59F71E6Du }, /* 1e-208 */
+    { 0xA46116538D0DEB78u, 0x52D9BE85F074E608u }, /* 1e-207 */
+    { 0xCD795BE870516656u, 0x67902E276C921F8Bu }, /* 1e-206 */
+    { 0x806BD9714632DFF6u, 0x00BA1CD8A3DB53B6u }, /* 1e-205 */
+    { 0xA086CFCD97BF97F3u, 0x80E8A40ECCD228A4u }, /* 1e-204 */
+    { 0xC8A883C0FDAF7DF0u, 0x6122CD128006B2CDu }, /* 1e-203 */
+    { 0xFAD2A4B13D1B5D6Cu, 0x796B805720085F81u }, /* 1e-202 */
+    { 0x9CC3A6EEC6311A63u, 0xCBE3303674053BB0u }, /* 1e-201 */
+    { 0xC3F490AA77BD60FCu, 0xBEDBFC4411068A9Cu }, /* 1e-200 */
+    { 0xF4F1B4D515ACB93Bu, 0xEE92FB5515482D44u }, /* 1e-199 */
+    { 0x991711052D8BF3C5u, 0x751BDD152D4D1C4Au }, /* 1e-198 */
+    { 0xBF5CD54678EEF0B6u, 0xD262D45A78A0635Du }, /* 1e-197 */
+    { 0xEF340A98172AACE4u, 0x86FB897116C87C34u }, /* 1e-196 */
+    { 0x9580869F0E7AAC0Eu, 0xD45D35E6AE3D4DA0u }, /* 1e-195 */
+    { 0xBAE0A846D2195712u, 0x8974836059CCA109u }, /* 1e-194 */
+    { 0xE998D258869FACD7u, 0x2BD1A438703FC94Bu }, /* 1e-193 */
+    { 0x91FF83775423CC06u, 0x7B6306A34627DDCFu }, /* 1e-192 */
+    { 0xB67F6455292CBF08u, 0x1A3BC84C17B1D542u }, /* 1e-191 */
+    { 0xE41F3D6A7377EECAu, 0x20CABA5F1D9E4A93u }, /* 1e-190 */
+    { 0x8E938662882AF53Eu, 0x547EB47B7282EE9Cu }, /* 1e-189 */
+    { 0xB23867FB2A35B28Du, 0xE99E619A4F23AA43u }, /* 1e-188 */
+    { 0xDEC681F9F4C31F31u, 0x6405FA00E2EC94D4u }, /* 1e-187 */
+    { 0x8B3C113C38F9F37Eu, 0xDE83BC408DD3DD04u }, /* 1e-186 */
+    { 0xAE0B158B4738705Eu, 0x9624AB50B148D445u }, /* 1e-185 */
+    { 0xD98DDAEE19068C76u, 0x3BADD624DD9B0957u }, /* 1e-184 */
+    { 0x87F8A8D4CFA417C9u, 0xE54CA5D70A80E5D6u }, /* 1e-183 */
+    { 0xA9F6D30A038D1DBCu, 0x5E9FCF4CCD211F4Cu }, /* 1e-182 */
+    { 0xD47487CC8470652Bu, 0x7647C3200069671Fu }, /* 1e-181 */
+    { 0x84C8D4DFD2C63F3Bu, 0x29ECD9F40041E073u }, /* 1e-180 */
+    { 0xA5FB0A17C777CF09u, 0xF468107100525890u }, /* 1e-179 */
+    { 0xCF79CC9DB955C2CCu, 0x7182148D4066EEB4u }, /* 1e-178 */
+    { 0x81AC1FE293D599BFu, 0xC6F14CD848405530u }, /* 1e-177 */
+    { 0xA21727DB38CB002Fu, 0xB8ADA00E5A506A7Cu }, /* 1e-176 */
+    { 0xCA9CF1D206FDC03Bu, 0xA6D90811F0E4851Cu }, /* 1e-175 */
+    { 0xFD442E4688BD304Au, 0x908F4A166D1DA663u }, /* 1e-174 */
+    { 0x9E4A9CEC15763E2Eu, 0x9A598E4E043287FEu }, /* 1e-173 */
+    { 0xC5DD44271AD3CDBAu, 0x40EFF1E1853F29FDu }, /* 1e-172 */
+    { 0xF7549530E188C128u, 0xD12BEE59E68EF47Cu }, /* 1e-171 */
+    { 0x9A94DD3E8CF578B9u, 0x82BB74F8301958CEu }, /* 1e-170 */
+    { 0xC13A148E3032D6E7u, 0xE36A52363C1FAF01u }, /* 1e-169 */
+    { 0xF18899B1BC3F8CA1u, 0xDC44E6C3CB279AC1u }, /* 1e-168 */
+    { 0x96F5600F15A7B7E5u, 0x29AB103A5EF8C0B9u }, /* 1e-167 */
+    { 0xBCB2B812DB11A5DEu, 0x7415D448F6B6F0E7u }, /* 1e-166 */
+    { 0xEBDF661791D60F56u, 0x111B495B3464AD21u }, /* 1e-165 */
+    { 0x936B9FCEBB25C995u, 0xCAB10DD900BEEC34u }, /* 1e-164 */
+    { 0xB84687C269EF3BFBu, 0x3D5D514F40EEA742u }, /* 1e-163 */
+    { 0xE65829B3046B0AFAu, 0x0CB4A5A3112A5112u }, /* 1e-162 */
+    { 0x8FF71A0FE2C2E6DCu, 0x47F0E785EABA72ABu }, /* 1e-161 */
+    { 0xB3F4E093DB73A093u, 0x59ED216765690F56u }, /* 1e-160 */
+    { 0xE0F218B8D25088B8u, 0x306869C13EC3532Cu }, /* 1e-159 */
+    { 0x8C974F7383725573u, 0x1E414218C73A13FBu }, /* 1e-158 */
+    { 0xAFBD2350644EEACFu, 0xE5D1929EF90898FAu }, /* 1e-157 */
+    { 0xDBAC6C247D62A583u, 0xDF45F746B74ABF39u }, /* 1e-156 */
+    { 0x894BC396CE5DA772u, 0x6B8BBA8C328EB783u }, /* 1e-155 */
+    { 0xAB9EB47C81F5114Fu, 0x066EA92F3F326564u }, /* 1e-154 */
+    { 0xD686619BA27255A2u, 0xC80A537B0EFEFEBDu }, /* 1e-153 */
+    { 0x8613FD0145877585u, 0xBD06742CE95F5F36u }, /* 1e-152 */
+    { 0xA798FC4196E952E7u, 0x2C48113823B73704u }, /* 1e-151 */
+    { 0xD17F3B51FCA3A7A0u, 0xF75A15862CA504C5u }, /* 1e-150 */
+    { 0x82EF85133DE648C4u, 0x9A984D73DBE722FBu }, /* 1e-149 */
+    { 0xA3AB66580D5FDAF5u, 0xC13E60D0D2E0EBBAu }, /* 1e-148 */
+    { 0xCC963FEE10B7D1B3u, 0x318DF905079926A8u }, /* 1e-147 */
+    { 0xFFBBCFE994E5C61Fu, 0xFDF17746497F7052u }, /* 1e-146 */
+    { 0x9FD561F1FD0F9BD3u, 0xFEB6EA8BEDEFA633u }, /* 1e-145 */
+    { 0xC7CABA6E7C5382C8u, 0xFE64A52EE96B8FC0u }, /* 1e-144 */
+    { 0xF9BD690A1B68637Bu, 0x3DFDCE7AA3C673B0u }, /* 1e-143 */
+    { 0x9C1661A651213E2Du, 0x06BEA10CA65C084Eu }, /* 1e-142 */
+    { 0xC31BFA0FE5698DB8u, 0x486E494FCFF30A62u }, /* 1e-141 */
+    { 0xF3E2F893DEC3F126u, 0x5A89DBA3C3EFCCFAu }, /* 1e-140 */
+    { 0x986DDB5C6B3A76B7u, 0xF89629465A75E01Cu }, /* 1e-139 */
+    { 0xBE89523386091465u, 0xF6BBB397F1135823u }, /* 1e-138 */
+    { 0xEE2BA6C0678B597Fu, 0x746AA07DED582E2Cu }, /* 1e-137 */
+    { 0x94DB483840B717EFu, 0xA8C2A44EB4571CDCu }, /* 1e-136 */
+    { 0xBA121A4650E4DDEBu, 0x92F34D62616CE413u }, /* 1e-135 */
+    { 0xE896A0D7E51E1566u, 0x77B020BAF9C81D17u }, /* 1e-134 */
+    { 0x915E2486EF32CD60u, 0x0ACE1474DC1D122Eu }, /* 1e-133 */
+    { 0xB5B5ADA8AAFF80B8u, 0x0D819992132456BAu }, /* 1e-132 */
+    { 0xE3231912D5BF60E6u, 0x10E1FFF697ED6C69u }, /* 1e-131 */
+    { 0x8DF5EFABC5979C8Fu, 0xCA8D3FFA1EF463C1u }, /* 1e-130 */
+    { 0xB1736B96B6FD83B3u, 0xBD308FF8A6B17CB2u }, /* 1e-129 */
+    { 0xDDD0467C64BCE4A0u, 0xAC7CB3F6D05DDBDEu }, /* 1e-128 */
+    { 0x8AA22C0DBEF60EE4u, 0x6BCDF07A423AA96Bu }, /* 1e-127 */
+    { 0xAD4AB7112EB3929Du, 0x86C16C98D2C953C6u }, /* 1e-126 */
+    { 0xD89D64D57A607744u, 0xE871C7BF077BA8B7u }, /* 1e-125 */
+    { 0x87625F056C7C4A8Bu, 0x11471CD764AD4972u }, /* 1e-124 */
+    { 0xA93AF6C6C79B5D2Du, 0xD598E40D3DD89BCFu }, /* 1e-123 */
+    { 0xD389B47879823479u, 0x4AFF1D108D4EC2C3u }, /* 1e-122 */
+    { 0x843610CB4BF160CBu, 0xCEDF722A585139BAu }, /* 1e-121 */
+    { 0xA54394FE1EEDB8FEu, 0xC2974EB4EE658828u }, /* 1e-120 */
+    { 0xCE947A3DA6A9273Eu, 0x733D226229FEEA32u }, /* 1e-119 */
+    { 0x811CCC668829B887u, 0x0806357D5A3F525Fu }, /* 1e-118 */
+    { 0xA163FF802A3426A8u, 0xCA07C2DCB0CF26F7u }, /* 1e-117 */
+    { 0xC9BCFF6034C13052u, 0xFC89B393DD02F0B5u }, /* 1e-116 */
+    { 0xFC2C3F3841F17C67u, 0xBBAC2078D443ACE2u }, /* 1e-115 */
+    { 0x9D9BA7832936EDC0u, 0xD54B944B84AA4C0Du }, /* 1e-114 */
+    { 0xC5029163F384A931u, 0x0A9E795E65D4DF11u }, /* 1e-113 */
+    { 0xF64335BCF065D37Du, 0x4D4617B5FF4A16D5u }, /* 1e-112 */
+    { 0x99EA0196163FA42Eu, 0x504BCED1BF8E4E45u }, /* 1e-111 */
+    { 0xC06481FB9BCF8D39u, 0xE45EC2862F71E1D6u }, /* 1e-110 */
+    { 0xF07DA27A82C37088u, 0x5D767327BB4E5A4Cu }, /* 1e-109 */
+    { 0x964E858C91BA2655u, 0x3A6A07F8D510F86Fu }, /* 1e-108 */
+    { 0xBBE226EFB628AFEAu, 0x890489F70A55368Bu }, /* 1e-107 */
+    { 0xEADAB0ABA3B2DBE5u, 0x2B45AC74CCEA842Eu }, /* 1e-106 */
+    { 0x92C8AE6B464FC96Fu, 0x3B0B8BC90012929Du }, /* 1e-105 */
+    { 0xB77ADA0617E3BBCBu, 0x09CE6EBB40173744u }, /* 1e-104 */
+    { 0xE55990879DDCAABDu, 0xCC420A6A101D0515u }, /* 1e-103 */
+    { 0x8F57FA54C2A9EAB6u, 0x9FA946824A12232Du }, /* 1e-102 */
+    { 0xB32DF8E9F3546564u, 0x47939822DC96ABF9u }, /* 1e-101 */
+    { 0xDFF9772470297EBDu, 0x59787E2B93BC56F7u }, /* 1e-100 */
+    { 0x8BFBEA76C619EF36u, 0x57EB4EDB3C55B65Au }, /* 1e-99 */
+    { 0xAEFAE51477A06B03u, 0xEDE622920B6B23F1u }, /* 1e-98 */
+    { 0xDAB99E59958885C4u, 0xE95FAB368E45ECEDu }, /* 1e-97 */
+    { 0x88B402F7FD75539Bu, 0x11DBCB0218EBB414u }, /* 1e-96 */
+    { 0xAAE103B5FCD2A881u, 0xD652BDC29F26A119u }, /* 1e-95 */
+    { 0xD59944A37C0752A2u, 0x4BE76D3346F0495Fu }, /* 1e-94 */
+    { 0x857FCAE62D8493A5u, 0x6F70A4400C562DDBu }, /* 1e-93 */
+    { 0xA6DFBD9FB8E5B88Eu, 0xCB4CCD500F6BB952u }, /* 1e-92 */
+    { 0xD097AD07A71F26B2u, 0x7E2000A41346A7A7u }, /* 1e-91 */
+    { 0x825ECC24C873782Fu, 0x8ED400668C0C28C8u }, /* 1e-90 */
+    { 0xA2F67F2DFA90563Bu, 0x728900802F0F32FAu }, /* 1e-89 */
+    { 0xCBB41EF979346BCAu, 0x4F2B40A03AD2FFB9u }, /* 1e-88 */
+    { 0xFEA126B7D78186BCu, 0xE2F610C84987BFA8u }, /* 1e-87 */
+    { 0x9F24B832E6B0F436u, 0x0DD9CA7D2DF4D7C9u }, /* 1e-86 */
+    { 0xC6EDE63FA05D3143u, 0x91503D1C79720DBBu }, /* 1e-85 */
+    { 0xF8A95FCF88747D94u, 0x75A44C6397CE912Au }, /* 1e-84 */
+    { 0x9B69DBE1B548CE7Cu, 0xC986AFBE3EE11ABAu }, /* 1e-83 */
+    { 0xC24452DA229B021Bu, 0xFBE85BADCE996168u }, /* 1e-82 */
+    { 0xF2D56790AB41C2A2u, 0xFAE27299423FB9C3u }, /* 1e-81 */
+    { 0x97C560BA6B0919A5u, 0xDCCD879FC967D41Au }, /* 1e-80 */
+    { 0xBDB6B8E905CB600Fu, 0x5400E987BBC1C920u }, /* 1e-79 */
+    { 0xED246723473E3813u, 0x290123E9AAB23B68u }, /* 1e-78 */
+    { 0x9436C0760C86E30Bu, 0xF9A0B6720AAF6521u }, /* 1e-77 */
+    { 0xB94470938FA89BCEu, 0xF808E40E8D5B3E69u }, /* 1e-76 */
+    { 0xE7958CB87392C2C2u, 0xB60B1D1230B20E04u }, /* 1e-75 */
+    { 0x90BD77F3483BB9B9u, 0xB1C6F22B5E6F48C2u }, /* 1e-74 */
+    { 0xB4ECD5F01A4AA828u, 0x1E38AEB6360B1AF3u }, /* 1e-73 */
+    { 0xE2280B6C20DD5232u, 0x25C6DA63C38DE1B0u }, /* 1e-72 */
+    { 0x8D590723948A535Fu, 0x579C487E5A38AD0Eu }, /* 1e-71 */
+    { 0xB0AF48EC79ACE837u, 0x2D835A9DF0C6D851u }, /* 1e-70 */
+    { 0xDCDB1B2798182244u, 0xF8E431456CF88E65u }, /* 1e-69 */
+    { 0x8A08F0F8BF0F156Bu, 0x1B8E9ECB641B58FFu }, /* 1e-68 */
+    { 0xAC8B2D36EED2DAC5u, 0xE272467E3D222F3Fu }, /* 1e-67 */
+    { 0xD7ADF884AA879177u, 0x5B0ED81DCC6ABB0Fu }, /* 1e-66 */
+    { 0x86CCBB52EA94BAEAu, 0x98E947129FC2B4E9u }, /* 1e-65 */
+    { 0xA87FEA27A539E9A5u, 0x3F2398D747B36224u }, /* 1e-64 */
+    { 0xD29FE4B18E88640Eu, 0x8EEC7F0D19A03AADu }, /* 1e-63 */
+    { 0x83A3EEEEF9153E89u, 0x1953CF68300424ACu }, /* 1e-62 */
+    { 0xA48CEAAAB75A8E2Bu, 0x5FA8C3423C052DD7u }, /* 1e-61 */
+    { 0xCDB02555653131B6u, 0x3792F412CB06794Du }, /* 1e-60 */
+    { 0x808E17555F3EBF11u, 0xE2BBD88BBEE40BD0u }, /* 1e-59 */
+    { 0xA0B19D2AB70E6ED6u, 0x5B6ACEAEAE9D0EC4u }, /* 1e-58 */
+    { 0xC8DE047564D20A8Bu, 0xF245825A5A445275u }, /* 1e-57 */
+    { 0xFB158592BE068D2Eu, 0xEED6E2F0F0D56712u }, /* 1e-56 */
+    { 0x9CED737BB6C4183Du, 0x55464DD69685606Bu }, /* 1e-55 */
+    { 0xC428D05AA4751E4Cu, 0xAA97E14C3C26B886u }, /* 1e-54 */
+    { 0xF53304714D9265DFu, 0xD53DD99F4B3066A8u }, /* 1e-53 */
+    { 0x993FE2C6D07B7FABu, 0xE546A8038EFE4029u }, /* 1e-52 */
+    { 0xBF8FDB78849A5F96u, 0xDE98520472BDD033u }, /* 1e-51 */
+    { 0xEF73D256A5C0F77Cu, 0x963E66858F6D4440u }, /* 1e-50 */
+    { 0x95A8637627989AADu, 0xDDE7001379A44AA8u }, /* 1e-49 */
+    { 0xBB127C53B17EC159u, 0x5560C018580D5D52u }, /* 1e-48 */
+    { 0xE9D71B689DDE71AFu, 0xAAB8F01E6E10B4A6u }, /* 1e-47 */
+    { 0x9226712162AB070Du, 0xCAB3961304CA70E8u }, /* 1e-46 */
+    { 0xB6B00D69BB55C8D1u, 0x3D607B97C5FD0D22u }, /* 1e-45 */
+    { 0xE45C10C42A2B3B05u, 0x8CB89A7DB77C506Au }, /* 1e-44 */
+    { 0x8EB98A7A9A5B04E3u, 0x77F3608E92ADB242u }, /* 1e-43 */
+    { 0xB267ED1940F1C61Cu, 0x55F038B237591ED3u }, /* 1e-42 */
+    { 0xDF01E85F912E37A3u, 0x6B6C46DEC52F6688u }, /* 1e-41 */
+    { 0x8B61313BBABCE2C6u, 0x2323AC4B3B3DA015u }, /* 1e-40 */
+    { 0xAE397D8AA96C1B77u, 0xABEC975E0A0D081Au }, /* 1e-39 */
+    { 0xD9C7DCED53C72255u, 0x96E7BD358C904A21u }, /* 1e-38 */
+    { 0x881CEA14545C7575u, 0x7E50D64177DA2E54u }, /* 1e-37 */
+    { 0xAA242499697392D2u, 0xDDE50BD1D5D0B9E9u }, /* 1e-36 */
+    { 0xD4AD2DBFC3D07787u, 0x955E4EC64B44E864u }, /* 1e-35 */
+    { 0x84EC3C97DA624AB4u, 0xBD5AF13BEF0B113Eu }, /* 1e-34 */
+    { 0xA6274BBDD0FADD61u, 0xECB1AD8AEACDD58Eu }, /* 1e-33 */
+    { 0xCFB11EAD453994BAu, 0x67DE18EDA5814AF2u }, /* 1e-32 */
+    { 0x81CEB32C4B43FCF4u, 0x80EACF948770CED7u }, /* 1e-31 */
+    { 0xA2425FF75E14FC31u, 0xA1258379A94D028Du }, /* 1e-30 */
+    { 0xCAD2F7F5359A3B3Eu, 0x096EE45813A04330u }, /* 1e-29 */
+    { 0xFD87B5F28300CA0Du, 0x8BCA9D6E188853FCu }, /* 1e-28 */
+    { 0x9E74D1B791E07E48u, 0x775EA264CF55347Du }, /* 1e-27 */
+    { 0xC612062576589DDAu, 0x95364AFE032A819Du }, /* 1e-26 */
+    { 0xF79687AED3EEC551u, 0x3A83DDBD83F52204u }, /* 1e-25 */
+    { 0x9ABE14CD44753B52u, 0xC4926A9672793542u }, /* 1e-24 */
+    { 0xC16D9A0095928A27u, 0x75B7053C0F178293u }, /* 1e-23 */
+    { 0xF1C90080BAF72CB1u, 0x5324C68B12DD6338u }, /* 1e-22 */
+    { 0x971DA05074DA7BEEu, 0xD3F6FC16EBCA5E03u }, /* 1e-21 */
+    { 0xBCE5086492111AEAu, 0x88F4BB1CA6BCF584u }, /* 1e-20 */
+    { 0xEC1E4A7DB69561A5u, 0x2B31E9E3D06C32E5u }, /* 1e-19 */
+    { 0x9392EE8E921D5D07u, 0x3AFF322E62439FCFu }, /* 1e-18 */
+    { 0xB877AA3236A4B449u, 0x09BEFEB9FAD487C2u }, /* 1e-17 */
+    { 0xE69594BEC44DE15Bu, 0x4C2EBE687989A9B3u }, /* 1e-16 */
+    { 0x901D7CF73AB0ACD9u, 0x0F9D37014BF60A10u }, /* 1e-15 */
+    { 0xB424DC35095CD80Fu, 0x538484C19EF38C94u }, /* 1e-14 */
+    { 0xE12E13424BB40E13u, 0x2865A5F206B06FB9u }, /* 1e-13 */
+    { 0x8CBCCC096F5088CBu, 0xF93F87B7442E45D3u }, /* 1e-12 */
+    { 0xAFEBFF0BCB24AAFEu, 0xF78F69A51539D748u }, /* 1e-11 */
+    { 0xDBE6FECEBDEDD5BEu, 0xB573440E5A884D1Bu }, /* 1e-10 */
+    { 0x89705F4136B4A597u, 0x31680A88F8953030u }, /* 1e-9 */
+    { 0xABCC77118461CEFCu, 0xFDC20D2B36BA7C3Du }, /* 1e-8 */
+    { 0xD6BF94D5E57A42BCu, 0x3D32907604691B4Cu }, /* 1e-7 */
+    { 0x8637BD05AF6C69B5u, 0xA63F9A49C2C1B10Fu }, /* 1e-6 */
+    { 0xA7C5AC471B478423u, 0x0FCF80DC33721D53u }, /* 1e-5 */
+    { 0xD1B71758E219652Bu, 0xD3C36113404EA4A8u }, /* 1e-4 */
+    { 0x83126E978D4FDF3Bu, 0x645A1CAC083126E9u }, /* 1e-3 */
+    { 0xA3D70A3D70A3D70Au, 0x3D70A3D70A3D70A3u }, /* 1e-2 */
+    { 0xCCCCCCCCCCCCCCCCu, 0xCCCCCCCCCCCCCCCCu }, /* 1e-1 */
+    { 0x8000000000000000u, 0x0000000000000000u }, /* 1e0 */
+    { 0xA000000000000000u, 0x0000000000000000u }, /* 1e1 */
+    { 0xC800000000000000u, 0x0000000000000000u }, /* 1e2 */
+    { 0xFA00000000000000u, 0x0000000000000000u }, /* 1e3 */
+    { 0x9C40000000000000u, 0x0000000000000000u }, /* 1e4 */
+    { 0xC350000000000000u, 0x0000000000000000u }, /* 1e5 */
+    { 0xF424000000000000u, 0x0000000000000000u }, /* 1e6 */
+    { 0x9896800000000000u, 0x0000000000000000u }, /* 1e7 */
+    { 0xBEBC200000000000u, 0x0000000000000000u }, /* 1e8 */
+    { 0xEE6B280000000000u, 0x0000000000000000u }, /* 1e9 */
+    { 0x9502F90000000000u, 0x0000000000000000u }, /* 1e10 */
+    { 0xBA43B74000000000u, 0x0000000000000000u }, /* 1e11 */
+    { 0xE8D4A51000000000u, 0x0000000000000000u }, /* 1e12 */
+    { 0x9184E72A00000000u, 0x0000000000000000u }, /* 1e13 */
+    { 0xB5E620F480000000u, 0x0000000000000000u }, /* 1e14 */
+    { 0xE35FA931A0000000u, 0x0000000000000000u }, /* 1e15 */
+    { 0x8E1BC9BF04000000u, 0x0000000000000000u }, /* 1e16 */
+    { 0xB1A2BC2EC5000000u, 0x0000000000000000u }, /* 1e17 */
+    { 0xDE0B6B3A76400000u, 0x0000000000000000u }, /* 1e18 */
+    { 0x8AC7230489E80000u, 0x0000000000000000u }, /* 1e19 */
+    { 0xAD78EBC5AC620000u, 0x0000000000000000u }, /* 1e20 */
+    { 0xD8D726B7177A8000u, 0x0000000000000000u }, /* 1e21 */
+    { 0x878678326EAC9000u, 0x0000000000000000u }, /* 1e22 */
+    { 0xA968163F0A57B400u, 0x0000000000000000u }, /* 1e23 */
+    { 0xD3C21BCECCEDA100u, 0x0000000000000000u }, /* 1e24 */
+    { 0x84595161401484A0u, 0x0000000000000000u }, /* 1e25 */
+    { 0xA56FA5B99019A5C8u, 0x0000000000000000u }, /* 1e26 */
+    { 0xCECB8F27F4200F3Au, 0x0000000000000000u }, /* 1e27 */
+    { 0x813F3978F8940984u, 0x4000000000000000u }, /* 1e28 */
+    { 0xA18F07D736B90BE5u, 0x5000000000000000u }, /* 1e29 */
+    { 0xC9F2C9CD04674EDEu, 0xA400000000000000u }, /* 1e30 */
+    { 0xFC6F7C4045812296u, 0x4D00000000000000u }, /* 1e31 */
+    { 0x9DC5ADA82B70B59Du, 0xF020000000000000u }, /* 1e32 */
+    { 0xC5371912364CE305u, 0x6C28000000000000u }, /* 1e33 */
+    { 0xF684DF56C3E01BC6u, 0xC732000000000000u }, /* 1e34 */
+    { 0x9A130B963A6C115Cu, 0x3C7F400000000000u }, /* 1e35 */
+    { 0xC097CE7BC90715B3u, 0x4B9F100000000000u }, /* 1e36 */
+    { 0xF0BDC21ABB48DB20u, 0x1E86D40000000000u }, /* 1e37 */
+    { 0x96769950B50D88F4u, 0x1314448000000000u }, /* 1e38 */
+    { 0xBC143FA4E250EB31u, 0x17D955A000000000u }, /* 1e39 */
+    { 0xEB194F8E1AE525FDu, 0x5DCFAB0800000000u }, /* 1e40 */
+    { 0x92EFD1B8D0CF37BEu, 0x5AA1CAE500000000u }, /* 1e41 */
+    { 0xB7ABC627050305ADu, 0xF14A3D9E40000000u }, /* 1e42 */
+    { 0xE596B7B0C643C719u, 0x6D9CCD05D0000000u }, /* 1e43 */
+    { 0x8F7E32CE7BEA5C6Fu, 0xE4820023A2000000u }, /* 1e44 */
+    { 0xB35DBF821AE4F38Bu, 0xDDA2802C8A800000u }, /* 1e45 */
+    { 0xE0352F62A19E306Eu, 0xD50B2037AD200000u }, /* 1e46 */
+    { 0x8C213D9DA502DE45u, 0x4526F422CC340000u }, /* 1e47 */
+    { 0xAF298D050E4395D6u, 0x9670B12B7F410000u }, /* 1e48 */
+    { 0xDAF3F04651D47B4Cu, 0x3C0CDD765F114000u }, /* 1e49 */
+    { 0x88D8762BF324CD0Fu, 0xA5880A69FB6AC800u }, /* 1e50 */
+    { 0xAB0E93B6EFEE0053u, 0x8EEA0D047A457A00u }, /* 1e51 */
+    { 0xD5D238A4ABE98068u, 0x72A4904598D6D880u }, /* 1e52 */
+    { 0x85A36366EB71F041u, 0x47A6DA2B7F864750u }, /* 1e53 */
+    { 0xA70C3C40A64E6C51u, 0x999090B65F67D924u }, /* 1e54 */
+    { 0xD0CF4B50CFE20765u, 0xFFF4B4E3F741CF6Du }, /* 1e55 */
+    { 0x82818F1281ED449Fu, 0xBFF8F10E7A8921A4u }, /* 1e56 */
+    { 0xA321F2D7226895C7u, 0xAFF72D52192B6A0Du }, /* 1e57 */
+    { 0xCBEA6F8CEB02BB39u, 0x9BF4F8A69F764490u }, /* 1e58 */
+    { 0xFEE50B7025C36A08u, 0x02F236D04753D5B4u }, /* 1e59 */
+    { 0x9F4F2726179A2245u, 0x01D762422C946590u }, /* 1e60 */
+    { 0xC722F0EF9D80AAD6u, 0x424D3AD2B7B97EF5u }, /* 1e61 */
+    { 0xF8EBAD2B84E0D58Bu, 0xD2E0898765A7DEB2u }, /* 1e62 */
+    { 0x9B934C3B330C8577u, 0x63CC55F49F88EB2Fu }, /* 1e63 */
+    { 0xC2781F49FFCFA6D5u, 0x3CBF6B71C76B25FBu }, /* 1e64 */
+    { 0xF316271C7FC3908Au, 0x8BEF464E3945EF7Au }, /* 1e65 */
+    { 0x97EDD871CFDA3A56u, 0x97758BF0E3CBB5ACu }, /* 1e66 */
+    { 0xBDE94E8E43D0C8ECu, 0x3D52EEED1CBEA317u }, /* 1e67 */
+    { 0xED63A231D4C4FB27u, 0x4CA7AAA863EE4BDDu }, /* 1e68 */
+    { 0x945E455F24FB1CF8u, 0x8FE8CAA93E74EF6Au }, /* 1e69 */
+    { 0xB975D6B6EE39E436u, 0xB3E2FD538E122B44u }, /* 1e70 */
+    { 0xE7D34C64A9C85D44u, 0x60DBBCA87196B616u }, /* 1e71 */
+    { 0x90E40FBEEA1D3A4Au, 0xBC8955E946FE31CDu }, /* 1e72 */
+    { 0xB51D13AEA4A488DDu, 0x6BABAB6398BDBE41u }, /* 1e73 */
+    { 0xE264589A4DCDAB14u, 0xC696963C7EED2DD1u }, /* 1e74 */
+    { 0x8D7EB76070A08AECu, 0xFC1E1DE5CF543CA2u }, /* 1e75 */
+    { 0xB0DE65388CC8ADA8u, 0x3B25A55F43294BCBu }, /* 1e76 */
+    { 0xDD15FE86AFFAD912u, 0x49EF0EB713F39EBEu }, /* 1e77 */
+    { 0x8A2DBF142DFCC7ABu, 0x6E3569326C784337u }, /* 1e78 */
+    { 0xACB92ED9397BF996u, 0x49C2C37F07965404u }, /* 1e79 */
+    { 0xD7E77A8F87DAF7FBu, 0xDC33745EC97BE906u }, /* 1e80 */
+    { 0x86F0AC99B4E8DAFDu, 0x69A028BB3DED71A3u }, /* 1e81 */
+    { 0xA8ACD7C0222311BCu, 0xC40832EA0D68CE0Cu }, /* 1e82 */
+    { 0xD2D80DB02AABD62Bu, 0xF50A3FA490C30190u }, /* 1e83 */
+    { 0x83C7088E1AAB65DBu, 0x792667C6DA79E0FAu }, /* 1e84 */
+    { 0xA4B8CAB1A1563F52u, 0x577001B891185938u }, /* 1e85 */
+    { 0xCDE6FD5E09ABCF26u, 0xED4C0226B55E6F86u }, /* 1e86 */
+    { 0x80B05E5AC60B6178u, 0x544F8158315B05B4u }, /* 1e87 */
+    { 0xA0DC75F1778E39D6u, 0x696361AE3DB1C721u }, /* 1e88 */
+    { 0xC913936DD571C84Cu, 0x03BC3A19CD1E38E9u }, /* 1e89 */
+    { 0xFB5878494ACE3A5Fu, 0x04AB48A04065C723u }, /* 1e90 */
+    { 0x9D174B2DCEC0E47Bu, 0x62EB0D64283F9C76u }, /* 1e91 */
+    { 0xC45D1DF942711D9Au, 0x3BA5D0BD324F8394u }, /* 1e92 */
+    { 0xF5746577930D6500u, 0xCA8F44EC7EE36479u }, /* 1e93 */
+    { 0x9968BF6ABBE85F20u, 0x7E998B13CF4E1ECBu }, /* 1e94 */
+    { 0xBFC2EF456AE276E8u, 0x9E3FEDD8C321A67Eu }, /* 1e95 */
+    { 0xEFB3AB16C59B14A2u, 0xC5CFE94EF3EA101Eu }, /* 1e96 */
+    { 0x95D04AEE3B80ECE5u, 0xBBA1F1D158724A12u }, /* 1e97 */
+    { 0xBB445DA9CA61281Fu, 0x2A8A6E45AE8EDC97u }, /* 1e98 */
+    { 0xEA1575143CF97226u, 0xF52D09D71A3293BDu }, /* 1e99 */
+    { 0x924D692CA61BE758u, 0x593C2626705F9C56u }, /* 1e100 */
+    { 0xB6E0C377CFA2E12Eu, 0x6F8B2FB00C77836Cu }, /* 1e101 */
+    { 0xE498F455C38B997Au, 0x0B6DFB9C0F956447u }, /* 1e102 */
+    { 0x8EDF98B59A373FECu, 0x4724BD4189BD5EACu }, /* 1e103 */
+    { 0xB2977EE300C50FE7u, 0x58EDEC91EC2CB657u }, /* 1e104 */
+    { 0xDF3D5E9BC0F653E1u, 0x2F2967B66737E3EDu }, /* 1e105 */
+    { 0x8B865B215899F46Cu, 0xBD79E0D20082EE74u }, /* 1e106 */
+    { 0xAE67F1E9AEC07187u, 0xECD8590680A3AA11u }, /* 1e107 */
+    { 0xDA01EE641A708DE9u, 0xE80E6F4820CC9495u }, /* 1e108 */
+    { 0x884134FE908658B2u, 0x3109058D147FDCDDu }, /* 1e109 */
+    { 0xAA51823E34A7EEDEu, 0xBD4B46F0599FD415u }, /* 1e110 */
+    { 0xD4E5E2CDC1D1EA96u, 0x6C9E18AC7007C91Au }, /* 1e111 */
+    { 0x850FADC09923329Eu, 0x03E2CF6BC604DDB0u }, /* 1e112 */
+    { 0xA6539930BF6BFF45u, 0x84DB8346B786151Cu }, /* 1e113 */
+    { 0xCFE87F7CEF46FF16u, 0xE612641865679A63u }, /* 1e114 */
+    { 0x81F14FAE158C5F6Eu, 0x4FCB7E8F3F60C07Eu }, /* 1e115 */
+    { 0xA26DA3999AEF7749u, 0xE3BE5E330F38F09Du }, /* 1e116 */
+    { 0xCB090C8001AB551Cu, 0x5CADF5BFD3072CC5u }, /* 1e117 */
+    { 0xFDCB4FA002162A63u, 0x73D9732FC7C8F7F6u }, /* 1e118 */
+    { 0x9E9F11C4014DDA7Eu, 0x2867E7FDDCDD9AFAu }, /* 1e119 */
+    { 0xC646D63501A1511Du, 0xB281E1FD541501B8u }, /* 1e120 */
+    { 0xF7D88BC24209A565u, 0x1F225A7CA91A4226u }, /* 1e121 */
+    { 0x9AE757596946075Fu, 0x3375788DE9B06958u }, /* 1e122 */
+    { 0xC1A12D2FC3978937u, 0x0052D6B1641C83AEu }, /* 1e123 */
+    { 0xF209787BB47D6B84u, 0xC0678C5DBD23A49Au }, /* 1e124 */
+    { 0x9745EB4D50CE6332u, 0xF840B7BA963646E0u }, /* 1e125 */
+    { 0xBD176620A501FBFFu, 0xB650E5A93BC3D898u }, /* 1e126 */
+    { 0xEC5D3FA8CE427AFFu, 0xA3E51F138AB4CEBEu }, /* 1e127 */
+    { 0x93BA47C980E98CDFu, 0xC66F336C36B10137u }, /* 1e128 */
+    { 0xB8A8D9BBE123F017u, 0xB80B0047445D4184u }, /* 1e129 */
+    { 0xE6D3102AD96CEC1Du, 0xA60DC059157491E5u }, /* 1e130 */
+    { 0x9043EA1AC7E41392u, 0x87C89837AD68DB2Fu }, /* 1e131 */
+    { 0xB454E4A179DD1877u, 0x29BABE4598C311FBu }, /* 1e132 */
+    { 0xE16A1DC9D8545E94u, 0xF4296DD6FEF3D67Au }, /* 1e133 */
+    { 0x8CE2529E2734BB1Du, 0x1899E4A65F58660Cu }, /* 1e134 */
+    { 0xB01AE745B101E9E4u, 0x5EC05DCFF72E7F8Fu }, /* 1e135 */
+    { 0xDC21A1171D42645Du, 0x76707543F4FA1F73u }, /* 1e136 */
+    { 0x899504AE72497EBAu, 0x6A06494A791C53A8u }, /* 1e137 */
+    { 0xABFA45DA0EDBDE69u, 0x0487DB9D17636892u }, /* 1e138 */
+    { 0xD6F8D7509292D603u, 0x45A9D2845D3C42B6u }, /* 1e139 */
+    { 0x865B86925B9BC5C2u, 0x0B8A2392BA45A9B2u }, /* 1e140 */
+    { 0xA7F26836F282B732u, 0x8E6CAC7768D7141Eu }, /* 1e141 */
+    { 0xD1EF0244AF2364FFu, 0x3207D795430CD926u }, /* 1e142 */
+    { 0x8335616AED761F1Fu, 0x7F44E6BD49E807B8u }, /* 1e143 */
+    { 0xA402B9C5A8D3A6E7u, 0x5F16206C9C6209A6u }, /* 1e144 */
+    { 0xCD036837130890A1u, 0x36DBA887C37A8C0Fu }, /* 1e145 */
+    { 0x802221226BE55A64u, 0xC2494954DA2C9789u }, /* 1e146 */
+    { 0xA02AA96B06DEB0FDu, 0xF2DB9BAA10B7BD6Cu }, /* 1e147 */
+    { 0xC83553C5C8965D3Du, 0x6F92829494E5ACC7u }, /* 1e148 */
+    { 0xFA42A8B73ABBF48Cu, 0xCB772339BA1F17F9u }, /* 1e149 */
+    { 0x9C69A97284B578D7u, 0xFF2A760414536EFBu }, /* 1e150 */
+    { 0xC38413CF25E2D70Du, 0xFEF5138519684ABAu }, /* 1e151 */
+    { 0xF46518C2EF5B8CD1u, 0x7EB258665FC25D69u }, /* 1e152 */
+    { 0x98BF2F79D5993802u, 0xEF2F773FFBD97A61u }, /* 1e153 */
+    { 0xBEEEFB584AFF8603u, 0xAAFB550FFACFD8FAu }, /* 1e154 */
+    { 0xEEAABA2E5DBF6784u, 0x95BA2A53F983CF38u }, /* 1e155 */
+    { 0x952AB45CFA97A0B2u, 0xDD945A747BF26183u }, /* 1e156 */
+    { 0xBA756174393D88DFu, 0x94F971119AEEF9E4u }, /* 1e157 */
+    { 0xE912B9D1478CEB17u, 0x7A37CD5601AAB85Du }, /* 1e158 */
+    { 0x91ABB422CCB812EEu, 0xAC62E055C10AB33Au }, /* 1e159 */
+    { 0xB616A12B7FE617AAu, 0x577B986B314D6009u }, /* 1e160 */
+    { 0xE39C49765FDF9D94u, 0xED5A7E85FDA0B80Bu }, /* 1e161 */
+    { 0x8E41ADE9FBEBC27Du, 0x14588F13BE847307u }, /* 1e162 */
+    { 0xB1D219647AE6B31Cu, 0x596EB2D8AE258FC8u }, /* 1e163 */
+    { 0xDE469FBD99A05FE3u, 0x6FCA5F8ED9AEF3BBu }, /* 1e164 */
+    { 0x8AEC23D680043BEEu, 0x25DE7BB9480D5854u }, /* 1e165 */
+    { 0xADA72CCC20054AE9u, 0xAF561AA79A10AE6Au }, /* 1e166 */
+    { 0xD910F7FF28069DA4u, 0x1B2BA1518094DA04u }, /* 1e167 */
+    { 0x87AA9AFF79042286u, 0x90FB44D2F05D0842u }, /* 1e168 */
+    { 0xA99541BF57452B28u, 0x353A1607AC744A53u }, /* 1e169 */
+    { 0xD3FA922F2D1675F2u, 0x42889B8997915CE8u }, /* 1e170 */
+    { 0x847C9B5D7C2E09B7u, 0x69956135FEBADA11u }, /* 1e171 */
+    { 0xA59BC234DB398C25u, 0x43FAB9837E699095u }, /* 1e172 */
+    { 0xCF02B2C21207EF2Eu, 0x94F967E45E03F4BBu }, /* 1e173 */
+    { 0x8161AFB94B44F57Du, 0x1D1BE0EEBAC278F5u }, /* 1e174 */
+    { 0xA1BA1BA79E1632DCu, 0x6462D92A69731732u }, /* 1e175 */
+    { 0xCA28A291859BBF93u, 0x7D7B8F7503CFDCFEu }, /* 1e176 */
+    { 0xFCB2CB35E702AF78u, 0x5CDA735244C3D43Eu }, /* 1e177 */
+    { 0x9DEFBF01B061ADABu, 0x3A0888136AFA64A7u }, /* 1e178 */
+    { 0xC56BAEC21C7A1916u, 0x088AAA1845B8FDD0u }, /* 1e179 */
+    { 0xF6C69A72A3989F5Bu, 0x8AAD549E57273D45u }, /* 1e180 */
+    { 0x9A3C2087A63F6399u, 0x36AC54E2F678864Bu }, /* 1e181 */
+    { 0xC0CB28A98FCF3C7Fu, 0x84576A1BB416A7DDu }, /* 1e182 */
+    { 0xF0FDF2D3F3C30B9Fu, 0x656D44A2A11C51D5u }, /* 1e183 */
+    { 0x969EB7C47859E743u, 0x9F644AE5A4B1B325u }, /* 1e184 */
+    { 0xBC4665B596706114u, 0x873D5D9F0DDE1FEEu }, /* 1e185 */
+    { 0xEB57FF22FC0C7959u, 0xA90CB506D155A7EAu }, /* 1e186 */
+    { 0x9316FF75DD87CBD8u, 0x09A7F12442D588F2u }, /* 1e187 */
+    { 0xB7DCBF5354E9BECEu, 0x0C11ED6D538AEB2Fu }, /* 1e188 */
+    { 0xE5D3EF282A242E81u, 0x8F1668C8A86DA5FAu }, /* 1e189 */
+    { 0x8FA475791A569D10u, 0xF96E017D694487BCu }, /* 1e190 */
+    { 0xB38D92D760EC4455u, 0x37C981DCC395A9ACu }, /* 1e191 */
+    { 0xE070F78D3927556Au, 0x85BBE253F47B1417u }, /* 1e192 */
+    { 0x8C469AB843B89562u, 0x93956D7478CCEC8Eu }, /* 1e193 */
+    { 0xAF58416654A6BABBu, 0x387AC8D1970027B2u }, /* 1e194 */
+    { 0xDB2E51BFE9D0696Au, 0x06997B05FCC0319Eu }, /* 1e195 */
+    { 0x88FCF317F22241E2u, 0x441FECE3BDF81F03u }, /* 1e196 */
+    { 0xAB3C2FDDEEAAD25Au, 0xD527E81CAD7626C3u }, /* 1e197 */
+    { 0xD60B3BD56A5586F1u, 0x8A71E223D8D3B074u }, /* 1e198 */
+    { 0x85C7056562757456u, 0xF6872D5667844E49u }, /* 1e199 */
+    { 0xA738C6BEBB12D16Cu, 0xB428F8AC016561DBu }, /* 1e200 */
+    { 0xD106F86E69D785C7u, 0xE13336D701BEBA52u }, /* 1e201 */
+    { 0x82A45B450226B39Cu, 0xECC0024661173473u }, /* 1e202 */
+    { 0xA34D721642B06084u, 0x27F002D7F95D0190u }, /* 1e203 */
+    { 0xCC20CE9BD35C78A5u, 0x31EC038DF7B441F4u }, /* 1e204 */
+    { 0xFF290242C83396CEu, 0x7E67047175A15271u }, /* 1e205 */
+    { 0x9F79A169BD203E41u, 0x0F0062C6E984D386u }, /* 1e206 */
+    { 0xC75809C42C684DD1u, 0x52C07B78A3E60868u }, /* 1e207 */
+    { 0xF92E0C3537826145u, 0xA7709A56CCDF8A82u }, /* 1e208 */
+    { 0x9BBCC7A142B17CCBu, 0x88A66076400BB691u }, /* 1e209 */
+    { 0xC2ABF989935DDBFEu, 0x6ACFF893D00EA435u }, /* 1e210 */
+    { 0xF356F7EBF83552FEu, 0x0583F6B8C4124D43u }, /* 1e211 */
+    { 0x98165AF37B2153DEu, 0xC3727A337A8B704Au }, /* 1e212 */
+    { 0xBE1BF1B059E9A8D6u, 0x744F18C0592E4C5Cu }, /* 1e213 */
+    { 0xEDA2EE1C7064130Cu, 0x1162DEF06F79DF73u }, /* 1e214 */
+    { 0x9485D4D1C63E8BE7u, 0x8ADDCB5645AC2BA8u }, /* 1e215 */
+    { 0xB9A74A0637CE2EE1u, 0x6D953E2BD7173692u }, /* 1e216 */
+    { 0xE8111C87C5C1BA99u, 0xC8FA8DB6CCDD0437u }, /* 1e217 */
+    { 0x910AB1D4DB9914A0u, 0x1D9C9892400A22A2u }, /* 1e218 */
+    { 0xB54D5E4A127F59C8u, 0x2503BEB6D00CAB4Bu }, /* 1e219 */
+    { 0xE2A0B5DC971F303Au, 0x2E44AE64840FD61Du }, /* 1e220 */
+    { 0x8DA471A9DE737E24u, 0x5CEAECFED289E5D2u }, /* 1e221 */
+    { 0xB10D8E1456105DADu, 0x7425A83E872C5F47u }, /* 1e222 */
+    { 0xDD50F1996B947518u, 0xD12F124E28F77719u }, /* 1e223 */
+    { 0x8A5296FFE33CC92Fu, 0x82BD6B70D99AAA6Fu }, /* 1e224 */
+    { 0xACE73CBFDC0BFB7Bu, 0x636CC64D1001550Bu }, /* 1e225 */
+    { 0xD8210BEFD30EFA5Au, 0x3C47F7E05401AA4Eu }, /* 1e226 */
+    { 0x8714A775E3E95C78u, 0x65ACFAEC34810A71u }, /* 1e227 */
+    { 0xA8D9D1535CE3B396u, 0x7F1839A741A14D0Du }, /* 1e228 */
+    { 0xD31045A8341CA07Cu, 0x1EDE48111209A050u }, /* 1e229 */
+    { 0x83EA2B892091E44Du, 0x934AED0AAB460432u }, /* 1e230 */
+    { 0xA4E4B66B68B65D60u, 0xF81DA84D5617853Fu }, /* 1e231 */
+    { 0xCE1DE40642E3F4B9u, 0x36251260AB9D668Eu }, /* 1e232 */
+    { 0x80D2AE83E9CE78F3u, 0xC1D72B7C6B426019u }, /* 1e233 */
+    { 0xA1075A24E4421730u, 0xB24CF65B8612F81Fu }, /* 1e234 */
+    { 0xC94930AE1D529CFCu, 0xDEE033F26797B627u }, /* 1e235 */
+    { 0xFB9B7CD9A4A7443Cu, 0x169840EF017DA3B1u }, /* 1e236 */
+    { 0x9D412E0806E88AA5u, 0x8E1F289560EE864Eu }, /* 1e237 */
+    { 0xC491798A08A2AD4Eu, 0xF1A6F2BAB92A27E2u }, /* 1e238 */
+    { 0xF5B5D7EC8ACB58A2u, 0xAE10AF696774B1DBu }, /* 1e239 */
+    { 0x9991A6F3D6BF1765u, 0xACCA6DA1E0A8EF29u }, /* 1e240 */
+    { 0xBFF610B0CC6EDD3Fu, 0x17FD090A58D32AF3u }, /* 1e241 */
+    { 0xEFF394DCFF8A948Eu, 0xDDFC4B4CEF07F5B0u }, /* 1e242 */
+    { 0x95F83D0A1FB69CD9u, 0x4ABDAF101564F98Eu }, /* 1e243 */
+    { 0xBB764C4CA7A4440Fu, 0x9D6D1AD41ABE37F1u }, /* 1e244 */
+    { 0xEA53DF5FD18D5513u, 0x84C86189216DC5EDu }, /* 1e245 */
+    { 0x92746B9BE2F8552Cu, 0x32FD3CF5B4E49BB4u }, /* 1e246 */
+    { 0xB7118682DBB66A77u, 0x3FBC8C33221DC2A1u }, /* 1e247 */
+    { 0xE4D5E82392A40515u, 0x0FABAF3FEAA5334Au }, /* 1e248 */
+    { 0x8F05B1163BA6832Du, 0x29CB4D87F2A7400Eu }, /* 1e249 */
+    { 0xB2C71D5BCA9023F8u, 0x743E20E9EF511012u }, /* 1e250 */
+    { 0xDF78E4B2BD342CF6u, 0x914DA9246B255416u }, /* 1e251 */
+    { 0x8BAB8EEFB6409C1Au, 0x1AD089B6C2F7548Eu }, /* 1e252 */
+    { 0xAE9672ABA3D0C320u, 0xA184AC2473B529B1u }, /* 1e253 */
+    { 0xDA3C0F568CC4F3E8u, 0xC9E5D72D90A2741Eu }, /* 1e254 */
+    { 0x8865899617FB1871u, 0x7E2FA67C7A658892u }, /* 1e255 */
+    { 0xAA7EEBFB9DF9DE8Du, 0xDDBB901B98FEEAB7u }, /* 1e256 */
+    { 0xD51EA6FA85785631u, 0x552A74227F3EA565u }, /* 1e257 */
+    { 0x8533285C936B35DEu, 0xD53A88958F87275Fu }, /* 1e258 */
+    { 0xA67FF273B8460356u, 0x8A892ABAF368F137u }, /* 1e259 */
+    { 0xD01FEF10A657842Cu, 0x2D2B7569B0432D85u }, /* 1e260 */
+    { 0x8213F56A67F6B29Bu, 0x9C3B29620E29FC73u }, /* 1e261 */
+    { 0xA298F2C501F45F42u, 0x8349F3BA91B47B8Fu }, /* 1e262 */
+    { 0xCB3F2F7642717713u, 0x241C70A936219A73u }, /* 1e263 */
+    { 0xFE0EFB53D30DD4D7u, 0xED238CD383AA0110u }, /* 1e264 */
+    { 0x9EC95D1463E8A506u, 0xF4363804324A40AAu }, /* 1e265 */
+    { 0xC67BB4597CE2CE48u, 0xB143C6053EDCD0D5u }, /* 1e266 */
+    { 0xF81AA16FDC1B81DAu, 0xDD94B7868E94050Au }, /* 1e267 */
+    { 0x9B10A4E5E9913128u, 0xCA7CF2B4191C8326u }, /* 1e268 */
+    { 0xC1D4CE1F63F57D72u, 0xFD1C2F611F63A3F0u }, /* 1e269 */
+    { 0xF24A01A73CF2DCCFu, 0xBC633B39673C8CECu }, /* 1e270 */
+    { 0x976E41088617CA01u, 0xD5BE0503E085D813u }, /* 1e271 */
+    { 0xBD49D14AA79DBC82u, 0x4B2D8644D8A74E18u }, /* 1e272 */
+    { 0xEC9C459D51852BA2u, 0xDDF8E7D60ED1219Eu }, /* 1e273 */
+    { 0x93E1AB8252F33B45u, 0xCABB90E5C942B503u }, /* 1e274 */
+    { 0xB8DA1662E7B00A17u, 0x3D6A751F3B936243u }, /* 1e275 */
+    { 0xE7109BFBA19C0C9Du, 0x0CC512670A783AD4u }, /* 1e276 */
+    { 0x906A617D450187E2u, 0x27FB2B80668B24C5u }, /* 1e277 */
+    { 0xB484F9DC9641E9DAu, 0xB1F9F660802DEDF6u }, /* 1e278 */
+    { 0xE1A63853BBD26451u, 0x5E7873F8A0396973u }, /* 1e279 */
+    { 0x8D07E33455637EB2u, 0xDB0B487B6423E1E8u }, /* 1e280 */
+    { 0xB049DC016ABC5E5Fu, 0x91CE1A9A3D2CDA62u }, /* 1e281 */
+    { 0xDC5C5301C56B75F7u, 0x7641A140CC7810FBu }, /* 1e282 */
+    { 0x89B9B3E11B6329BAu, 0xA9E904C87FCB0A9Du }, /* 1e283 */
+    { 0xAC2820D9623BF429u, 0x546345FA9FBDCD44u }, /* 1e284 */
+    { 0xD732290FBACAF133u, 0xA97C177947AD4095u }, /* 1e285 */
+    { 0x867F59A9D4BED6C0u, 0x49ED8EABCCCC485Du }, /* 1e286 */
+    { 0xA81F301449EE8C70u, 0x5C68F256BFFF5A74u }, /* 1e287 */
+    { 0xD226FC195C6A2F8Cu, 0x73832EEC6FFF3111u }, /* 1e288 */
+    { 0x83585D8FD9C25DB7u, 0xC831FD53C5FF7EABu }, /* 1e289 */
+    { 0xA42E74F3D032F525u, 0xBA3E7CA8B77F5E55u }, /* 1e290 */
+    { 0xCD3A1230C43FB26Fu, 0x28CE1BD2E55F35EBu }, /* 1e291 */
+    { 0x80444B5E7AA7CF85u, 0x7980D163CF5B81B3u }, /* 1e292 */
+    { 0xA0555E361951C366u, 0xD7E105BCC332621Fu }, /* 1e293 */
+    { 0xC86AB5C39FA63440u, 0x8DD9472BF3FEFAA7u }, /* 1e294 */
+    { 0xFA856334878FC150u, 0xB14F98F6F0FEB951u }, /* 1e295 */
+    { 0x9C935E00D4B9D8D2u, 0x6ED1BF9A569F33D3u }, /* 1e296 */
+    { 0xC3B8358109E84F07u, 0x0A862F80EC4700C8u }, /* 1e297 */
+    { 0xF4A642E14C6262C8u, 0xCD27BB612758C0FAu }, /* 1e298 */
+    { 0x98E7E9CCCFBD7DBDu, 0x8038D51CB897789Cu }, /* 1e299 */
+    { 0xBF21E44003ACDD2Cu, 0xE0470A63E6BD56C3u }, /* 1e300 */
+    { 0xEEEA5D5004981478u, 0x1858CCFCE06CAC74u }, /* 1e301 */
+    { 0x95527A5202DF0CCBu, 0x0F37801E0C43EBC8u }, /* 1e302 */
+    { 0xBAA718E68396CFFDu, 0xD30560258F54E6BAu }, /* 1e303 */
+    { 0xE950DF20247C83FDu, 0x47C6B82EF32A2069u }, /* 1e304 */
+    { 0x91D28B7416CDD27Eu, 0x4CDC331D57FA5441u }, /* 1e305 */
+    { 0xB6472E511C81471Du, 0xE0133FE4ADF8E952u }, /* 1e306 */
+    { 0xE3D8F9E563A198E5u, 0x58180FDDD97723A6u }, /* 1e307 */
+    { 0x8E679C2F5E44FF8Fu, 0x570F09EAA7EA7648u }, /* 1e308 */
+    { 0xB201833B35D63F73u, 0x2CD2CC6551E513DAu }, /* 1e309 */
+    { 0xDE81E40A034BCF4Fu, 0xF8077F7EA65E58D1u }, /* 1e310 */
+    { 0x8B112E86420F6191u, 0xFB04AFAF27FAF782u }, /* 1e311 */
+    { 0xADD57A27D29339F6u, 0x79C5DB9AF1F9B563u }, /* 1e312 */
+    { 0xD94AD8B1C7380874u, 0x18375281AE7822BCu }, /* 1e313 */
+    { 0x87CEC76F1C830548u, 0x8F2293910D0B15B5u }, /* 1e314 */
+    { 0xA9C2794AE3A3C69Au, 0xB2EB3875504DDB22u }, /* 1e315 */
+    { 0xD433179D9C8CB841u, 0x5FA60692A46151EBu }, /* 1e316 */
+    { 0x849FEEC281D7F328u, 0xDBC7C41BA6BCD333u }, /* 1e317 */
+    { 0xA5C7EA73224DEFF3u, 0x12B9B522906C0800u }, /* 1e318 */
+    { 0xCF39E50FEAE16BEFu, 0xD768226B34870A00u }, /* 1e319 */
+    { 0x81842F29F2CCE375u, 0xE6A1158300D46640u }, /* 1e320 */
+    { 0xA1E53AF46F801C53u, 0x60495AE3C1097FD0u }, /* 1e321 */
+    { 0xCA5E89B18B602368u, 0x385BB19CB14BDFC4u }, /* 1e322 */
+    { 0xFCF62C1DEE382C42u, 0x46729E03DD9ED7B5u }, /* 1e323 */
+    { 0x9E19DB92B4E31BA9u, 0x6C07A2C26A8346D1u }, /* 1e324 */
+    { 0xC5A05277621BE293u, 0xC7098B7305241885u }, /* 1e325 */
+    { 0xF70867153AA2DB38u, 0xB8CBEE4FC66D1EA7u }, /* 1e326 */
+    { 0x9A65406D44A5C903u, 0x737F74F1DC043328u }, /* 1e327 */
+    { 0xC0FE908895CF3B44u, 0x505F522E53053FF2u }, /* 1e328 */
+    { 0xF13E34AABB430A15u, 0x647726B9E7C68FEFu }, /* 1e329 */
+    { 0x96C6E0EAB509E64Du, 0x5ECA783430DC19F5u }, /* 1e330 */
+    { 0xBC789925624C5FE0u, 0xB67D16413D132072u }, /* 1e331 */
+    { 0xEB96BF6EBADF77D8u, 0xE41C5BD18C57E88Fu }, /* 1e332 */
+    { 0x933E37A534CBAAE7u, 0x8E91B962F7B6F159u }, /* 1e333 */
+    { 0xB80DC58E81FE95A1u, 0x723627BBB5A4ADB0u }, /* 1e334 */
+    { 0xE61136F2227E3B09u, 0xCEC3B1AAA30DD91Cu }, /* 1e335 */
+    { 0x8FCAC257558EE4E6u, 0x213A4F0AA5E8A7B1u }, /* 1e336 */
+    { 0xB3BD72ED2AF29E1Fu, 0xA988E2CD4F62D19Du }, /* 1e337 */
+    { 0xE0ACCFA875AF45A7u, 0x93EB1B80A33B8605u }, /* 1e338 */
+    { 0x8C6C01C9498D8B88u, 0xBC72F130660533C3u }, /* 1e339 */
+    { 0xAF87023B9BF0EE6Au, 0xEB8FAD7C7F8680B4u }, /* 1e340 */
+    { 0xDB68C2CA82ED2A05u, 0xA67398DB9F6820E1u }, /* 1e341 */
+    { 0x892179BE91D43A43u, 0x88083F8943A1148Cu }, /* 1e342 */
+    { 0xAB69D82E364948D4u, 0x6A0A4F6B948959B0u }, /* 1e343 */
+    { 0xD6444E39C3DB9B09u, 0x848CE34679ABB01Cu }, /* 1e344 */
+    { 0x85EAB0E41A6940E5u, 0xF2D80E0C0C0B4E11u }, /* 1e345 */
+    { 0xA7655D1D2103911Fu, 0x6F8E118F0F0E2195u }, /* 1e346 */
+    { 0xD13EB46469447567u, 0x4B7195F2D2D1A9FBu }  /* 1e347 */
+};
+
+/* powers of ten that are exactly representable in a double */
+static const double exact_powers_of_ten[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
 
-    return item;
+/* 64 bit x 64 bit -> 128 bit multiplication */
+static void multiply_u64(uint64_t a, uint64_t b, uint64_t *high, uint64_t *low)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (uint64_t)(product >> 64);
+    *low = (uint64_t)product;
+#else
+    uint64_t a_low = a & 0xFFFFFFFFu;
+    uint64_t a_high = a >> 32;
+    uint64_t b_low = b & 0xFFFFFFFFu;
+    uint64_t b_high = b >> 32;
+    uint64_t low_low = a_low * b_low;
+    uint64_t high_low = a_high * b_low;
+    uint64_t low_high = a_low * b_high;
+    uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFFu) + low_high;
+
+    *high = (a_high * b_high) + (high_low >> 32) + (middle >> 32);
+    *low = (middle << 32) | (low_low & 0xFFFFFFFFu);
+#endif
+}
 
-fail:
-    if (item != NULL)
-    {
-        cJSON_Delete(item);
-    }
+static int count_leading_zeros(uint64_t value)
+{
+    int count = 0;
 
-    if (value != NULL)
+    while (!(value & ((uint64_t)1 << 63)))
     {
-        error local_error;
-        local_error.json = (const unsigned char*)value;
-        local_error.position = 0;
-
-        if (buffer.offset < buffer.length)
-        {
-            local_error.position = buffer.offset;
-        }
-        else if (buffer.length > 0)
-        {
-            local_error.position = buffer.length - 1;
-        }
-
-        if (return_parse_end != NULL)
-        {
-            *return_parse_end = (const char*)local_error.json + local_error.position;
-        }
-
-        global_error = local_error;
+        value <<= 1;
+        count++;
     }
 
-    return NULL;
+    return count;
 }
 
-/* Default options for cJSON_Parse */
-CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+static double double_from_bits(uint64_t bits)
 {
-    return cJSON_ParseWithOpts(value, 0, 0);
+    double value = 0;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+static uint64_t bits_from_double(double value)
 {
-    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
 }
 
-#define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
-
-static unsigned char *print(const cJSON * const item, cJSON_bool format, const internal_hooks * const hooks)
+/* Convert mantissa * 10^exponent10 to the nearest double with the Eisel-Lemire algorithm.
+ * Returns false if the result can't be decided this way (subnormals, overflow, exact halfway cases). */
+static cJSON_bool eisel_lemire(uint64_t mantissa, int exponent10, cJSON_bool negative, double *result)
 {
-    static const size_t default_buffer_size = 256;
-    printbuffer buffer[1];
-    unsigned char *printed = NULL;
+    const uint64_t *power = NULL;
+    uint64_t high = 0;
+    uint64_t low = 0;
+    uint64_t result_mantissa = 0;
+    uint64_t result_exponent = 0;
+    uint64_t most_significant_bit = 0;
+    int leading_zeros = 0;
 
-    memset(buffer, 0, sizeof(buffer));
-
-    /* create buffer */
-    buffer->buffer = (unsigned char*) hooks->allocate(default_buffer_size);
-    buffer->length = default_buffer_size;
-    buffer->format = format;
-    buffer->hooks = *hooks;
-    if (buffer->buffer == NULL)
+    if ((exponent10 < POWER_OF_TEN_MIN_EXPONENT) || (exponent10 > POWER_OF_TEN_MAX_EXPONENT) || (mantissa == 0))
     {
-        goto fail;
+        return false;
     }
+    power = power_of_ten_table[exponent10 - POWER_OF_TEN_MIN_EXPONENT];
 
-    /* print the value */
-    if (!print_value(item, buffer))
-    {
-        goto fail;
-    }
-    update_offset(buffer);
+    /* normalization */
+    leading_zeros = count_leading_zeros(mantissa);
+    mantissa <<= leading_zeros;
+    /* (217706 * exponent10) >> 16 is floor(log2(10^exponent10)) */
+    result_exponent = (uint64_t)((((217706 * exponent10) >> 16) + 64 + 1023) - leading_zeros);
 
-    /* check if reallocate is available */
-    if (hooks->reallocate != NULL)
+    multiply_u64(mantissa, power[0], &high, &low);
+
+    /* the truncated product might be off in the bits that decide rounding, use the lower half of the power as well */
+    if (((high & 0x1FF) == 0x1FF) && ((low + mantissa) < mantissa))
     {
-        printed = (unsigned char*) hooks->reallocate(buffer->buffer, buffer->offset + 1);
-        if (printed == NULL) {
-            goto fail;
+        uint64_t second_high = 0;
+        uint64_t second_low = 0;
+        uint64_t merged_high = high;
+        uint64_t merged_low = 0;
+
+        multiply_u64(mantissa, power[1], &second_high, &second_low);
+        merged_low = low + second_high;
+        if (merged_low < low)
+        {
+            merged_high++;
         }
-        buffer->buffer = NULL;
-    }
-    else /* otherwise copy the JSON over to a new buffer */
-    {
-        printed = (unsigned char*) hooks->allocate(buffer->offset + 1);
-        if (printed == NULL)
+        if (((merged_high & 0x1FF) == 0x1FF) && ((merged_low + 1) == 0) && ((second_low + mantissa) < mantissa))
         {
-            goto fail;
+            return false;
         }
-        memcpy(printed, buffer->buffer, cjson_min(buffer->length, buffer->offset + 1));
-        printed[buffer->offset] = '\0'; /* just to be sure */
-
-        /* free the buffer */
-        hooks->deallocate(buffer->buffer);
-        buffer->buffer = NULL;
+        high = merged_high;
+        low = merged_low;
     }
 
-    return printed;
+    /* shift to 54 bits */
+    most_significant_bit = high >> 63;
+    result_mantissa = high >> (most_significant_bit + 9);
+    result_exponent -= 1 ^ most_significant_bit;
 
-fail:
-    if (buffer->buffer != NULL)
+    /* exactly halfway between two doubles */
+    if ((low == 0) && ((high & 0x1FF) == 0) && ((result_mantissa & 3) == 1))
     {
-        hooks->deallocate(buffer->buffer);
-        buffer->buffer = NULL;
+        return false;
     }
 
-    if (printed != NULL)
+    /* round to 53 bits */
+    result_mantissa += result_mantissa & 1;
+    result_mantissa >>= 1;
+    if ((result_mantissa >> 53) > 0)
     {
-        hooks->deallocate(printed);
-        printed = NULL;
+        result_mantissa >>= 1;
+        result_exponent++;
     }
 
-    return NULL;
-}
+    /* subnormal, infinity or NaN */
+    if ((result_exponent - 1) >= (0x7FF - 1))
+    {
+        return false;
+    }
 
-/* Render a cJSON item/entity/structure to text. */
-CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item)
-{
-    return (char*)print(item, true, &global_hooks);
+    *result = double_from_bits((result_exponent << 52) | (result_mantissa & 0x000FFFFFFFFFFFFFu) | (negative ? ((uint64_t)1 << 63) : 0));
+    return true;
 }
 
-CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item)
+/* get the decimal point character of the current locale */
+static unsigned char get_decimal_point(void)
 {
-    return (char*)print(item, false, &global_hooks);
+#ifdef ENABLE_LOCALES
+    struct lconv *lconv = localeconv();
+    return (unsigned char) lconv->decimal_point[0];
+#else
+    return '.';
+#endif
 }
 
-CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt)
+/* Exact conversion through strtod for the numbers the fast paths can't decide. */
+static cJSON_bool parse_number_slow(const unsigned char * const number, size_t length, const internal_hooks * const hooks, double *result)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
-
-    if (prebuffer < 0)
-    {
-        return NULL;
-    }
+    unsigned char *number_c_string = NULL;
+    unsigned char *after_end = NULL;
+    size_t i = 0;
 
-    p.buffer = (unsigned char*)global_hooks.allocate((size_t)prebuffer);
-    if (!p.buffer)
+    /* malloc for temporary buffer, add 1 for '\0' */
+    number_c_string = (unsigned char *) hooks->allocate(length + 1);
+    if (number_c_string == NULL)
     {
-        return NULL;
+        return false; /* allocation failure */
     }
 
-    p.length = (size_t)prebuffer;
-    p.offset = 0;
-    p.noalloc = false;
-    p.format = fmt;
-    p.hooks = global_hooks;
+    memcpy(number_c_string, number, length);
+    number_c_string[length] = '\0';
 
-    if (!print_value(item, &p))
+    for (i = 0; i < length; i++)
     {
-        global_hooks.deallocate(p.buffer);
-        p.buffer = NULL;
-        return NULL;
+        if (number_c_string[i] == '.')
+        {
+            /* replace '.' with the decimal point of the current locale (for strtod) */
+            number_c_string[i] = get_decimal_point();
+        }
     }
 
-    return (char*)p.buffer;
+    *result = strtod((const char*)number_c_string, (char**)&after_end);
+    i = (size_t)(after_end - number_c_string);
+    hooks->deallocate(number_c_string);
+
+    return i == length;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format)
+typedef struct
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
-
-    if ((length < 0) || (buffer == NULL))
-    {
-        return false;
-    }
-
-    p.buffer = (unsigned char*)buffer;
-    p.length = (size_t)length;
-    p.offset = 0;
-    p.noalloc = true;
-    p.format = format;
-    p.hooks = global_hooks;
+    const unsigned char *content;
+    size_t length;
+    size_t offset;
+    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
+    internal_hooks hooks;
+    cJSON_bool in_situ; /* strings are unescaped inside of content, which is writable */
+    intern_table *keys; /* if not NULL, object keys are interned here */
+} parse_buffer;
 
-    return print_value(item, &p);
-}
+/* check if the given size is left to read in a given parse buffer (starting with 1) */
+#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
+/* check if the buffer can be accessed at the given index (starting with 0) */
+#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
+#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
+/* get a pointer to the buffer at the position */
+#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
 
-/* Parser core - when encountering text, process appropriately. */
-static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
+/* Parse the input text to generate a number, and populate the result into item. */
+static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
 {
+    double number = 0;
+    const unsigned char *number_start = NULL;
+    const unsigned char *pointer = NULL;
+    const unsigned char *end = NULL;
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    int exponent10 = 0;
+    cJSON_bool negative = false;
+    cJSON_bool truncated = false;
+    cJSON_bool has_digits = false;
+
     if ((input_buffer == NULL) || (input_buffer->content == NULL))
     {
-        return false; /* no input */
+        return false;
     }
 
-    /* parse the different types of values */
-    /* null */
-    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
+    number_start = buffer_at_offset(input_buffer);
+    pointer = number_start;
+    end = input_buffer->content + input_buffer->length;
+
+    /* accumulate up to 19 significant digits (they always fit into 64 bits), count the rest in the exponent */
+    if ((pointer < end) && (*pointer == '-'))
     {
-        item->type = cJSON_NULL;
-        input_buffer->offset += 4;
-        return true;
+        negative = true;
+        pointer++;
     }
-    /* false */
-    if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
+    for (; (pointer < end) && (*pointer >= '0') && (*pointer <= '9'); pointer++)
     {
-        item->type = cJSON_False;
-        input_buffer->offset += 5;
-        return true;
+        has_digits = true;
+        if (significant_digits < 19)
+        {
+            mantissa = (mantissa * 10) + (uint64_t)(*pointer - '0');
+            if (mantissa != 0)
+            {
+                significant_digits++;
+            }
+        }
+        else
+        {
+            truncated = truncated || (*pointer != '0');
+            exponent10++;
+        }
     }
-    /* true */
-    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
+    if ((pointer < end) && (*pointer == '.'))
     {
-        item->type = cJSON_True;
-        item->valueint = 1;
-        input_buffer->offset += 4;
-        return true;
+        for (pointer++; (pointer < end) && (*pointer >= '0') && (*pointer <= '9'); pointer++)
+        {
+            has_digits = true;
+            if (significant_digits < 19)
+            {
+                mantissa = (mantissa * 10) + (uint64_t)(*pointer - '0');
+                if (mantissa != 0)
+                {
+                    significant_digits++;
+                }
+                exponent10--;
+            }
+            else
+            {
+                truncated = truncated || (*pointer != '0');
+            }
+        }
     }
-    /* string */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
+    if (!has_digits)
     {
-        return parse_string(item, input_buffer);
+        return false; /* parse_error */
     }
-    /* number */
-    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9'))))
+    /* the exponent is only part of the number if at least one digit follows */
+    if (((end - pointer) >= 2) && ((*pointer == 'e') || (*pointer == 'E')))
     {
-        return parse_number(item, input_buffer);
+        const unsigned char *exponent_pointer = pointer + 1;
+        cJSON_bool negative_exponent = false;
+        int exponent = 0;
+
+        if ((*exponent_pointer == '+') || (*exponent_pointer == '-'))
+        {
+            negative_exponent = (*exponent_pointer == '-');
+            exponent_pointer++;
+        }
+        if ((exponent_pointer < end) && (*exponent_pointer >= '0') && (*exponent_pointer <= '9'))
+        {
+            for (; (exponent_pointer < end) && (*exponent_pointer >= '0') && (*exponent_pointer <= '9'); exponent_pointer++)
+            {
+                if (exponent < 100000)
+                {
+                    exponent = (exponent * 10) + (*exponent_pointer - '0');
+                }
+            }
+            exponent10 += negative_exponent ? -exponent : exponent;
+            pointer = exponent_pointer;
+        }
     }
-    /* array */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '['))
+
+    if (mantissa == 0)
     {
-        return parse_array(item, input_buffer);
+        number = negative ? -0.0 : 0.0;
     }
-    /* object */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '{'))
+    else if (!truncated && (mantissa <= ((uint64_t)1 << 53)) && (exponent10 >= -22) && (exponent10 <= 22))
     {
-        return parse_object(item, input_buffer);
+        /* both the mantissa and the power of ten are exact doubles, so one IEEE operation rounds correctly */
+        number = (double)mantissa;
+        number = (exponent10 < 0) ? (number / exact_powers_of_ten[-exponent10]) : (number * exact_powers_of_ten[exponent10]);
+        if (negative)
+        {
+            number = -number;
+        }
+    }
+    else
+    {
+        double upper = 0;
+        /* with truncated digits the exact value is somewhere between mantissa and mantissa + 1 */
+        if (!eisel_lemire(mantissa, exponent10, negative, &number)
+            || (truncated && (!eisel_lemire(mantissa + 1, exponent10, negative, &upper) || (upper != number))))
+        {
+            if (!parse_number_slow(number_start, (size_t)(pointer - number_start), &input_buffer->hooks, &number))
+            {
+                return false;
+            }
+        }
     }
 
-    return false;
+    item->valuedouble = number;
+
+    /* use saturation in case of overflow */
+    if (number >= INT_MAX)
+    {
+        item->valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        item->valueint = INT_MIN;
+    }
+    else
+    {
+        item->valueint = (int)number;
+    }
+
+    item->type = cJSON_Number;
+
+    input_buffer->offset += (size_t)(pointer - number_start);
+    return true;
 }
 
-/* Render a value to text. */
-static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer)
+/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
+CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
 {
-    unsigned char *output = NULL;
+    if (number >= INT_MAX)
+    {
+        object->valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        object->valueint = INT_MIN;
+    }
+    else
+    {
+        object->valueint = (int)number;
+    }
 
-    if ((item == NULL) || (output_buffer == NULL))
+    return object->valuedouble = number;
+}
+
+/* Note: when passing a NULL valuestring, cJSON_SetValuestring treats this as an error and return NULL */
+CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
+{
+    char *copy = NULL;
+    size_t v1_len;
+    size_t v2_len;
+    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
+    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & cJSON_IsReference))
     {
-        return false;
+        return NULL;
+    }
+    /* return NULL if the object is corrupted or valuestring is NULL */
+    if (object->valuestring == NULL || valuestring == NULL)
+    {
+        return NULL;
     }
 
-    switch ((item->type) & 0xFF)
+    v1_len = strlen(valuestring);
+    v2_len = strlen(object->valuestring);
+
+    if (v1_len <= v2_len)
     {
-        case cJSON_NULL:
-            output = ensure(output_buffer, 5);
-            if (output == NULL)
-            {
-                return false;
-            }
-            strcpy((char*)output, "null");
-            return true;
+        /* strcpy does not handle overlapping string: [X1, X2] [Y1, Y2] => X2 < Y1 or Y2 < X1 */
+        if (!( valuestring + v1_len < object->valuestring || object->valuestring + v2_len < valuestring ))
+        {
+            return NULL;
+        }
+        strcpy(object->valuestring, valuestring);
+        return object->valuestring;
+    }
+    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    if (object->valuestring != NULL)
+    {
+        cJSON_free(object->valuestring);
+    }
+    object->valuestring = copy;
 
-        case cJSON_False:
-            output = ensure(output_buffer, 6);
-            if (output == NULL)
-            {
-                return false;
-            }
-            strcpy((char*)output, "false");
-            return true;
+    return copy;
+}
 
-        case cJSON_True:
-            output = ensure(output_buffer, 5);
-            if (output == NULL)
-            {
-                return false;
-            }
-            strcpy((char*)output, "true");
-            return true;
+typedef struct
+{
+    unsigned char *buffer;
+    size_t length;
+    size_t offset;
+    size_t depth; /* current nesting depth (for formatted printing) */
+    cJSON_bool noalloc;
+    cJSON_bool format; /* is this print a formatted print */
+    internal_hooks hooks;
+} printbuffer;
 
-        case cJSON_Number:
-            return print_number(item, output_buffer);
+/* realloc printbuffer if necessary to have at least "needed" bytes more */
+static unsigned char* ensure(printbuffer * const p, size_t needed)
+{
+    unsigned char *newbuffer = NULL;
+    size_t newsize = 0;
 
-        case cJSON_Raw:
+    if ((p == NULL) || (p->buffer == NULL))
+    {
+        return NULL;
+    }
+
+    /* make sure that offset is valid. A growable buffer can be exactly full, because the requests
+     * below don't add a byte on top; it just has to grow on the next request. */
+    if ((p->length > 0) && ((p->offset > p->length) || ((p->offset == p->length) && p->noalloc)))
+    {
+        return NULL;
+    }
+
+    if (needed > INT_MAX)
+    {
+        /* sizes bigger than INT_MAX are currently not supported */
+        return NULL;
+    }
+
+    /* callers already include the terminating zero in what they request */
+    needed += p->offset;
+    if (needed <= p->length)
+    {
+        return p->buffer + p->offset;
+    }
+
+    if (p->noalloc) {
+        return NULL;
+    }
+
+    /* calculate new buffer size */
+    if (needed > (INT_MAX / 2))
+    {
+        /* overflow of int, use INT_MAX if possible */
+        if (needed <= INT_MAX)
         {
-            size_t raw_length = 0;
-            if (item->valuestring == NULL)
-            {
-                return false;
-            }
+            newsize = INT_MAX;
+        }
+        else
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        newsize = needed * 2;
+    }
 
-            raw_length = strlen(item->valuestring) + sizeof("");
-            output = ensure(output_buffer, raw_length);
-            if (output == NULL)
-            {
-                return false;
-            }
-            memcpy(output, item->valuestring, raw_length);
-            return true;
+    if (p->hooks.reallocate != NULL)
+    {
+        /* reallocate with realloc if available */
+        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
+        if (newbuffer == NULL)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
         }
+    }
+    else
+    {
+        /* otherwise reallocate manually */
+        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
+        if (!newbuffer)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
 
-        case cJSON_String:
-            return print_string(item, output_buffer);
+            return NULL;
+        }
 
-        case cJSON_Array:
-            return print_array(item, output_buffer);
+        memcpy(newbuffer, p->buffer, (p->offset < p->length) ? (p->offset + 1) : p->offset);
+        p->hooks.deallocate(p->buffer);
+    }
+    p->length = newsize;
+    p->buffer = newbuffer;
 
-        case cJSON_Object:
-            return print_object(item, output_buffer);
+    return newbuffer + p->offset;
+}
 
-        default:
-            return false;
+/* calculate the new length of the string in a printbuffer and update the offset */
+static void update_offset(printbuffer * const buffer)
+{
+    const unsigned char *buffer_pointer = NULL;
+    if ((buffer == NULL) || (buffer->buffer == NULL))
+    {
+        return;
     }
+    buffer_pointer = buffer->buffer + buffer->offset;
+
+    buffer->offset += strlen((const char*)buffer_pointer);
 }
 
-/* Build an array from input text. */
-static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer)
+/* securely comparison of floating-point variables */
+static cJSON_bool compare_double(double a, double b)
 {
-    cJSON *head = NULL; /* head of the linked list */
+    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
+    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+}
+
+/* a floating point number f * 2^e with a 64 bit significand, for Grisu */
+typedef struct
+{
+    uint64_t f;
+    int e;
+} diy_fp;
+
+static const uint64_t powers_of_ten_u64[] =
+{
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u,
+    10000000000u, 100000000000u, 1000000000000u, 10000000000000u, 100000000000000u,
+    1000000000000000u, 10000000000000000u, 100000000000000000u, 1000000000000000000u,
+    10000000000000000000u
+};
+
+static diy_fp diy_fp_multiply(const diy_fp x, const diy_fp y)
+{
+    diy_fp product;
+    uint64_t low = 0;
+
+    multiply_u64(x.f, y.f, &product.f, &low);
+    /* round to the upper 64 bits */
+    product.f += low >> 63;
+    product.e = x.e + y.e + 64;
+
+    return product;
+}
+
+/* get a power of ten c = 10^-K so that the exponent of c * 2^e ends up between -60 and -32 */
+static diy_fp cached_power_of_ten(int e, int *K)
+{
+    diy_fp power;
+    double k_estimate = ((-61 - e) * 0.30102999566398114) + 347; /* log10(2) */
+    int k = (int)k_estimate;
+    int exponent10 = 0;
+    const uint64_t *table_entry = NULL;
+
+    if ((k_estimate - k) > 0.0)
+    {
+        k++;
+    }
+    /* only every 8th power is needed */
+    exponent10 = POWER_OF_TEN_MIN_EXPONENT + (((k >> 3) + 1) * 8);
+    *K = -exponent10;
+
+    table_entry = power_of_ten_table[exponent10 - POWER_OF_TEN_MIN_EXPONENT];
+    power.f = table_entry[0] + (table_entry[1] >> 63);
+    power.e = ((217706 * exponent10) >> 16) - 63;
+
+    return power;
+}
+
+static int count_decimal_digits(uint32_t n)
+{
+    int digits = 1;
+
+    while ((digits < 10) && (n >= powers_of_ten_u64[digits]))
+    {
+        digits++;
+    }
+
+    return digits;
+}
+
+/* step the last digit down while that brings the result closer to the exact value */
+static void grisu_round(unsigned char * const buffer, int length, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w)
+{
+    while ((rest < wp_w) && ((delta - rest) >= ten_kappa)
+           && (((rest + ten_kappa) < wp_w) || ((wp_w - rest) > (rest + ten_kappa - wp_w))))
+    {
+        buffer[length - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+/* generate the shortest digits of a number inside of (mp - delta, mp] */
+static void grisu_digit_gen(const diy_fp w, const diy_fp mp, uint64_t delta, unsigned char * const buffer, int *length, int *K)
+{
+    const int shift = -mp.e;
+    const uint64_t one = (uint64_t)1 << shift;
+    const uint64_t wp_w = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> shift);
+    uint64_t p2 = mp.f & (one - 1);
+    int kappa = count_decimal_digits(p1);
+
+    *length = 0;
+
+    /* integral part */
+    while (kappa > 0)
+    {
+        uint32_t divisor = (uint32_t)powers_of_ten_u64[kappa - 1];
+        uint32_t digit = p1 / divisor;
+        uint64_t rest = 0;
+
+        p1 %= divisor;
+        if ((digit != 0) || (*length != 0))
+        {
+            buffer[(*length)++] = (unsigned char)('0' + digit);
+        }
+        kappa--;
+
+        rest = ((uint64_t)p1 << shift) + p2;
+        if (rest <= delta)
+        {
+            *K += kappa;
+            grisu_round(buffer, *length, delta, rest, powers_of_ten_u64[kappa] << shift, wp_w);
+            return;
+        }
+    }
+
+    /* fractional part */
+    for (;;)
+    {
+        unsigned char digit = 0;
+
+        p2 *= 10;
+        delta *= 10;
+        digit = (unsigned char)(p2 >> shift);
+        if ((digit != 0) || (*length != 0))
+        {
+            buffer[(*length)++] = (unsigned char)('0' + digit);
+        }
+        p2 &= one - 1;
+        kappa--;
+
+        if (p2 < delta)
+        {
+            *K += kappa;
+            grisu_round(buffer, *length, delta, p2, one, wp_w * ((-kappa < 20) ? powers_of_ten_u64[-kappa] : 0));
+            return;
+        }
+    }
+}
+
+/* Grisu2: find the shortest digits (almost always) that convert back to value, value = digits * 10^K.
+ * value has to be finite and positive. */
+static void grisu2(double value, unsigned char * const buffer, int *length, int *K)
+{
+    const uint64_t hidden_bit = (uint64_t)1 << 52;
+    uint64_t bits = bits_from_double(value);
+    int biased_exponent = (int)((bits >> 52) & 0x7FF);
+    diy_fp v;
+    diy_fp plus;
+    diy_fp minus;
+    diy_fp power;
+    int leading_zeros = 0;
+
+    v.f = bits & (hidden_bit - 1);
+    if (biased_exponent != 0)
+    {
+        v.f += hidden_bit;
+        v.e = biased_exponent - 1075;
+    }
+    else
+    {
+        /* subnormal */
+        v.e = -1074;
+    }
+
+    /* the boundaries halfway to the neighbouring doubles, normalized to the same exponent */
+    plus.f = (v.f << 1) + 1;
+    plus.e = v.e - 1;
+    while (!(plus.f & (hidden_bit << 1)))
+    {
+        plus.f <<= 1;
+        plus.e--;
+    }
+    plus.f <<= 10;
+    plus.e -= 10;
+
+    if (v.f == hidden_bit)
+    {
+        /* the gap to the next smaller double is only half as big */
+        minus.f = (v.f << 2) - 1;
+        minus.e = v.e - 2;
+    }
+    else
+    {
+        minus.f = (v.f << 1) - 1;
+        minus.e = v.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    leading_zeros = count_leading_zeros(v.f);
+    v.f <<= leading_zeros;
+    v.e -= leading_zeros;
+
+    power = cached_power_of_ten(plus.e, K);
+    v = diy_fp_multiply(v, power);
+    plus = diy_fp_multiply(plus, power);
+    minus = diy_fp_multiply(minus, power);
+    /* stay strictly inside of the rounding interval */
+    minus.f++;
+    plus.f--;
+
+    grisu_digit_gen(v, plus, plus.f - minus.f, buffer, length, K);
+}
+
+/* the old "%1.15g" output, if it reads back exactly; 0 otherwise */
+static int print_fifteen_digits(double d, unsigned char * const output)
+{
+    char number_buffer[32];
+    char *after_end = NULL;
+    unsigned char decimal_point = get_decimal_point();
+    int length = sprintf(number_buffer, "%1.15g", d);
+    int i = 0;
+
+    if ((length <= 0) || (length > 24) || (strtod(number_buffer, &after_end) != d) || (after_end != (number_buffer + length)))
+    {
+        return 0;
+    }
+
+    for (i = 0; i < length; i++)
+    {
+        output[i] = ((unsigned char)number_buffer[i] == decimal_point) ? '.' : (unsigned char)number_buffer[i];
+    }
+
+    return length;
+}
+
+/* print a finite, nonzero double like printf's %g would with just enough digits to read it back */
+static int print_shortest_double(double d, unsigned char * const output)
+{
+    unsigned char digits[32];
+    unsigned char *output_pointer = output;
+    unsigned char *magnitude_start = NULL;
+    int length = 0;
+    int K = 0;
+    int exponent = 0;
+    int precision = 0;
+
+    if (d < 0)
+    {
+        *output_pointer++ = '-';
+        d = -d;
+    }
+    if (d == 0)
+    {
+        *output_pointer++ = '0';
+        return (int)(output_pointer - output);
+    }
+
+    grisu2(d, digits, &length, &K);
+    magnitude_start = output_pointer;
+    exponent = length + K - 1; /* decimal exponent of the first digit */
+    precision = (length <= 15) ? 15 : 17;
+
+    if ((exponent < -4) || (exponent >= precision))
+    {
+        /* d.ddde+XX */
+        int absolute_exponent = (exponent < 0) ? -exponent : exponent;
+
+        *output_pointer++ = digits[0];
+        if (length > 1)
+        {
+            *output_pointer++ = '.';
+            memcpy(output_pointer, digits + 1, (size_t)(length - 1));
+            output_pointer += length - 1;
+        }
+        *output_pointer++ = 'e';
+        *output_pointer++ = (exponent < 0) ? '-' : '+';
+        if (absolute_exponent >= 100)
+        {
+            *output_pointer++ = (unsigned char)('0' + (absolute_exponent / 100));
+            absolute_exponent %= 100;
+        }
+        *output_pointer++ = (unsigned char)('0' + (absolute_exponent / 10));
+        *output_pointer++ = (unsigned char)('0' + (absolute_exponent % 10));
+    }
+    else if (exponent >= 0)
+    {
+        if (length <= (exponent + 1))
+        {
+            /* integral, pad with zeros */
+            memcpy(output_pointer, digits, (size_t)length);
+            output_pointer += length;
+            memset(output_pointer, '0', (size_t)(exponent + 1 - length));
+            output_pointer += exponent + 1 - length;
+        }
+        else
+        {
+            memcpy(output_pointer, digits, (size_t)(exponent + 1));
+            output_pointer += exponent + 1;
+            *output_pointer++ = '.';
+            memcpy(output_pointer, digits + exponent + 1, (size_t)(length - exponent - 1));
+            output_pointer += length - exponent - 1;
+        }
+    }
+    else
+    {
+        /* 0.000ddd */
+        *output_pointer++ = '0';
+        *output_pointer++ = '.';
+        memset(output_pointer, '0', (size_t)(-exponent - 1));
+        output_pointer += -exponent - 1;
+        memcpy(output_pointer, digits, (size_t)length);
+        output_pointer += length;
+    }
+
+    if (length > 15)
+    {
+        /* Grisu2 can't tell when it missed the shortest digits, which happens for a few 16 and 17 digit results.
+         * Whatever 15 digits can carry is printed by the C library like before, so the output never gets longer. */
+        unsigned char fifteen_digits[32];
+        int fifteen_length = print_fifteen_digits(d, fifteen_digits);
+        if ((fifteen_length > 0) && (fifteen_length < (int)(output_pointer - magnitude_start)))
+        {
+            memcpy(magnitude_start, fifteen_digits, (size_t)fifteen_length);
+            output_pointer = magnitude_start + fifteen_length;
+        }
+    }
+
+    return (int)(output_pointer - output);
+}
+
+static int print_integer(int integer, unsigned char * const output)
+{
+    unsigned char reversed[10];
+    unsigned char *output_pointer = output;
+    unsigned int magnitude = (unsigned int)integer;
+    int length = 0;
+
+    if (integer < 0)
+    {
+        *output_pointer++ = '-';
+        magnitude = 0u - magnitude;
+    }
+
+    do
+    {
+        reversed[length++] = (unsigned char)('0' + (magnitude % 10));
+        magnitude /= 10;
+    }
+    while (magnitude > 0);
+
+    while (length > 0)
+    {
+        *output_pointer++ = reversed[--length];
+    }
+
+    return (int)(output_pointer - output);
+}
+
+/* Render the number nicely from the given item into a string. */
+/* Render the number into number_buffer (at least 26 bytes, not terminated), returns the length */
+static int format_number(const cJSON * const item, unsigned char * const number_buffer)
+{
+    double d = item->valuedouble;
+
+    /* This checks for NaN and Infinity */
+    if (isnan(d) || isinf(d))
+    {
+        memcpy(number_buffer, "null", 4);
+        return 4;
+    }
+    else if(d == (double)item->valueint)
+    {
+        return print_integer(item->valueint, number_buffer);
+    }
+
+    return print_shortest_double(d, number_buffer);
+}
+
+static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    int length = 0;
+    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    length = format_number(item, number_buffer);
+
+    /* reserve appropriate space in the output */
+    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    memcpy(output_pointer, number_buffer, (size_t)length);
+    output_pointer[length] = '\0';
+
+    output_buffer->offset += (size_t)length;
+
+    return true;
+}
+
+/* parse 4 digit hexadecimal number */
+static unsigned parse_hex4(const unsigned char * const input)
+{
+    unsigned int h = 0;
+    size_t i = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        /* parse digit */
+        if ((input[i] >= '0') && (input[i] <= '9'))
+        {
+            h += (unsigned int) input[i] - '0';
+        }
+        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        {
+            h += (unsigned int) 10 + input[i] - 'A';
+        }
+        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+        {
+            h += (unsigned int) 10 + input[i] - 'a';
+        }
+        else /* invalid */
+        {
+            return 0;
+        }
+
+        if (i < 3)
+        {
+            /* shift left to make place for the next nibble */
+            h = h << 4;
+        }
+    }
+
+    return h;
+}
+
+/* converts a UTF-16 literal to UTF-8
+ * A literal can be one or two sequences of the form \uXXXX */
+static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+{
+    long unsigned int codepoint = 0;
+    unsigned int first_code = 0;
+    const unsigned char *first_sequence = input_pointer;
+    unsigned char utf8_length = 0;
+    unsigned char utf8_position = 0;
+    unsigned char sequence_length = 0;
+    unsigned char first_byte_mark = 0;
+
+    if ((input_end - first_sequence) < 6)
+    {
+        /* input ends unexpectedly */
+        goto fail;
+    }
+
+    /* get the first utf16 sequence */
+    first_code = parse_hex4(first_sequence + 2);
+
+    /* check that the code is valid */
+    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+    {
+        goto fail;
+    }
+
+    /* UTF16 surrogate pair */
+    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
+    {
+        const unsigned char *second_sequence = first_sequence + 6;
+        unsigned int second_code = 0;
+        sequence_length = 12; /* \uXXXX\uXXXX */
+
+        if ((input_end - second_sequence) < 6)
+        {
+            /* input ends unexpectedly */
+            goto fail;
+        }
+
+        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
+        {
+            /* missing second half of the surrogate pair */
+            goto fail;
+        }
+
+        /* get the second utf16 sequence */
+        second_code = parse_hex4(second_sequence + 2);
+        /* check that the code is valid */
+        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
+        {
+            /* invalid second half of the surrogate pair */
+            goto fail;
+        }
+
+
+        /* calculate the unicode codepoint from the surrogate pair */
+        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
+    }
+    else
+    {
+        sequence_length = 6; /* \uXXXX */
+        codepoint = first_code;
+    }
+
+    /* encode as UTF-8
+     * takes at maximum 4 bytes to encode:
+     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
+    if (codepoint < 0x80)
+    {
+        /* normal ascii, encoding 0xxxxxxx */
+        utf8_length = 1;
+    }
+    else if (codepoint < 0x800)
+    {
+        /* two bytes, encoding 110xxxxx 10xxxxxx */
+        utf8_length = 2;
+        first_byte_mark = 0xC0; /* 11000000 */
+    }
+    else if (codepoint < 0x10000)
+    {
+        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 3;
+        first_byte_mark = 0xE0; /* 11100000 */
+    }
+    else if (codepoint <= 0x10FFFF)
+    {
+        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 4;
+        first_byte_mark = 0xF0; /* 11110000 */
+    }
+    else
+    {
+        /* invalid unicode codepoint */
+        goto fail;
+    }
+
+    /* encode as utf8 */
+    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
+    {
+        /* 10xxxxxx */
+        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
+        codepoint >>= 6;
+    }
+    /* encode first byte */
+    if (utf8_length > 1)
+    {
+        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+    }
+    else
+    {
+        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+    }
+
+    *output_pointer += utf8_length;
+
+    return sequence_length;
+
+fail:
+    return 0;
+}
+
+static void* cast_away_const(const void* string);
+
+/* Parse the input text into an unescaped cinput, and populate item. */
+static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+{
+    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
+    unsigned char *output_pointer = NULL;
+    unsigned char *output = NULL;
+
+    /* not a string */
+    if (buffer_at_offset(input_buffer)[0] != '\"')
+    {
+        goto fail;
+    }
+
+    {
+        /* calculate approximate size of the output (overestimate) */
+        size_t allocation_length = 0;
+        size_t skipped_bytes = 0;
+        while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
+        {
+            /* is escape sequence */
+            if (input_end[0] == '\\')
+            {
+                if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
+                {
+                    /* prevent buffer overflow when last input character is a backslash */
+                    goto fail;
+                }
+                skipped_bytes++;
+                input_end++;
+            }
+            input_end++;
+        }
+        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
+        {
+            goto fail; /* string ended unexpectedly */
+        }
+
+        if (input_buffer->in_situ)
+        {
+            /* unescaping never makes the string longer, so the output overwrites the input (at most up to the closing quote) */
+            output = (unsigned char*)cast_away_const(input_pointer);
+        }
+        else
+        {
+            /* This is at most how much we need for the output */
+            allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
+            output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+            if (output == NULL)
+            {
+                goto fail; /* allocation failure */
+            }
+        }
+    }
+
+    output_pointer = output;
+    /* loop through the string literal */
+    while (input_pointer < input_end)
+    {
+        if (*input_pointer != '\\')
+        {
+            *output_pointer++ = *input_pointer++;
+        }
+        /* escape sequence */
+        else
+        {
+            unsigned char sequence_length = 2;
+            if ((input_end - input_pointer) < 1)
+            {
+                goto fail;
+            }
+
+            switch (input_pointer[1])
+            {
+                case 'b':
+                    *output_pointer++ = '\b';
+                    break;
+                case 'f':
+                    *output_pointer++ = '\f';
+                    break;
+                case 'n':
+                    *output_pointer++ = '\n';
+                    break;
+                case 'r':
+                    *output_pointer++ = '\r';
+                    break;
+                case 't':
+                    *output_pointer++ = '\t';
+                    break;
+                case '\"':
+                case '\\':
+                case '/':
+                    *output_pointer++ = input_pointer[1];
+                    break;
+
+                /* UTF-16 literal */
+                case 'u':
+                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
+                    if (sequence_length == 0)
+                    {
+                        /* failed to convert UTF16-literal to UTF-8 */
+                        goto fail;
+                    }
+                    break;
+
+                default:
+                    goto fail;
+            }
+            input_pointer += sequence_length;
+        }
+    }
+
+    /* zero terminate the output */
+    *output_pointer = '\0';
+
+    /* in situ strings belong to the input buffer */
+    item->type = input_buffer->in_situ ? (cJSON_String | cJSON_IsReference) : cJSON_String;
+    item->valuestring = (char*)output;
+
+    input_buffer->offset = (size_t) (input_end - input_buffer->content);
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if ((output != NULL) && !input_buffer->in_situ)
+    {
+        input_buffer->hooks.deallocate(output);
+        output = NULL;
+    }
+
+    if (input_pointer != NULL)
+    {
+        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+    }
+
+    return false;
+}
+
+/* Length of the escaped string (without quotes), escape_characters receives how many characters escaping adds */
+static size_t escaped_string_length(const unsigned char * const input, size_t * const escape_characters)
+{
+    const unsigned char *input_pointer = NULL;
+
+    *escape_characters = 0;
+    for (input_pointer = input; *input_pointer; input_pointer++)
+    {
+        switch (*input_pointer)
+        {
+            case '\"':
+            case '\\':
+            case '\b':
+            case '\f':
+            case '\n':
+            case '\r':
+            case '\t':
+                /* one character escape sequence */
+                (*escape_characters)++;
+                break;
+            default:
+                if (*input_pointer < 32)
+                {
+                    /* UTF-16 escape sequence uXXXX */
+                    *escape_characters += 5;
+                }
+                break;
+        }
+    }
+
+    return (size_t)(input_pointer - input) + *escape_characters;
+}
+
+/* Render the cstring provided to an escaped version that can be printed. */
+static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+{
+    const unsigned char *input_pointer = NULL;
+    unsigned char *output = NULL;
+    unsigned char *output_pointer = NULL;
+    size_t output_length = 0;
+    /* numbers of additional characters needed for escaping */
+    size_t escape_characters = 0;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* empty string */
+    if (input == NULL)
+    {
+        output = ensure(output_buffer, sizeof("\"\""));
+        if (output == NULL)
+        {
+            return false;
+        }
+        strcpy((char*)output, "\"\"");
+
+        return true;
+    }
+
+    output_length = escaped_string_length(input, &escape_characters);
+
+    output = ensure(output_buffer, output_length + sizeof("\"\""));
+    if (output == NULL)
+    {
+        return false;
+    }
+
+    /* no characters have to be escaped */
+    if (escape_characters == 0)
+    {
+        output[0] = '\"';
+        memcpy(output + 1, input, output_length);
+        output[output_length + 1] = '\"';
+        output[output_length + 2] = '\0';
+
+        return true;
+    }
+
+    output[0] = '\"';
+    output_pointer = output + 1;
+    /* copy the string */
+    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
+    {
+        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
+        {
+            /* normal character, copy */
+            *output_pointer = *input_pointer;
+        }
+        else
+        {
+            /* character needs to be escaped */
+            *output_pointer++ = '\\';
+            switch (*input_pointer)
+            {
+                case '\\':
+                    *output_pointer = '\\';
+                    break;
+                case '\"':
+                    *output_pointer = '\"';
+                    break;
+                case '\b':
+                    *output_pointer = 'b';
+                    break;
+                case '\f':
+                    *output_pointer = 'f';
+                    break;
+                case '\n':
+                    *output_pointer = 'n';
+                    break;
+                case '\r':
+                    *output_pointer = 'r';
+                    break;
+                case '\t':
+                    *output_pointer = 't';
+                    break;
+                default:
+                    /* escape and print as unicode codepoint */
+                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
+                    output_pointer += 4;
+                    break;
+            }
+        }
+    }
+    output[output_length + 1] = '\"';
+    output[output_length + 2] = '\0';
+
+    return true;
+}
+
+/* Invoke print_string_ptr (which is useful) on an item. */
+static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
+{
+    return print_string_ptr((unsigned char*)item->valuestring, p);
+}
+
+/* Predeclare these prototypes. */
+static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
+
+/* Utility to jump whitespace and cr/lf */
+static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL))
+    {
+        return NULL;
+    }
+
+    if (cannot_access_at_index(buffer, 0))
+    {
+        return buffer;
+    }
+
+    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
+    {
+       buffer->offset++;
+    }
+
+    if (buffer->offset == buffer->length)
+    {
+        buffer->offset--;
+    }
+
+    return buffer;
+}
+
+/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
+static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
+    {
+        return NULL;
+    }
+
+    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+    {
+        buffer->offset += 3;
+    }
+
+    return buffer;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    size_t buffer_length;
+
+    if (NULL == value)
+    {
+        return NULL;
+    }
+
+    /* Adding null character size due to require_null_terminated. */
+    buffer_length = strlen(value) + sizeof("");
+
+    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
+}
+
+/* Parse an object - create a new root, and populate. */
+static cJSON *parse_document(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, cJSON_bool in_situ, const internal_hooks * const hooks, error * const error_state, intern_table * const keys)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
+    cJSON *item = NULL;
+
+    /* reset error position */
+    error_state->json = NULL;
+    error_state->position = 0;
+
+    if (value == NULL || 0 == buffer_length)
+    {
+        goto fail;
+    }
+
+    buffer.content = (const unsigned char*)value;
+    buffer.length = buffer_length;
+    buffer.offset = 0;
+    buffer.hooks = *hooks;
+    buffer.in_situ = in_situ;
+    buffer.keys = keys;
+
+    item = cJSON_New_Item(hooks);
+    if (item == NULL) /* memory fail */
+    {
+        goto fail;
+    }
+
+    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    {
+        /* parse failure. ep is set. */
+        goto fail;
+    }
+
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if (require_null_terminated)
+    {
+        buffer_skip_whitespace(&buffer);
+        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        {
+            goto fail;
+        }
+    }
+    if (return_parse_end)
+    {
+        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+    }
+
+    return item;
+
+fail:
+    if (item != NULL)
+    {
+        delete_item(item, hooks);
+    }
+
+    if (value != NULL)
+    {
+        error local_error;
+        local_error.json = (const unsigned char*)value;
+        local_error.position = 0;
+
+        if (buffer.offset < buffer.length)
+        {
+            local_error.position = buffer.offset;
+        }
+        else if (buffer.length > 0)
+        {
+            local_error.position = buffer.length - 1;
+        }
+
+        if (return_parse_end != NULL)
+        {
+            *return_parse_end = (const char*)local_error.json + local_error.position;
+        }
+
+        *error_state = local_error;
+    }
+
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    return parse_document(value, buffer_length, return_parse_end, require_null_terminated, false, &global_hooks, &global_error, NULL);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value, size_t buffer_length)
+{
+    return parse_document(value, buffer_length, NULL, false, true, &global_hooks, &global_error, NULL);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithContext(cJSON_Context *context, const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    if (context == NULL)
+    {
+        return NULL;
+    }
+
+    return parse_document(value, buffer_length, return_parse_end, require_null_terminated, false, &context->hooks, &context->error, context->keys);
+}
+
+CJSON_PUBLIC(const char *) cJSON_GetContextErrorPtr(const cJSON_Context *context)
+{
+    if ((context == NULL) || (context->error.json == NULL))
+    {
+        return NULL;
+    }
+
+    return (const char*)(context->error.json + context->error.position);
+}
+
+/* Default options for cJSON_Parse */
+CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+{
+    return cJSON_ParseWithOpts(value, 0, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+{
+    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+}
+
+/* Skip over one complete value (string, number, literal, array or object) without allocating.
+ * Containers are skipped by counting brackets, their contents are not validated. */
+static cJSON_bool skip_value(parse_buffer * const input_buffer)
+{
+    size_t depth = 0;
+
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        return false;
+    }
+
+    do
+    {
+        switch (buffer_at_offset(input_buffer)[0])
+        {
+            case '\"':
+                /* jump to the closing quote, stepping over escape sequences */
+                input_buffer->offset++;
+                while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] != '\"'))
+                {
+                    if (buffer_at_offset(input_buffer)[0] == '\\')
+                    {
+                        input_buffer->offset++;
+                    }
+                    input_buffer->offset++;
+                }
+                if (cannot_access_at_index(input_buffer, 0))
+                {
+                    return false; /* string ended unexpectedly */
+                }
+                input_buffer->offset++;
+                break;
+
+            case '[':
+            case '{':
+                if (depth >= CJSON_NESTING_LIMIT)
+                {
+                    return false; /* to deeply nested */
+                }
+                depth++;
+                input_buffer->offset++;
+                break;
+
+            case ']':
+            case '}':
+                if (depth == 0)
+                {
+                    return false; /* unbalanced */
+                }
+                depth--;
+                input_buffer->offset++;
+                break;
+
+            case ',':
+            case ':':
+                if (depth == 0)
+                {
+                    return false; /* not inside of a value */
+                }
+                input_buffer->offset++;
+                break;
+
+            default:
+                if (buffer_at_offset(input_buffer)[0] <= 32)
+                {
+                    if (depth == 0)
+                    {
+                        return false;
+                    }
+                    input_buffer->offset++;
+                    break;
+                }
+                /* number or literal, runs until the next delimiter */
+                while (can_access_at_index(input_buffer, 0))
+                {
+                    unsigned char c = buffer_at_offset(input_buffer)[0];
+                    if ((c <= 32) || (c == ',') || (c == ']') || (c == '}') || (c == ':'))
+                    {
+                        break;
+                    }
+                    input_buffer->offset++;
+                }
+                break;
+        }
+    }
+    while ((depth > 0) && can_access_at_index(input_buffer, 0));
+
+    return depth == 0;
+}
+
+/* Compare a raw (still escaped) object key from the input against a path segment. */
+static cJSON_bool raw_key_equals(const unsigned char *key, const unsigned char * const key_end, const unsigned char *segment, const unsigned char * const segment_end)
+{
+    while (key < key_end)
+    {
+        unsigned char decoded[4];
+        unsigned char *decoded_end = decoded;
+        size_t decoded_length = 0;
+        size_t i = 0;
+
+        if (*key != '\\')
+        {
+            if ((segment >= segment_end) || (*segment != *key))
+            {
+                return false;
+            }
+            key++;
+            segment++;
+            continue;
+        }
+
+        if ((key_end - key) < 2)
+        {
+            return false;
+        }
+        switch (key[1])
+        {
+            case 'b': decoded[0] = '\b'; decoded_end++; key += 2; break;
+            case 'f': decoded[0] = '\f'; decoded_end++; key += 2; break;
+            case 'n': decoded[0] = '\n'; decoded_end++; key += 2; break;
+            case 'r': decoded[0] = '\r'; decoded_end++; key += 2; break;
+            case 't': decoded[0] = '\t'; decoded_end++; key += 2; break;
+            case '\"':
+            case '\\':
+            case '/':
+                decoded[0] = key[1];
+                decoded_end++;
+                key += 2;
+                break;
+            case 'u':
+            {
+                unsigned char sequence_length = utf16_literal_to_utf8(key, key_end, &decoded_end);
+                if (sequence_length == 0)
+                {
+                    return false;
+                }
+                key += sequence_length;
+                break;
+            }
+            default:
+                return false;
+        }
+
+        decoded_length = (size_t)(decoded_end - decoded);
+        if ((size_t)(segment_end - segment) < decoded_length)
+        {
+            return false;
+        }
+        for (i = 0; i < decoded_length; i++)
+        {
+            if (segment[i] != decoded[i])
+            {
+                return false;
+            }
+        }
+        segment += decoded_length;
+    }
+
+    return segment == segment_end;
+}
+
+/* Walk the raw input along path and leave the buffer at the first byte of the value found. */
+static cJSON_bool seek_path(parse_buffer * const input_buffer, const char *path)
+{
+    const unsigned char *segment = (const unsigned char*)path;
+
+    buffer_skip_whitespace(skip_utf8_bom(input_buffer));
+
+    while (*segment != '\0')
+    {
+        const unsigned char *segment_end = segment;
+        while ((*segment_end != '\0') && (*segment_end != '/'))
+        {
+            segment_end++;
+        }
+
+        if (cannot_access_at_index(input_buffer, 0))
+        {
+            return false;
+        }
+
+        if (buffer_at_offset(input_buffer)[0] == '{')
+        {
+            cJSON_bool found = false;
+
+            input_buffer->offset++;
+            buffer_skip_whitespace(input_buffer);
+            while (!found)
+            {
+                const unsigned char *key = NULL;
+
+                if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '\"'))
+                {
+                    return false; /* empty object or missing key */
+                }
+                key = buffer_at_offset(input_buffer) + 1;
+                if (!skip_value(input_buffer))
+                {
+                    return false;
+                }
+                found = raw_key_equals(key, buffer_at_offset(input_buffer) - 1, segment, segment_end);
+
+                buffer_skip_whitespace(input_buffer);
+                if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+                {
+                    return false;
+                }
+                input_buffer->offset++;
+                buffer_skip_whitespace(input_buffer);
+                if (found)
+                {
+                    break;
+                }
+
+                if (!skip_value(input_buffer))
+                {
+                    return false;
+                }
+                buffer_skip_whitespace(input_buffer);
+                if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ','))
+                {
+                    return false; /* end of object, key not present */
+                }
+                input_buffer->offset++;
+                buffer_skip_whitespace(input_buffer);
+            }
+        }
+        else if (buffer_at_offset(input_buffer)[0] == '[')
+        {
+            size_t index = 0;
+            const unsigned char *digit = segment;
+
+            if (digit == segment_end)
+            {
+                return false;
+            }
+            for (; digit < segment_end; digit++)
+            {
+                if ((*digit < '0') || (*digit > '9') || (index > (((size_t)-1) / 10)))
+                {
+                    return false; /* not an array index */
+                }
+                index = (index * 10) + (size_t)(*digit - '0');
+            }
+
+            input_buffer->offset++;
+            buffer_skip_whitespace(input_buffer);
+            if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ']'))
+            {
+                return false; /* empty array */
+            }
+            for (; index > 0; index--)
+            {
+                if (!skip_value(input_buffer))
+                {
+                    return false;
+                }
+                buffer_skip_whitespace(input_buffer);
+                if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ','))
+                {
+                    return false; /* index out of range */
+                }
+                input_buffer->offset++;
+                buffer_skip_whitespace(input_buffer);
+            }
+        }
+        else
+        {
+            return false; /* path continues below a primitive */
+        }
+
+        segment = (*segment_end == '/') ? segment_end + 1 : segment_end;
+    }
+
+    return can_access_at_index(input_buffer, 0);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ExtractPathView(const char *json, size_t buffer_length, const char *path, const char **value_start, size_t *value_length)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
+    size_t start = 0;
+
+    if ((json == NULL) || (buffer_length == 0) || (path == NULL))
+    {
+        return false;
+    }
+
+    buffer.content = (const unsigned char*)json;
+    buffer.length = buffer_length;
+    buffer.hooks = global_hooks;
+
+    if (!seek_path(&buffer, path))
+    {
+        return false;
+    }
+
+    start = buffer.offset;
+    if (!skip_value(&buffer))
+    {
+        return false;
+    }
+
+    if (value_start != NULL)
+    {
+        *value_start = json + start;
+    }
+    if (value_length != NULL)
+    {
+        *value_length = buffer.offset - start;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(char *) cJSON_ExtractPath(const char *json, size_t buffer_length, const char *path)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
+    cJSON item;
+
+    if ((json == NULL) || (buffer_length == 0) || (path == NULL))
+    {
+        return NULL;
+    }
+
+    buffer.content = (const unsigned char*)json;
+    buffer.length = buffer_length;
+    buffer.hooks = global_hooks;
+
+    if (!seek_path(&buffer, path) || (buffer_at_offset(&buffer)[0] != '\"'))
+    {
+        return NULL;
+    }
+
+    /* the unescaped string is the only allocation */
+    memset(&item, '\0', sizeof(item));
+    if (!parse_string(&item, &buffer))
+    {
+        return NULL;
+    }
+
+    return item.valuestring;
+}
+
+#define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
+
+/* Compute the exact length of the text that print_value renders for item, without the terminating zero. */
+static cJSON_bool measure_value(const cJSON * const item, const cJSON_bool format, const size_t depth, size_t * const length)
+{
+    unsigned char number_buffer[26];
+    size_t escape_characters = 0;
+    size_t child_length = 0;
+    const cJSON *child = NULL;
+
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    switch ((item->type) & 0xFF)
+    {
+        case cJSON_NULL:
+            *length = sizeof("null") - 1;
+            return true;
+
+        case cJSON_False:
+            *length = sizeof("false") - 1;
+            return true;
+
+        case cJSON_True:
+            *length = sizeof("true") - 1;
+            return true;
+
+        case cJSON_Number:
+            *length = (size_t)format_number(item, number_buffer);
+            return true;
+
+        case cJSON_Raw:
+            if (item->valuestring == NULL)
+            {
+                return false;
+            }
+            *length = strlen(item->valuestring);
+            return true;
+
+        case cJSON_String:
+            *length = sizeof("\"\"") - 1;
+            if (item->valuestring != NULL)
+            {
+                *length += escaped_string_length((const unsigned char*)item->valuestring, &escape_characters);
+            }
+            return true;
+
+        case cJSON_Array:
+            /* [a, b] or [a,b] */
+            *length = sizeof("[]") - 1;
+            for (child = item->child; child != NULL; child = child->next)
+            {
+                if (!measure_value(child, format, depth + 1, &child_length))
+                {
+                    return false;
+                }
+                *length += child_length;
+                if (child->next != NULL)
+                {
+                    *length += format ? 2 : 1;
+                }
+            }
+            return true;
+
+        case cJSON_Object:
+            /* {\n<tabs>"key":\tvalue,\n<tabs>} or {"key":value,} */
+            *length = format ? (sizeof("{\n}") - 1 + depth) : (sizeof("{}") - 1);
+            for (child = item->child; child != NULL; child = child->next)
+            {
+                if (!measure_value(child, format, depth + 1, &child_length))
+                {
+                    return false;
+                }
+                *length += child_length + (sizeof("\"\"") - 1);
+                if (child->string != NULL)
+                {
+                    *length += escaped_string_length((const unsigned char*)child->string, &escape_characters);
+                }
+                *length += format ? ((depth + 1) + sizeof(":\t\n") - 1) : (sizeof(":") - 1);
+                if (child->next != NULL)
+                {
+                    *length += 1;
+                }
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static unsigned char *print(const cJSON * const item, cJSON_bool format, const internal_hooks * const hooks)
+{
+    printbuffer buffer[1];
+    size_t length = 0;
+
+    memset(buffer, 0, sizeof(buffer));
+
+    /* measure first, so the text is written into a single allocation of the exact size */
+    if (!measure_value(item, format, 0, &length))
+    {
+        return NULL;
+    }
+
+    buffer->buffer = (unsigned char*) hooks->allocate(length + sizeof(""));
+    buffer->length = length + sizeof("");
+    buffer->noalloc = true;
+    buffer->format = format;
+    buffer->hooks = *hooks;
+    if (buffer->buffer == NULL)
+    {
+        return NULL;
+    }
+
+    /* print the value */
+    if (!print_value(item, buffer))
+    {
+        hooks->deallocate(buffer->buffer);
+        buffer->buffer = NULL;
+        return NULL;
+    }
+
+    return buffer->buffer;
+}
+
+/* Render a cJSON item/entity/structure to text. */
+CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item)
+{
+    return (char*)print(item, true, &global_hooks);
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item)
+{
+    return (char*)print(item, false, &global_hooks);
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintWithContext(cJSON_Context *context, const cJSON *item, cJSON_bool format)
+{
+    if (context == NULL)
+    {
+        return NULL;
+    }
+
+    return (char*)print(item, format, &context->hooks);
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+
+    if (prebuffer < 0)
+    {
+        return NULL;
+    }
+
+    p.buffer = (unsigned char*)global_hooks.allocate((size_t)prebuffer);
+    if (!p.buffer)
+    {
+        return NULL;
+    }
+
+    p.length = (size_t)prebuffer;
+    p.offset = 0;
+    p.noalloc = false;
+    p.format = fmt;
+    p.hooks = global_hooks;
+
+    if (!print_value(item, &p))
+    {
+        global_hooks.deallocate(p.buffer);
+        p.buffer = NULL;
+        return NULL;
+    }
+
+    return (char*)p.buffer;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToBuffer(const cJSON *item, char **buffer, size_t *capacity, const cJSON_bool format)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    size_t length = 0;
+
+    if ((buffer == NULL) || (capacity == NULL) || !measure_value(item, format, 0, &length))
+    {
+        return false;
+    }
+    length += sizeof("");
+
+    /* only reallocate if the text doesn't fit into the buffer from last time */
+    if ((*buffer == NULL) || (*capacity < length))
+    {
+        char *new_buffer = (char*)global_hooks.allocate(length);
+        if (new_buffer == NULL)
+        {
+            return false;
+        }
+        if (*buffer != NULL)
+        {
+            global_hooks.deallocate(*buffer);
+        }
+        *buffer = new_buffer;
+        *capacity = length;
+    }
+
+    p.buffer = (unsigned char*)*buffer;
+    p.length = *capacity;
+    p.offset = 0;
+    p.noalloc = true;
+    p.format = format;
+    p.hooks = global_hooks;
+
+    return print_value(item, &p);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+
+    if ((length < 0) || (buffer == NULL))
+    {
+        return false;
+    }
+
+    p.buffer = (unsigned char*)buffer;
+    p.length = (size_t)length;
+    p.offset = 0;
+    p.noalloc = true;
+    p.format = format;
+    p.hooks = global_hooks;
+
+    return print_value(item, &p);
+}
+
+/* Parser core - when encountering text, process appropriately. */
+static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
+{
+    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    {
+        return false; /* no input */
+    }
+
+    /* parse the different types of values */
+    /* null */
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
+    {
+        item->type = cJSON_NULL;
+        input_buffer->offset += 4;
+        return true;
+    }
+    /* false */
+    if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
+    {
+        item->type = cJSON_False;
+        input_buffer->offset += 5;
+        return true;
+    }
+    /* true */
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
+    {
+        item->type = cJSON_True;
+        item->valueint = 1;
+        input_buffer->offset += 4;
+        return true;
+    }
+    /* string */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
+    {
+        return parse_string(item, input_buffer);
+    }
+    /* number */
+    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9'))))
+    {
+        return parse_number(item, input_buffer);
+    }
+    /* array */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '['))
+    {
+        return parse_array(item, input_buffer);
+    }
+    /* object */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '{'))
+    {
+        return parse_object(item, input_buffer);
+    }
+
+    return false;
+}
+
+/* Render a value to text. */
+static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output = NULL;
+
+    if ((item == NULL) || (output_buffer == NULL))
+    {
+        return false;
+    }
+
+    switch ((item->type) & 0xFF)
+    {
+        case cJSON_NULL:
+            output = ensure(output_buffer, 5);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "null");
+            return true;
+
+        case cJSON_False:
+            output = ensure(output_buffer, 6);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "false");
+            return true;
+
+        case cJSON_True:
+            output = ensure(output_buffer, 5);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "true");
+            return true;
+
+        case cJSON_Number:
+            return print_number(item, output_buffer);
+
+        case cJSON_Raw:
+        {
+            size_t raw_length = 0;
+            if (item->valuestring == NULL)
+            {
+                return false;
+            }
+
+            raw_length = strlen(item->valuestring) + sizeof("");
+            output = ensure(output_buffer, raw_length);
+            if (output == NULL)
+            {
+                return false;
+            }
+            memcpy(output, item->valuestring, raw_length);
+            return true;
+        }
+
+        case cJSON_String:
+            return print_string(item, output_buffer);
+
+        case cJSON_Array:
+            return print_array(item, output_buffer);
+
+        case cJSON_Object:
+            return print_object(item, output_buffer);
+
+        default:
+            return false;
+    }
+}
+
+/* Build an array from input text. */
+static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer)
+{
+    cJSON *head = NULL; /* head of the linked list */
+    cJSON *current_item = NULL;
+
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    {
+        return false; /* to deeply nested */
+    }
+    input_buffer->depth++;
+
+    if (buffer_at_offset(input_buffer)[0] != '[')
+    {
+        /* not an array */
+        goto fail;
+    }
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ']'))
+    {
+        /* empty array */
+        goto success;
+    }
+
+    /* check if we skipped to the end of the buffer */
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        input_buffer->offset--;
+        goto fail;
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    /* loop through the comma separated array elements */
+    do
+    {
+        /* allocate next item */
+        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        if (new_item == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+
+        /* attach next item to list */
+        if (head == NULL)
+        {
+            /* start the linked list */
+            current_item = head = new_item;
+        }
+        else
+        {
+            /* add to the end and advance */
+            current_item->next = new_item;
+            new_item->prev = current_item;
+            current_item = new_item;
+        }
+
+        /* parse next value */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_value(current_item, input_buffer))
+        {
+            goto fail; /* failed to parse value */
+        }
+        buffer_skip_whitespace(input_buffer);
+    }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+
+    if (cannot_access_at_index(input_buffer, 0) || buffer_at_offset(input_buffer)[0] != ']')
+    {
+        goto fail; /* expected end of array */
+    }
+
+success:
+    input_buffer->depth--;
+
+    if (head != NULL) {
+        head->prev = current_item;
+    }
+
+    item->type = cJSON_Array;
+    item->child = head;
+
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if (head != NULL)
+    {
+        delete_item(head, &input_buffer->hooks);
+    }
+
+    return false;
+}
+
+/* Render an array to text */
+static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    size_t length = 0;
+    cJSON *current_element = item->child;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* Compose the output array. */
+    /* opening square bracket */
+    output_pointer = ensure(output_buffer, 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    *output_pointer = '[';
+    output_buffer->offset++;
+    output_buffer->depth++;
+
+    while (current_element != NULL)
+    {
+        if (!print_value(current_element, output_buffer))
+        {
+            return false;
+        }
+        update_offset(output_buffer);
+        if (current_element->next)
+        {
+            length = (size_t) (output_buffer->format ? 2 : 1);
+            output_pointer = ensure(output_buffer, length + 1);
+            if (output_pointer == NULL)
+            {
+                return false;
+            }
+            *output_pointer++ = ',';
+            if(output_buffer->format)
+            {
+                *output_pointer++ = ' ';
+            }
+            *output_pointer = '\0';
+            output_buffer->offset += length;
+        }
+        current_element = current_element->next;
+    }
+
+    output_pointer = ensure(output_buffer, 2);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    *output_pointer++ = ']';
+    *output_pointer = '\0';
+    output_buffer->depth--;
+
+    return true;
+}
+
+/* Parse the name of an object member into item->string */
+static cJSON_bool parse_key(cJSON * const item, parse_buffer * const input_buffer)
+{
+    const unsigned char *key_start = NULL;
+    const unsigned char *key_end = NULL;
+    const char *interned = NULL;
+
+    if (input_buffer->keys != NULL)
+    {
+        /* keys without escape sequences are interned straight from the input */
+        if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
+        {
+            key_start = buffer_at_offset(input_buffer) + 1;
+            for (key_end = key_start; ((size_t)(key_end - input_buffer->content) < input_buffer->length) && (*key_end != '\"') && (*key_end != '\\'); key_end++)
+            {
+            }
+            if (((size_t)(key_end - input_buffer->content) < input_buffer->length) && (*key_end == '\"'))
+            {
+                interned = intern_span(input_buffer->keys, key_start, (size_t)(key_end - key_start), &input_buffer->hooks);
+                if (interned == NULL)
+                {
+                    return false;
+                }
+                input_buffer->offset = (size_t)(key_end + 1 - input_buffer->content);
+            }
+        }
+
+        if (interned == NULL)
+        {
+            if (!parse_string(item, input_buffer))
+            {
+                return false;
+            }
+            interned = intern_span(input_buffer->keys, (const unsigned char*)item->valuestring, strlen(item->valuestring), &input_buffer->hooks);
+            if (!input_buffer->in_situ)
+            {
+                input_buffer->hooks.deallocate(item->valuestring);
+            }
+            item->valuestring = NULL;
+            if (interned == NULL)
+            {
+                return false;
+            }
+        }
+
+        /* the table owns the key */
+        item->string = (char*)cast_away_const(interned);
+        item->type = cJSON_StringIsConst;
+        return true;
+    }
+
+    if (!parse_string(item, input_buffer))
+    {
+        return false;
+    }
+
+    /* swap valuestring and string, because we parsed the name */
+    item->string = item->valuestring;
+    item->valuestring = NULL;
+    if (input_buffer->in_situ)
+    {
+        item->type = cJSON_StringIsConst;
+    }
+
+    return true;
+}
+
+/* Build an object from the text. */
+static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer)
+{
+    cJSON *head = NULL; /* linked list head */
     cJSON *current_item = NULL;
 
-    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    {
+        return false; /* to deeply nested */
+    }
+    input_buffer->depth++;
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '{'))
+    {
+        goto fail; /* not an object */
+    }
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '}'))
+    {
+        goto success; /* empty object */
+    }
+
+    /* check if we skipped to the end of the buffer */
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        input_buffer->offset--;
+        goto fail;
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    /* loop through the comma separated array elements */
+    do
+    {
+        /* allocate next item */
+        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        if (new_item == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+
+        /* attach next item to list */
+        if (head == NULL)
+        {
+            /* start the linked list */
+            current_item = head = new_item;
+        }
+        else
+        {
+            /* add to the end and advance */
+            current_item->next = new_item;
+            new_item->prev = current_item;
+            current_item = new_item;
+        }
+
+        if (cannot_access_at_index(input_buffer, 1))
+        {
+            goto fail; /* nothing comes after the comma */
+        }
+
+        /* parse the name of the child */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_key(current_item, input_buffer))
+        {
+            goto fail; /* failed to parse name */
+        }
+        buffer_skip_whitespace(input_buffer);
+
+        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+        {
+            goto fail; /* invalid object */
+        }
+
+        /* parse the value */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_value(current_item, input_buffer))
+        {
+            goto fail; /* failed to parse value */
+        }
+        if (input_buffer->in_situ || (input_buffer->keys != NULL))
+        {
+            current_item->type |= cJSON_StringIsConst;
+        }
+        buffer_skip_whitespace(input_buffer);
+    }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '}'))
+    {
+        goto fail; /* expected end of object */
+    }
+
+success:
+    input_buffer->depth--;
+
+    if (head != NULL) {
+        head->prev = current_item;
+    }
+
+    item->type = cJSON_Object;
+    item->child = head;
+
+    input_buffer->offset++;
+    return true;
+
+fail:
+    if (head != NULL)
+    {
+        delete_item(head, &input_buffer->hooks);
+    }
+
+    return false;
+}
+
+/* Render an object to text. */
+static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    size_t length = 0;
+    cJSON *current_item = item->child;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* Compose the output: */
+    length = (size_t) (output_buffer->format ? 2 : 1); /* fmt: {\n */
+    output_pointer = ensure(output_buffer, length + 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    *output_pointer++ = '{';
+    output_buffer->depth++;
+    if (output_buffer->format)
+    {
+        *output_pointer++ = '\n';
+    }
+    output_buffer->offset += length;
+
+    while (current_item)
+    {
+        if (output_buffer->format)
+        {
+            size_t i;
+            output_pointer = ensure(output_buffer, output_buffer->depth);
+            if (output_pointer == NULL)
+            {
+                return false;
+            }
+            for (i = 0; i < output_buffer->depth; i++)
+            {
+                *output_pointer++ = '\t';
+            }
+            output_buffer->offset += output_buffer->depth;
+        }
+
+        /* print key */
+        if (!print_string_ptr((unsigned char*)current_item->string, output_buffer))
+        {
+            return false;
+        }
+        update_offset(output_buffer);
+
+        length = (size_t) (output_buffer->format ? 2 : 1);
+        output_pointer = ensure(output_buffer, length);
+        if (output_pointer == NULL)
+        {
+            return false;
+        }
+        *output_pointer++ = ':';
+        if (output_buffer->format)
+        {
+            *output_pointer++ = '\t';
+        }
+        output_buffer->offset += length;
+
+        /* print value */
+        if (!print_value(current_item, output_buffer))
+        {
+            return false;
+        }
+        update_offset(output_buffer);
+
+        /* print comma if not last */
+        length = ((size_t)(output_buffer->format ? 1 : 0) + (size_t)(current_item->next ? 1 : 0));
+        output_pointer = ensure(output_buffer, length + 1);
+        if (output_pointer == NULL)
+        {
+            return false;
+        }
+        if (current_item->next)
+        {
+            *output_pointer++ = ',';
+        }
+
+        if (output_buffer->format)
+        {
+            *output_pointer++ = '\n';
+        }
+        *output_pointer = '\0';
+        output_buffer->offset += length;
+
+        current_item = current_item->next;
+    }
+
+    output_pointer = ensure(output_buffer, output_buffer->format ? (output_buffer->depth + 1) : 2);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    if (output_buffer->format)
+    {
+        size_t i;
+        for (i = 0; i < (output_buffer->depth - 1); i++)
+        {
+            *output_pointer++ = '\t';
+        }
+    }
+    *output_pointer++ = '}';
+    *output_pointer = '\0';
+    output_buffer->depth--;
+
+    return true;
+}
+
+/* Get Array size/item / object item. */
+CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
+{
+    struct cJSON_Index *index = NULL;
+    cJSON *child = NULL;
+    size_t size = 0;
+
+    if (array == NULL)
+    {
+        return 0;
+    }
+
+    index = live_index(array);
+    if ((index != NULL) && (index->items != NULL))
+    {
+        return (int)index->item_count;
+    }
+
+    child = array->child;
+
+    while(child != NULL)
+    {
+        size++;
+        child = child->next;
+    }
+
+    /* FIXME: Can overflow here. Cannot be fixed without breaking the API */
+
+    return (int)size;
+}
+
+
+static cJSON* get_array_item(const cJSON *array, size_t index)
+{
+    struct cJSON_Index *array_index = NULL;
+    cJSON *current_child = NULL;
+
+    if (array == NULL)
+    {
+        return NULL;
+    }
+
+    array_index = live_index(array);
+    if ((array_index != NULL) && (array_index->items != NULL))
+    {
+        return (index < array_index->item_count) ? array_index->items[array_index->first + index] : NULL;
+    }
+
+    current_child = array->child;
+    while ((current_child != NULL) && (index > 0))
+    {
+        index--;
+        current_child = current_child->next;
+    }
+
+    return current_child;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
+{
+    if (index < 0)
+    {
+        return NULL;
+    }
+
+    return get_array_item(array, (size_t)index);
+}
+
+static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
+{
+    struct cJSON_Index *index = NULL;
+    cJSON *current_element = NULL;
+
+    if ((object == NULL) || (name == NULL))
+    {
+        return NULL;
+    }
+
+    /* lookups only read the tree: a missing or stale index means walking the list */
+    index = live_index(object);
+    if ((index != NULL) && (index->slots != NULL))
+    {
+        return index_lookup(index, name, case_sensitive);
+    }
+
+    current_element = object->child;
+    if (case_sensitive)
+    {
+        /* interned keys are found by their address before comparing characters */
+        while ((current_element != NULL) && (current_element->string != NULL) && (current_element->string != name) && (strcmp(name, current_element->string) != 0))
+        {
+            current_element = current_element->next;
+        }
+    }
+    else
+    {
+        while ((current_element != NULL) && (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)(current_element->string)) != 0))
+        {
+            current_element = current_element->next;
+        }
+    }
+
+    if ((current_element == NULL) || (current_element->string == NULL)) {
+        return NULL;
+    }
+
+    return current_element;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string)
+{
+    return get_object_item(object, string, false);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string)
+{
+    return get_object_item(object, string, true);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string)
+{
+    return cJSON_GetObjectItem(object, string) ? 1 : 0;
+}
+
+/* Utility for array list handling. */
+static void suffix_object(cJSON *prev, cJSON *item)
+{
+    prev->next = item;
+    item->prev = prev;
+}
+
+/* Utility for handling references. */
+static cJSON *create_reference(const cJSON *item, const internal_hooks * const hooks)
+{
+    cJSON *reference = NULL;
+    if (item == NULL)
+    {
+        return NULL;
+    }
+
+    reference = cJSON_New_Item(hooks);
+    if (reference == NULL)
+    {
+        return NULL;
+    }
+
+    memcpy(reference, item, sizeof(cJSON));
+    reference->string = NULL;
+    reference->index = NULL;
+    reference->type |= cJSON_IsReference;
+    reference->next = reference->prev = NULL;
+    return reference;
+}
+
+static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
+{
+    cJSON *child = NULL;
+
+    if ((item == NULL) || (array == NULL) || (array == item))
+    {
+        return false;
+    }
+
+    child = array->child;
+    /*
+     * To find the last item in array quickly, we use prev in array
+     */
+    if (child == NULL)
+    {
+        /* list is empty, start new one */
+        array->child = item;
+        item->prev = item;
+        item->next = NULL;
+    }
+    else
+    {
+        /* append to the end */
+        if (child->prev)
+        {
+            suffix_object(child->prev, item);
+            array->child->prev = item;
+        }
+    }
+    index_append(array, item);
+
+    return true;
+}
+
+/* Add item to array/object. */
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToArray(cJSON *array, cJSON *item)
+{
+    return add_item_to_array(array, item);
+}
+
+#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
+    #pragma GCC diagnostic push
+#endif
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wcast-qual"
+#endif
+/* helper function to cast away const */
+static void* cast_away_const(const void* string)
+{
+    return (void*)string;
+}
+#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
+    #pragma GCC diagnostic pop
+#endif
+
+
+static cJSON_bool add_item_to_object(cJSON * const object, const char * const string, cJSON * const item, const internal_hooks * const hooks, const cJSON_bool constant_key)
+{
+    char *new_key = NULL;
+    int new_type = cJSON_Invalid;
+
+    if ((object == NULL) || (string == NULL) || (item == NULL) || (object == item))
+    {
+        return false;
+    }
+
+    if (constant_key)
+    {
+        new_key = (char*)cast_away_const(string);
+        new_type = item->type | cJSON_StringIsConst;
+    }
+    else
+    {
+        new_key = (char*)cJSON_strdup((const unsigned char*)string, hooks);
+        if (new_key == NULL)
+        {
+            return false;
+        }
+
+        new_type = item->type & ~cJSON_StringIsConst;
+    }
+
+    if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
+    {
+        hooks->deallocate(item->string);
+    }
+
+    item->string = new_key;
+    item->type = new_type;
+
+    return add_item_to_array(object, item);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToObject(cJSON *object, const char *string, cJSON *item)
+{
+    return add_item_to_object(object, string, item, &global_hooks, false);
+}
+
+/* Add an item to an object with constant string as key */
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToObjectCS(cJSON *object, const char *string, cJSON *item)
+{
+    return add_item_to_object(object, string, item, &global_hooks, true);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToArray(cJSON *array, cJSON *item)
+{
+    if (array == NULL)
+    {
+        return false;
+    }
+
+    return add_item_to_array(array, create_reference(item, &global_hooks));
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToObject(cJSON *object, const char *string, cJSON *item)
+{
+    if ((object == NULL) || (string == NULL))
+    {
+        return false;
+    }
+
+    return add_item_to_object(object, string, create_reference(item, &global_hooks), &global_hooks, false);
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddNullToObject(cJSON * const object, const char * const name)
+{
+    cJSON *null = cJSON_CreateNull();
+    if (add_item_to_object(object, name, null, &global_hooks, false))
+    {
+        return null;
+    }
+
+    cJSON_Delete(null);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddTrueToObject(cJSON * const object, const char * const name)
+{
+    cJSON *true_item = cJSON_CreateTrue();
+    if (add_item_to_object(object, name, true_item, &global_hooks, false))
+    {
+        return true_item;
+    }
+
+    cJSON_Delete(true_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddFalseToObject(cJSON * const object, const char * const name)
+{
+    cJSON *false_item = cJSON_CreateFalse();
+    if (add_item_to_object(object, name, false_item, &global_hooks, false))
+    {
+        return false_item;
+    }
+
+    cJSON_Delete(false_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddBoolToObject(cJSON * const object, const char * const name, const cJSON_bool boolean)
+{
+    cJSON *bool_item = cJSON_CreateBool(boolean);
+    if (add_item_to_object(object, name, bool_item, &global_hooks, false))
+    {
+        return bool_item;
+    }
+
+    cJSON_Delete(bool_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddNumberToObject(cJSON * const object, const char * const name, const double number)
+{
+    cJSON *number_item = cJSON_CreateNumber(number);
+    if (add_item_to_object(object, name, number_item, &global_hooks, false))
+    {
+        return number_item;
+    }
+
+    cJSON_Delete(number_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddStringToObject(cJSON * const object, const char * const name, const char * const string)
+{
+    cJSON *string_item = cJSON_CreateString(string);
+    if (add_item_to_object(object, name, string_item, &global_hooks, false))
+    {
+        return string_item;
+    }
+
+    cJSON_Delete(string_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddRawToObject(cJSON * const object, const char * const name, const char * const raw)
+{
+    cJSON *raw_item = cJSON_CreateRaw(raw);
+    if (add_item_to_object(object, name, raw_item, &global_hooks, false))
+    {
+        return raw_item;
+    }
+
+    cJSON_Delete(raw_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddObjectToObject(cJSON * const object, const char * const name)
+{
+    cJSON *object_item = cJSON_CreateObject();
+    if (add_item_to_object(object, name, object_item, &global_hooks, false))
+    {
+        return object_item;
+    }
+
+    cJSON_Delete(object_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddArrayToObject(cJSON * const object, const char * const name)
+{
+    cJSON *array = cJSON_CreateArray();
+    if (add_item_to_object(object, name, array, &global_hooks, false))
+    {
+        return array;
+    }
+
+    cJSON_Delete(array);
+    return NULL;
+}
+
+/* position is a guess where item is in the array, used to find it in the index quickly */
+static cJSON *detach_item(cJSON *parent, cJSON * const item, size_t position)
+{
+    if ((parent == NULL) || (item == NULL) || (item != parent->child && item->prev == NULL))
     {
-        return false; /* to deeply nested */
+        return NULL;
     }
-    input_buffer->depth++;
 
-    if (buffer_at_offset(input_buffer)[0] != '[')
+    if ((live_index(parent) != NULL) && (parent->index->items != NULL))
     {
-        /* not an array */
-        goto fail;
+        index_items_remove(parent, item, position);
     }
-
-    input_buffer->offset++;
-    buffer_skip_whitespace(input_buffer);
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ']'))
+    else if (live_index(parent) != NULL)
     {
-        /* empty array */
-        goto success;
+        index_slots_remove(parent, item);
     }
 
-    /* check if we skipped to the end of the buffer */
-    if (cannot_access_at_index(input_buffer, 0))
+    if (item != parent->child)
     {
-        input_buffer->offset--;
-        goto fail;
+        /* not the first element */
+        item->prev->next = item->next;
+    }
+    if (item->next != NULL)
+    {
+        /* not the last element */
+        item->next->prev = item->prev;
     }
 
-    /* step back to character in front of the first element */
-    input_buffer->offset--;
-    /* loop through the comma separated array elements */
-    do
+    if (item == parent->child)
     {
-        /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
-        if (new_item == NULL)
-        {
-            goto fail; /* allocation failure */
-        }
+        /* first element */
+        parent->child = item->next;
+    }
+    else if (item->next == NULL)
+    {
+        /* last element */
+        parent->child->prev = item->prev;
+    }
 
-        /* attach next item to list */
-        if (head == NULL)
-        {
-            /* start the linked list */
-            current_item = head = new_item;
-        }
-        else
-        {
-            /* add to the end and advance */
-            current_item->next = new_item;
-            new_item->prev = current_item;
-            current_item = new_item;
-        }
+    /* make sure the detached item doesn't point anywhere anymore */
+    item->prev = NULL;
+    item->next = NULL;
 
-        /* parse next value */
-        input_buffer->offset++;
-        buffer_skip_whitespace(input_buffer);
-        if (!parse_value(current_item, input_buffer))
-        {
-            goto fail; /* failed to parse value */
-        }
-        buffer_skip_whitespace(input_buffer);
-    }
-    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+    return item;
+}
 
-    if (cannot_access_at_index(input_buffer, 0) || buffer_at_offset(input_buffer)[0] != ']')
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const item)
+{
+    return detach_item(parent, item, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromArray(cJSON *array, int which)
+{
+    if (which < 0)
     {
-        goto fail; /* expected end of array */
+        return NULL;
     }
 
-success:
-    input_buffer->depth--;
+    return detach_item(array, get_array_item(array, (size_t)which), (size_t)which);
+}
 
-    if (head != NULL) {
-        head->prev = current_item;
-    }
+CJSON_PUBLIC(void) cJSON_DeleteItemFromArray(cJSON *array, int which)
+{
+    cJSON_Delete(cJSON_DetachItemFromArray(array, which));
+}
 
-    item->type = cJSON_Array;
-    item->child = head;
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromObject(cJSON *object, const char *string)
+{
+    cJSON *to_detach = cJSON_GetObjectItem(object, string);
 
-    input_buffer->offset++;
+    return cJSON_DetachItemViaPointer(object, to_detach);
+}
 
-    return true;
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromObjectCaseSensitive(cJSON *object, const char *string)
+{
+    cJSON *to_detach = cJSON_GetObjectItemCaseSensitive(object, string);
 
-fail:
-    if (head != NULL)
-    {
-        cJSON_Delete(head);
-    }
+    return cJSON_DetachItemViaPointer(object, to_detach);
+}
 
-    return false;
+CJSON_PUBLIC(void) cJSON_DeleteItemFromObject(cJSON *object, const char *string)
+{
+    cJSON_Delete(cJSON_DetachItemFromObject(object, string));
 }
 
-/* Render an array to text */
-static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer)
+CJSON_PUBLIC(void) cJSON_DeleteItemFromObjectCaseSensitive(cJSON *object, const char *string)
 {
-    unsigned char *output_pointer = NULL;
-    size_t length = 0;
-    cJSON *current_element = item->child;
+    cJSON_Delete(cJSON_DetachItemFromObjectCaseSensitive(object, string));
+}
 
-    if (output_buffer == NULL)
-    {
-        return false;
-    }
+/* Replace array/object items with new ones. */
+CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON *newitem)
+{
+    cJSON *after_inserted = NULL;
 
-    /* Compose the output array. */
-    /* opening square bracket */
-    output_pointer = ensure(output_buffer, 1);
-    if (output_pointer == NULL)
+    if (which < 0 || newitem == NULL)
     {
         return false;
     }
 
-    *output_pointer = '[';
-    output_buffer->offset++;
-    output_buffer->depth++;
-
-    while (current_element != NULL)
+    after_inserted = get_array_item(array, (size_t)which);
+    if (after_inserted == NULL)
     {
-        if (!print_value(current_element, output_buffer))
-        {
-            return false;
-        }
-        update_offset(output_buffer);
-        if (current_element->next)
-        {
-            length = (size_t) (output_buffer->format ? 2 : 1);
-            output_pointer = ensure(output_buffer, length + 1);
-            if (output_pointer == NULL)
-            {
-                return false;
-            }
-            *output_pointer++ = ',';
-            if(output_buffer->format)
-            {
-                *output_pointer++ = ' ';
-            }
-            *output_pointer = '\0';
-            output_buffer->offset += length;
-        }
-        current_element = current_element->next;
+        return add_item_to_array(array, newitem);
     }
 
-    output_pointer = ensure(output_buffer, 2);
-    if (output_pointer == NULL)
-    {
+    if (after_inserted != array->child && after_inserted->prev == NULL) {
+        /* return false if after_inserted is a corrupted array item */
         return false;
     }
-    *output_pointer++ = ']';
-    *output_pointer = '\0';
-    output_buffer->depth--;
-
-    return true;
-}
-
-/* Build an object from the text. */
-static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer)
-{
-    cJSON *head = NULL; /* linked list head */
-    cJSON *current_item = NULL;
 
-    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    if ((live_index(array) != NULL) && (array->index->items != NULL))
     {
-        return false; /* to deeply nested */
+        index_items_insert(array, (size_t)which, newitem);
     }
-    input_buffer->depth++;
-
-    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '{'))
+    else if (live_index(array) != NULL)
     {
-        goto fail; /* not an object */
+        index_slots_insert(array, newitem);
     }
 
-    input_buffer->offset++;
-    buffer_skip_whitespace(input_buffer);
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '}'))
+    newitem->next = after_inserted;
+    newitem->prev = after_inserted->prev;
+    after_inserted->prev = newitem;
+    if (after_inserted == array->child)
     {
-        goto success; /* empty object */
+        array->child = newitem;
     }
-
-    /* check if we skipped to the end of the buffer */
-    if (cannot_access_at_index(input_buffer, 0))
+    else
     {
-        input_buffer->offset--;
-        goto fail;
+        newitem->prev->next = newitem;
     }
+    return true;
+}
 
-    /* step back to character in front of the first element */
-    input_buffer->offset--;
-    /* loop through the comma separated array elements */
-    do
+static cJSON_bool replace_item(cJSON * const parent, cJSON * const item, cJSON * replacement, size_t position)
+{
+    if ((parent == NULL) || (parent->child == NULL) || (replacement == NULL) || (item == NULL))
     {
-        /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
-        if (new_item == NULL)
-        {
-            goto fail; /* allocation failure */
-        }
-
-        /* attach next item to list */
-        if (head == NULL)
-        {
-            /* start the linked list */
-            current_item = head = new_item;
-        }
-        else
-        {
-            /* add to the end and advance */
-            current_item->next = new_item;
-            new_item->prev = current_item;
-            current_item = new_item;
-        }
-
-        if (cannot_access_at_index(input_buffer, 1))
-        {
-            goto fail; /* nothing comes after the comma */
-        }
-
-        /* parse the name of the child */
-        input_buffer->offset++;
-        buffer_skip_whitespace(input_buffer);
-        if (!parse_string(current_item, input_buffer))
-        {
-            goto fail; /* failed to parse name */
-        }
-        buffer_skip_whitespace(input_buffer);
+        return false;
+    }
 
-        /* swap valuestring and string, because we parsed the name */
-        current_item->string = current_item->valuestring;
-        current_item->valuestring = NULL;
+    if (replacement == item)
+    {
+        return true;
+    }
 
-        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+    if ((live_index(parent) != NULL) && (parent->index->items != NULL))
+    {
+        position = index_items_find(parent->index, item, position);
+        if (position < parent->index->item_count)
         {
-            goto fail; /* invalid object */
+            parent->index->items[parent->index->first + position] = replacement;
         }
-
-        /* parse the value */
-        input_buffer->offset++;
-        buffer_skip_whitespace(input_buffer);
-        if (!parse_value(current_item, input_buffer))
+        else
         {
-            goto fail; /* failed to parse value */
+            parent->index->stale = true;
         }
-        buffer_skip_whitespace(input_buffer);
     }
-    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
-
-    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '}'))
+    else if (live_index(parent) != NULL)
     {
-        goto fail; /* expected end of object */
+        index_slots_replace(parent, item, replacement);
     }
 
-success:
-    input_buffer->depth--;
+    replacement->next = item->next;
+    replacement->prev = item->prev;
 
-    if (head != NULL) {
-        head->prev = current_item;
+    if (replacement->next != NULL)
+    {
+        replacement->next->prev = replacement;
+    }
+    if (parent->child == item)
+    {
+        if (parent->child->prev == parent->child)
+        {
+            replacement->prev = replacement;
+        }
+        parent->child = replacement;
+    }
+    else
+    {   /*
+         * To find the last item in array quickly, we use prev in array.
+         * We can't modify the last item's next pointer where this item was the parent's child
+         */
+        if (replacement->prev != NULL)
+        {
+            replacement->prev->next = replacement;
+        }
+        if (replacement->next == NULL)
+        {
+            parent->child->prev = replacement;
+        }
     }
 
-    item->type = cJSON_Object;
-    item->child = head;
+    item->next = NULL;
+    item->prev = NULL;
+    cJSON_Delete(item);
 
-    input_buffer->offset++;
     return true;
+}
 
-fail:
-    if (head != NULL)
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON * const item, cJSON * replacement)
+{
+    return replace_item(parent, item, replacement, 0);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON *newitem)
+{
+    if (which < 0)
     {
-        cJSON_Delete(head);
+        return false;
     }
 
-    return false;
+    return replace_item(array, get_array_item(array, (size_t)which), newitem, (size_t)which);
 }
 
-/* Render an object to text. */
-static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer)
+static cJSON_bool replace_item_in_object(cJSON *object, const char *string, cJSON *replacement, cJSON_bool case_sensitive)
 {
-    unsigned char *output_pointer = NULL;
-    size_t length = 0;
-    cJSON *current_item = item->child;
-
-    if (output_buffer == NULL)
+    if ((replacement == NULL) || (string == NULL))
     {
         return false;
     }
 
-    /* Compose the output: */
-    length = (size_t) (output_buffer->format ? 2 : 1); /* fmt: {\n */
-    output_pointer = ensure(output_buffer, length + 1);
-    if (output_pointer == NULL)
+    /* replace the name in the replacement */
+    if (!(replacement->type & cJSON_StringIsConst) && (replacement->string != NULL))
+    {
+        cJSON_free(replacement->string);
+    }
+    replacement->string = (char*)cJSON_strdup((const unsigned char*)string, &global_hooks);
+    if (replacement->string == NULL)
     {
         return false;
     }
 
-    *output_pointer++ = '{';
-    output_buffer->depth++;
-    if (output_buffer->format)
+    replacement->type &= ~cJSON_StringIsConst;
+
+    return cJSON_ReplaceItemViaPointer(object, get_object_item(object, string, case_sensitive), replacement);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInObject(cJSON *object, const char *string, cJSON *newitem)
+{
+    return replace_item_in_object(object, string, newitem, false);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInObjectCaseSensitive(cJSON *object, const char *string, cJSON *newitem)
+{
+    return replace_item_in_object(object, string, newitem, true);
+}
+
+/* Create basic types: */
+CJSON_PUBLIC(cJSON *) cJSON_CreateNull(void)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
     {
-        *output_pointer++ = '\n';
+        item->type = cJSON_NULL;
     }
-    output_buffer->offset += length;
 
-    while (current_item)
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateTrue(void)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
     {
-        if (output_buffer->format)
-        {
-            size_t i;
-            output_pointer = ensure(output_buffer, output_buffer->depth);
-            if (output_pointer == NULL)
-            {
-                return false;
-            }
-            for (i = 0; i < output_buffer->depth; i++)
-            {
-                *output_pointer++ = '\t';
-            }
-            output_buffer->offset += output_buffer->depth;
-        }
+        item->type = cJSON_True;
+    }
 
-        /* print key */
-        if (!print_string_ptr((unsigned char*)current_item->string, output_buffer))
-        {
-            return false;
-        }
-        update_offset(output_buffer);
+    return item;
+}
 
-        length = (size_t) (output_buffer->format ? 2 : 1);
-        output_pointer = ensure(output_buffer, length);
-        if (output_pointer == NULL)
-        {
-            return false;
-        }
-        *output_pointer++ = ':';
-        if (output_buffer->format)
-        {
-            *output_pointer++ = '\t';
-        }
-        output_buffer->offset += length;
+CJSON_PUBLIC(cJSON *) cJSON_CreateFalse(void)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = cJSON_False;
+    }
 
-        /* print value */
-        if (!print_value(current_item, output_buffer))
-        {
-            return false;
-        }
-        update_offset(output_buffer);
+    return item;
+}
 
-        /* print comma if not last */
-        length = ((size_t)(output_buffer->format ? 1 : 0) + (size_t)(current_item->next ? 1 : 0));
-        output_pointer = ensure(output_buffer, length + 1);
-        if (output_pointer == NULL)
+CJSON_PUBLIC(cJSON *) cJSON_CreateBool(cJSON_bool boolean)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = boolean ? cJSON_True : cJSON_False;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateNumber(double num)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = cJSON_Number;
+        item->valuedouble = num;
+
+        /* use saturation in case of overflow */
+        if (num >= INT_MAX)
         {
-            return false;
+            item->valueint = INT_MAX;
         }
-        if (current_item->next)
+        else if (num <= (double)INT_MIN)
         {
-            *output_pointer++ = ',';
+            item->valueint = INT_MIN;
         }
-
-        if (output_buffer->format)
+        else
         {
-            *output_pointer++ = '\n';
+            item->valueint = (int)num;
         }
-        *output_pointer = '\0';
-        output_buffer->offset += length;
-
-        current_item = current_item->next;
     }
 
-    output_pointer = ensure(output_buffer, output_buffer->format ? (output_buffer->depth + 1) : 2);
-    if (output_pointer == NULL)
-    {
-        return false;
-    }
-    if (output_buffer->format)
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateString(const char *string)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
     {
-        size_t i;
-        for (i = 0; i < (output_buffer->depth - 1); i++)
+        item->type = cJSON_String;
+        item->valuestring = (char*)cJSON_strdup((const unsigned char*)string, &global_hooks);
+        if(!item->valuestring)
         {
-            *output_pointer++ = '\t';
+            cJSON_Delete(item);
+            return NULL;
         }
     }
-    *output_pointer++ = '}';
-    *output_pointer = '\0';
-    output_buffer->depth--;
 
-    return true;
+    return item;
 }
 
-/* Get Array size/item / object item. */
-CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
+CJSON_PUBLIC(cJSON *) cJSON_CreateStringReference(const char *string)
 {
-    cJSON *child = NULL;
-    size_t size = 0;
-
-    if (array == NULL)
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if (item != NULL)
     {
-        return 0;
+        item->type = cJSON_String | cJSON_IsReference;
+        item->valuestring = (char*)cast_away_const(string);
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateObjectReference(const cJSON *child)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if (item != NULL) {
+        item->type = cJSON_Object | cJSON_IsReference;
+        item->child = (cJSON*)cast_away_const(child);
     }
 
-    child = array->child;
+    return item;
+}
 
-    while(child != NULL)
-    {
-        size++;
-        child = child->next;
+CJSON_PUBLIC(cJSON *) cJSON_CreateArrayReference(const cJSON *child) {
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if (item != NULL) {
+        item->type = cJSON_Array | cJSON_IsReference;
+        item->child = (cJSON*)cast_away_const(child);
     }
 
-    /* FIXME: Can overflow here. Cannot be fixed without breaking the API */
-
-    return (int)size;
+    return item;
 }
 
-static cJSON* get_array_item(const cJSON *array, size_t index)
+CJSON_PUBLIC(cJSON *) cJSON_CreateRaw(const char *raw)
 {
-    cJSON *current_child = NULL;
-
-    if (array == NULL)
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
     {
-        return NULL;
+        item->type = cJSON_Raw;
+        item->valuestring = (char*)cJSON_strdup((const unsigned char*)raw, &global_hooks);
+        if(!item->valuestring)
+        {
+            cJSON_Delete(item);
+            return NULL;
+        }
     }
 
-    current_child = array->child;
-    while ((current_child != NULL) && (index > 0))
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateArray(void)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
     {
-        index--;
-        current_child = current_child->next;
+        item->type=cJSON_Array;
     }
 
-    return current_child;
+    return item;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
+CJSON_PUBLIC(cJSON *) cJSON_CreateObject(void)
 {
-    if (index < 0)
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if (item)
     {
-        return NULL;
+        item->type = cJSON_Object;
     }
 
-    return get_array_item(array, (size_t)index);
+    return item;
 }
 
-static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
+/* Create Arrays: */
+CJSON_PUBLIC(cJSON *) cJSON_CreateIntArray(const int *numbers, int count)
 {
-    cJSON *current_element = NULL;
+    size_t i = 0;
+    cJSON *n = NULL;
+    cJSON *p = NULL;
+    cJSON *a = NULL;
 
-    if ((object == NULL) || (name == NULL))
+    if ((count < 0) || (numbers == NULL))
     {
         return NULL;
     }
 
-    current_element = object->child;
-    if (case_sensitive)
+    a = cJSON_CreateArray();
+
+    for(i = 0; a && (i < (size_t)count); i++)
     {
-        while ((current_element != NULL) && (current_element->string != NULL) && (strcmp(name, current_element->string) != 0))
+        n = cJSON_CreateNumber(numbers[i]);
+        if (!n)
         {
-            current_element = current_element->next;
+            cJSON_Delete(a);
+            return NULL;
         }
-    }
-    else
-    {
-        while ((current_element != NULL) && (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)(current_element->string)) != 0))
+        if(!i)
         {
-            current_element = current_element->next;
+            a->child = n;
+        }
+        else
+        {
+            suffix_object(p, n);
         }
+        p = n;
     }
 
-    if ((current_element == NULL) || (current_element->string == NULL)) {
-        return NULL;
+    if (a && a->child) {
+        a->child->prev = n;
     }
 
-    return current_element;
-}
-
-CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string)
-{
-    return get_object_item(object, string, false);
-}
-
-CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string)
-{
-    return get_object_item(object, string, true);
-}
-
-CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string)
-{
-    return cJSON_GetObjectItem(object, string) ? 1 : 0;
+    return a;
 }
 
-/* Utility for array list handling. */
-static void suffix_object(cJSON *prev, cJSON *item)
+CJSON_PUBLIC(cJSON *) cJSON_CreateFloatArray(const float *numbers, int count)
 {
-    prev->next = item;
-    item->prev = prev;
-}
+    size_t i = 0;
+    cJSON *n = NULL;
+    cJSON *p = NULL;
+    cJSON *a = NULL;
 
-/* Utility for handling references. */
-static cJSON *create_reference(const cJSON *item, const internal_hooks * const hooks)
-{
-    cJSON *reference = NULL;
-    if (item == NULL)
+    if ((count < 0) || (numbers == NULL))
     {
         return NULL;
     }
 
-    reference = cJSON_New_Item(hooks);
-    if (reference == NULL)
+    a = cJSON_CreateArray();
+
+    for(i = 0; a && (i < (size_t)count); i++)
     {
-        return NULL;
+        n = cJSON_CreateNumber((double)numbers[i]);
+        if(!n)
+        {
+            cJSON_Delete(a);
+            return NULL;
+        }
+        if(!i)
+        {
+            a->child = n;
+        }
+        else
+        {
+            suffix_object(p, n);
+        }
+        p = n;
     }
 
-    memcpy(reference, item, sizeof(cJSON));
-    reference->string = NULL;
-    reference->type |= cJSON_IsReference;
-    reference->next = reference->prev = NULL;
-    return reference;
+    if (a && a->child) {
+        a->child->prev = n;
+    }
+
+    return a;
 }
 
-static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
+CJSON_PUBLIC(cJSON *) cJSON_CreateDoubleArray(const double *numbers, int count)
 {
-    cJSON *child = NULL;
+    size_t i = 0;
+    cJSON *n = NULL;
+    cJSON *p = NULL;
+    cJSON *a = NULL;
 
-    if ((item == NULL) || (array == NULL) || (array == item))
+    if ((count < 0) || (numbers == NULL))
     {
-        return false;
+        return NULL;
     }
 
-    child = array->child;
-    /*
-     * To find the last item in array quickly, we use prev in array
-     */
-    if (child == NULL)
-    {
-        /* list is empty, start new one */
-        array->child = item;
-        item->prev = item;
-        item->next = NULL;
-    }
-    else
+    a = cJSON_CreateArray();
+
+    for(i = 0; a && (i < (size_t)count); i++)
     {
-        /* append to the end */
-        if (child->prev)
+        n = cJSON_CreateNumber(numbers[i]);
+        if(!n)
         {
-            suffix_object(child->prev, item);
-            array->child->prev = item;
+            cJSON_Delete(a);
+            return NULL;
+        }
+        if(!i)
+        {
+            a->child = n;
+        }
+        else
+        {
+            suffix_object(p, n);
         }
+        p = n;
     }
 
-    return true;
-}
-
-/* Add item to array/object. */
-CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToArray(cJSON *array, cJSON *item)
-{
-    return add_item_to_array(array, item);
-}
+    if (a && a->child) {
+        a->child->prev = n;
+    }
 
-#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
-    #pragma GCC diagnostic push
-#endif
-#ifdef __GNUC__
-#pragma GCC diagnostic ignored "-Wcast-qual"
-#endif
-/* helper function to cast away const */
-static void* cast_away_const(const void* string)
-{
-    return (void*)string;
+    return a;
 }
-#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
-    #pragma GCC diagnostic pop
-#endif
-
 
-static cJSON_bool add_item_to_object(cJSON * const object, const char * const string, cJSON * const item, const internal_hooks * const hooks, const cJSON_bool constant_key)
+CJSON_PUBLIC(cJSON *) cJSON_CreateStringArray(const char *const *strings, int count)
 {
-    char *new_key = NULL;
-    int new_type = cJSON_Invalid;
+    size_t i = 0;
+    cJSON *n = NULL;
+    cJSON *p = NULL;
+    cJSON *a = NULL;
 
-    if ((object == NULL) || (string == NULL) || (item == NULL) || (object == item))
+    if ((count < 0) || (strings == NULL))
     {
-        return false;
+        return NULL;
     }
 
-    if (constant_key)
-    {
-        new_key = (char*)cast_away_const(string);
-        new_type = item->type | cJSON_StringIsConst;
-    }
-    else
+    a = cJSON_CreateArray();
+
+    for (i = 0; a && (i < (size_t)count); i++)
     {
-        new_key = (char*)cJSON_strdup((const unsigned char*)string, hooks);
-        if (new_key == NULL)
+        n = cJSON_CreateString(strings[i]);
+        if(!n)
+        {
+            cJSON_Delete(a);
+            return NULL;
+        }
+        if(!i)
+        {
+            a->child = n;
+        }
+        else
         {
-            return false;
+            suffix_object(p,n);
         }
-
-        new_type = item->type & ~cJSON_StringIsConst;
+        p = n;
     }
 
-    if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
-    {
-        hooks->deallocate(item->string);
+    if (a && a->child) {
+        a->child->prev = n;
     }
 
-    item->string = new_key;
-    item->type = new_type;
-
-    return add_item_to_array(object, item);
+    return a;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToObject(cJSON *object, const char *string, cJSON *item)
-{
-    return add_item_to_object(object, string, item, &global_hooks, false);
-}
+/* Duplication */
+cJSON * cJSON_Duplicate_rec(const cJSON *item, size_t depth, cJSON_bool recurse);
 
-/* Add an item to an object with constant string as key */
-CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToObjectCS(cJSON *object, const char *string, cJSON *item)
+CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
 {
-    return add_item_to_object(object, string, item, &global_hooks, true);
+    return cJSON_Duplicate_rec(item, 0, recurse );
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToArray(cJSON *array, cJSON *item)
+cJSON * cJSON_Duplicate_rec(const cJSON *item, size_t depth, cJSON_bool recurse)
 {
-    if (array == NULL)
+    cJSON *newitem = NULL;
+    cJSON *child = NULL;
+    cJSON *next = NULL;
+    cJSON *newchild = NULL;
+
+    /* Bail on bad ptr */
+    if (!item)
     {
-        return false;
+        goto fail;
     }
-
-    return add_item_to_array(array, create_reference(item, &global_hooks));
-}
-
-CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToObject(cJSON *object, const char *string, cJSON *item)
-{
-    if ((object == NULL) || (string == NULL))
+    /* Create new item */
+    newitem = cJSON_New_Item(&global_hooks);
+    if (!newitem)
     {
-        return false;
+        goto fail;
     }
-
-    return add_item_to_object(object, string, create_reference(item, &global_hooks), &global_hooks, false);
-}
-
-CJSON_PUBLIC(cJSON*) cJSON_AddNullToObject(cJSON * const object, const char * const name)
-{
-    cJSON *null = cJSON_CreateNull();
-    if (add_item_to_object(object, name, null, &global_hooks, false))
+    /* Copy over all vars */
+    newitem->type = item->type & (~cJSON_IsReference);
+    newitem->valueint = item->valueint;
+    newitem->valuedouble = item->valuedouble;
+    if (item->valuestring)
     {
-        return null;
+        newitem->valuestring = (char*)cJSON_strdup((unsigned char*)item->valuestring, &global_hooks);
+        if (!newitem->valuestring)
+        {
+            goto fail;
+        }
     }
-
-    cJSON_Delete(null);
-    return NULL;
-}
-
-CJSON_PUBLIC(cJSON*) cJSON_AddTrueToObject(cJSON * const object, const char * const name)
-{
-    cJSON *true_item = cJSON_CreateTrue();
-    if (add_item_to_object(object, name, true_item, &global_hooks, false))
+    if (item->string)
     {
-        return true_item;
+        newitem->string = (item->type&cJSON_StringIsConst) ? item->string : (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
+        if (!newitem->string)
+        {
+            goto fail;
+        }
     }
-
-    cJSON_Delete(true_item);
-    return NULL;
-}
-
-CJSON_PUBLIC(cJSON*) cJSON_AddFalseToObject(cJSON * const object, const char * const name)
-{
-    cJSON *false_item = cJSON_CreateFalse();
-    if (add_item_to_object(object, name, false_item, &global_hooks, false))
+    /* If non-recursive, then we're done! */
+    if (!recurse)
     {
-        return false_item;
+        return newitem;
+    }
+    /* Walk the ->next chain for the child. */
+    child = item->child;
+    while (child != NULL)
+    {
+        if(depth >= CJSON_CIRCULAR_LIMIT) {
+            goto fail;
+        }
+        newchild = cJSON_Duplicate_rec(child, depth + 1, true); /* Duplicate (with recurse) each item in the ->next chain */
+        if (!newchild)
+        {
+            goto fail;
+        }
+        if (next != NULL)
+        {
+            /* If newitem->child already set, then crosswire ->prev and ->next and move on */
+            next->next = newchild;
+            newchild->prev = next;
+            next = newchild;
+        }
+        else
+        {
+            /* Set newitem->child and move to it */
+            newitem->child = newchild;
+            next = newchild;
+        }
+        child = child->next;
+    }
+    if (newitem && newitem->child)
+    {
+        newitem->child->prev = newchild;
     }
 
-    cJSON_Delete(false_item);
-    return NULL;
-}
+    return newitem;
 
-CJSON_PUBLIC(cJSON*) cJSON_AddBoolToObject(cJSON * const object, const char * const name, const cJSON_bool boolean)
-{
-    cJSON *bool_item = cJSON_CreateBool(boolean);
-    if (add_item_to_object(object, name, bool_item, &global_hooks, false))
+fail:
+    if (newitem != NULL)
     {
-        return bool_item;
+        cJSON_Delete(newitem);
     }
 
-    cJSON_Delete(bool_item);
     return NULL;
 }
 
-CJSON_PUBLIC(cJSON*) cJSON_AddNumberToObject(cJSON * const object, const char * const name, const double number)
+static void skip_oneline_comment(char **input)
 {
-    cJSON *number_item = cJSON_CreateNumber(number);
-    if (add_item_to_object(object, name, number_item, &global_hooks, false))
+    *input += static_strlen("//");
+
+    for (; (*input)[0] != '\0'; ++(*input))
     {
-        return number_item;
+        if ((*input)[0] == '\n') {
+            *input += static_strlen("\n");
+            return;
+        }
     }
-
-    cJSON_Delete(number_item);
-    return NULL;
 }
 
-CJSON_PUBLIC(cJSON*) cJSON_AddStringToObject(cJSON * const object, const char * const name, const char * const string)
+static void skip_multiline_comment(char **input)
 {
-    cJSON *string_item = cJSON_CreateString(string);
-    if (add_item_to_object(object, name, string_item, &global_hooks, false))
+    *input += static_strlen("/*");
+
+    for (; (*input)[0] != '\0'; ++(*input))
     {
-        return string_item;
+        if (((*input)[0] == '*') && ((*input)[1] == '/'))
+        {
+            *input += static_strlen("*/");
+            return;
+        }
     }
+}
 
-    cJSON_Delete(string_item);
-    return NULL;
+static void minify_string(char **input, char **output) {
+    (*output)[0] = (*input)[0];
+    *input += static_strlen("\"");
+    *output += static_strlen("\"");
+
+
+    for (; (*input)[0] != '\0'; (void)++(*input), ++(*output)) {
+        (*output)[0] = (*input)[0];
+
+        if ((*input)[0] == '\"') {
+            (*output)[0] = '\"';
+            *input += static_strlen("\"");
+            *output += static_strlen("\"");
+            return;
+        } else if (((*input)[0] == '\\') && ((*input)[1] == '\"')) {
+            (*output)[1] = (*input)[1];
+            *input += static_strlen("\"");
+            *output += static_strlen("\"");
+        }
+    }
 }
 
-CJSON_PUBLIC(cJSON*) cJSON_AddRawToObject(cJSON * const object, const char * const name, const char * const raw)
+CJSON_PUBLIC(void) cJSON_Minify(char *json)
 {
-    cJSON *raw_item = cJSON_CreateRaw(raw);
-    if (add_item_to_object(object, name, raw_item, &global_hooks, false))
+    char *into = json;
+
+    if (json == NULL)
     {
-        return raw_item;
+        return;
     }
 
-    cJSON_Delete(raw_item);
-    return NULL;
-}
-
-CJSON_PUBLIC(cJSON*) cJSON_AddObjectToObject(cJSON * const object, const char * const name)
-{
-    cJSON *object_item = cJSON_CreateObject();
-    if (add_item_to_object(object, name, object_item, &global_hooks, false))
+    while (json[0] != '\0')
     {
-        return object_item;
+        switch (json[0])
+        {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                json++;
+                break;
+
+            case '/':
+                if (json[1] == '/')
+                {
+                    skip_oneline_comment(&json);
+                }
+                else if (json[1] == '*')
+                {
+                    skip_multiline_comment(&json);
+                } else {
+                    json++;
+                }
+                break;
+
+            case '\"':
+                minify_string(&json, (char**)&into);
+                break;
+
+            default:
+                into[0] = json[0];
+                json++;
+                into++;
+        }
     }
 
-    cJSON_Delete(object_item);
-    return NULL;
+    /* and null-terminate. */
+    *into = '\0';
 }
 
-CJSON_PUBLIC(cJSON*) cJSON_AddArrayToObject(cJSON * const object, const char * const name)
+CJSON_PUBLIC(cJSON_bool) cJSON_IsInvalid(const cJSON * const item)
 {
-    cJSON *array = cJSON_CreateArray();
-    if (add_item_to_object(object, name, array, &global_hooks, false))
+    if (item == NULL)
     {
-        return array;
+        return false;
     }
 
-    cJSON_Delete(array);
-    return NULL;
+    return (item->type & 0xFF) == cJSON_Invalid;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const item)
+CJSON_PUBLIC(cJSON_bool) cJSON_IsFalse(const cJSON * const item)
 {
-    if ((parent == NULL) || (item == NULL) || (item != parent->child && item->prev == NULL))
+    if (item == NULL)
     {
-        return NULL;
+        return false;
     }
 
-    if (item != parent->child)
-    {
-        /* not the first element */
-        item->prev->next = item->next;
-    }
-    if (item->next != NULL)
-    {
-        /* not the last element */
-        item->next->prev = item->prev;
-    }
+    return (item->type & 0xFF) == cJSON_False;
+}
 
-    if (item == parent->child)
-    {
-        /* first element */
-        parent->child = item->next;
-    }
-    else if (item->next == NULL)
+CJSON_PUBLIC(cJSON_bool) cJSON_IsTrue(const cJSON * const item)
+{
+    if (item == NULL)
     {
-        /* last element */
-        parent->child->prev = item->prev;
+        return false;
     }
 
-    /* make sure the detached item doesn't point anywhere anymore */
-    item->prev = NULL;
-    item->next = NULL;
-
-    return item;
+    return (item->type & 0xff) == cJSON_True;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromArray(cJSON *array, int which)
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IsBool(const cJSON * const item)
 {
-    if (which < 0)
+    if (item == NULL)
     {
-        return NULL;
+        return false;
     }
 
-    return cJSON_DetachItemViaPointer(array, get_array_item(array, (size_t)which));
+    return (item->type & (cJSON_True | cJSON_False)) != 0;
 }
-
-CJSON_PUBLIC(void) cJSON_DeleteItemFromArray(cJSON *array, int which)
+CJSON_PUBLIC(cJSON_bool) cJSON_IsNull(const cJSON * const item)
 {
-    cJSON_Delete(cJSON_DetachItemFromArray(array, which));
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return (item->type & 0xFF) == cJSON_NULL;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromObject(cJSON *object, const char *string)
+CJSON_PUBLIC(cJSON_bool) cJSON_IsNumber(const cJSON * const item)
 {
-    cJSON *to_detach = cJSON_GetObjectItem(object, string);
+    if (item == NULL)
+    {
+        return false;
+    }
 
-    return cJSON_DetachItemViaPointer(object, to_detach);
+    return (item->type & 0xFF) == cJSON_Number;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromObjectCaseSensitive(cJSON *object, const char *string)
+CJSON_PUBLIC(cJSON_bool) cJSON_IsString(const cJSON * const item)
 {
-    cJSON *to_detach = cJSON_GetObjectItemCaseSensitive(object, string);
+    if (item == NULL)
+    {
+        return false;
+    }
 
-    return cJSON_DetachItemViaPointer(object, to_detach);
+    return (item->type & 0xFF) == cJSON_String;
 }
 
-CJSON_PUBLIC(void) cJSON_DeleteItemFromObject(cJSON *object, const char *string)
+CJSON_PUBLIC(cJSON_bool) cJSON_IsArray(const cJSON * const item)
 {
-    cJSON_Delete(cJSON_DetachItemFromObject(object, string));
-}
+    if (item == NULL)
+    {
+        return false;
+    }
 
-CJSON_PUBLIC(void) cJSON_DeleteItemFromObjectCaseSensitive(cJSON *object, const char *string)
-{
-    cJSON_Delete(cJSON_DetachItemFromObjectCaseSensitive(object, string));
+    return (item->type & 0xFF) == cJSON_Array;
 }
 
-/* Replace array/object items with new ones. */
-CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON *newitem)
+CJSON_PUBLIC(cJSON_bool) cJSON_IsObject(const cJSON * const item)
 {
-    cJSON *after_inserted = NULL;
-
-    if (which < 0 || newitem == NULL)
+    if (item == NULL)
     {
         return false;
     }
 
-    after_inserted = get_array_item(array, (size_t)which);
-    if (after_inserted == NULL)
-    {
-        return add_item_to_array(array, newitem);
-    }
+    return (item->type & 0xFF) == cJSON_Object;
+}
 
-    if (after_inserted != array->child && after_inserted->prev == NULL) {
-        /* return false if after_inserted is a corrupted array item */
+CJSON_PUBLIC(cJSON_bool) cJSON_IsRaw(const cJSON * const item)
+{
+    if (item == NULL)
+    {
         return false;
     }
 
-    newitem->next = after_inserted;
-    newitem->prev = after_inserted->prev;
-    after_inserted->prev = newitem;
-    if (after_inserted == array->child)
-    {
-        array->child = newitem;
-    }
-    else
-    {
-        newitem->prev->next = newitem;
-    }
-    return true;
+    return (item->type & 0xFF) == cJSON_Raw;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON * const item, cJSON * replacement)
+CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * const b, const cJSON_bool case_sensitive)
 {
-    if ((parent == NULL) || (parent->child == NULL) || (replacement == NULL) || (item == NULL))
+    if ((a == NULL) || (b == NULL) || ((a->type & 0xFF) != (b->type & 0xFF)))
     {
         return false;
     }
 
-    if (replacement == item)
+    /* check if type is valid */
+    switch (a->type & 0xFF)
     {
-        return true;
-    }
+        case cJSON_False:
+        case cJSON_True:
+        case cJSON_NULL:
+        case cJSON_Number:
+        case cJSON_String:
+        case cJSON_Raw:
+        case cJSON_Array:
+        case cJSON_Object:
+            break;
 
-    replacement->next = item->next;
-    replacement->prev = item->prev;
+        default:
+            return false;
+    }
 
-    if (replacement->next != NULL)
+    /* identical objects are equal */
+    if (a == b)
     {
-        replacement->next->prev = replacement;
+        return true;
     }
-    if (parent->child == item)
+
+    switch (a->type & 0xFF)
     {
-        if (parent->child->prev == parent->child)
-        {
-            replacement->prev = replacement;
-        }
-        parent->child = replacement;
-    }
-    else
-    {   /*
-         * To find the last item in array quickly, we use prev in array.
-         * We can't modify the last item's next pointer where this item was the parent's child
-         */
-        if (replacement->prev != NULL)
+        /* in these cases and equal type is enough */
+        case cJSON_False:
+        case cJSON_True:
+        case cJSON_NULL:
+            return true;
+
+        case cJSON_Number:
+            if (compare_double(a->valuedouble, b->valuedouble))
+            {
+                return true;
+            }
+            return false;
+
+        case cJSON_String:
+        case cJSON_Raw:
+            if ((a->valuestring == NULL) || (b->valuestring == NULL))
+            {
+                return false;
+            }
+            if (strcmp(a->valuestring, b->valuestring) == 0)
+            {
+                return true;
+            }
+
+            return false;
+
+        case cJSON_Array:
         {
-            replacement->prev->next = replacement;
+            cJSON *a_element = a->child;
+            cJSON *b_element = b->child;
+
+            for (; (a_element != NULL) && (b_element != NULL);)
+            {
+                if (!cJSON_Compare(a_element, b_element, case_sensitive))
+                {
+                    return false;
+                }
+
+                a_element = a_element->next;
+                b_element = b_element->next;
+            }
+
+            /* one of the arrays is longer than the other */
+            if (a_element != b_element) {
+                return false;
+            }
+
+            return true;
         }
-        if (replacement->next == NULL)
+
+        case cJSON_Object:
         {
-            parent->child->prev = replacement;
-        }
-    }
+            cJSON *a_element = NULL;
+            cJSON *b_element = NULL;
+            cJSON_ArrayForEach(a_element, a)
+            {
+                /* TODO This has O(n^2) runtime, which is horrible! */
+                b_element = get_object_item(b, a_element->string, case_sensitive);
+                if (b_element == NULL)
+                {
+                    return false;
+                }
 
-    item->next = NULL;
-    item->prev = NULL;
-    cJSON_Delete(item);
+                if (!cJSON_Compare(a_element, b_element, case_sensitive))
+                {
+                    return false;
+                }
+            }
 
-    return true;
-}
+            /* doing this twice, once on a and b to prevent true comparison if a subset of b
+             * TODO: Do this the proper way, this is just a fix for now */
+            cJSON_ArrayForEach(b_element, b)
+            {
+                a_element = get_object_item(a, b_element->string, case_sensitive);
+                if (a_element == NULL)
+                {
+                    return false;
+                }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON *newitem)
-{
-    if (which < 0)
-    {
-        return false;
-    }
+                if (!cJSON_Compare(b_element, a_element, case_sensitive))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
 
-    return cJSON_ReplaceItemViaPointer(array, get_array_item(array, (size_t)which), newitem);
+        default:
+            return false;
+    }
 }
 
-static cJSON_bool replace_item_in_object(cJSON *object, const char *string, cJSON *replacement, cJSON_bool case_sensitive)
+/* Incremental parsing: the input is pushed in chunks and parsed byte by byte with an explicit stack. */
+typedef struct
 {
-    if ((replacement == NULL) || (string == NULL))
-    {
-        return false;
-    }
+    char *copy; /* the path with '/' replaced by '\0' */
+    char **segments;
+    size_t segment_count;
+    cJSON *value;
+    cJSON_bool found; /* the value has started */
+    cJSON_bool complete; /* the value has been read completely */
+} stream_path;
 
-    /* replace the name in the replacement */
-    if (!(replacement->type & cJSON_StringIsConst) && (replacement->string != NULL))
-    {
-        cJSON_free(replacement->string);
-    }
-    replacement->string = (char*)cJSON_strdup((const unsigned char*)string, &global_hooks);
-    if (replacement->string == NULL)
+typedef struct
+{
+    cJSON *container; /* NULL if the container is only scanned */
+    size_t depth; /* number of path segments that lead to this container */
+    size_t index; /* position of the next element */
+    unsigned int alive; /* paths that can still match below this container */
+    unsigned int completes; /* paths whose value is this container */
+    unsigned char type; /* '[' or '{' */
+} stream_frame;
+
+typedef enum
+{
+    STREAM_VALUE,
+    STREAM_FIRST_VALUE_OR_END,
+    STREAM_FIRST_KEY_OR_END,
+    STREAM_KEY,
+    STREAM_COLON,
+    STREAM_AFTER_VALUE,
+    STREAM_STRING,
+    STREAM_NUMBER,
+    STREAM_LITERAL,
+    STREAM_DONE,
+    STREAM_ERROR
+} stream_state;
+
+struct cJSON_Stream
+{
+    internal_hooks hooks;
+    stream_state state;
+    size_t consumed; /* bytes fed so far */
+    size_t error_offset;
+
+    stream_frame *frames;
+    size_t frame_count;
+    size_t frame_capacity;
+
+    stream_path paths[CJSON_STREAM_MAX_PATHS];
+    size_t path_count;
+    cJSON *root;
+
+    /* the string, number or literal that is being read */
+    unsigned char *token;
+    size_t token_length;
+    size_t token_capacity;
+    cJSON_bool token_is_key;
+    cJSON_bool keep_token;
+    cJSON_bool escaped;
+    cJSON_bool escape_pending; /* a backslash whose escape character hasn't been read yet */
+    unsigned char unicode[12]; /* the \uXXXX (or surrogate pair \uXXXX\uXXXX) escape being read */
+    size_t unicode_length; /* 0 outside of one */
+    const char *literal;
+    size_t literal_position;
+
+    /* where the value that is being read goes */
+    char *key;
+    unsigned int value_matches; /* paths whose value this is */
+    unsigned int value_alive; /* paths that continue below this value */
+    cJSON_bool value_materialize;
+};
+
+static cJSON_Stream *create_stream(const internal_hooks * const hooks)
+{
+    cJSON_Stream *stream = (cJSON_Stream*)hooks->allocate(sizeof(cJSON_Stream));
+    if (stream != NULL)
     {
-        return false;
+        memset(stream, '\0', sizeof(cJSON_Stream));
+        stream->hooks = *hooks;
+        stream->state = STREAM_VALUE;
     }
 
-    replacement->type &= ~cJSON_StringIsConst;
-
-    return cJSON_ReplaceItemViaPointer(object, get_object_item(object, string, case_sensitive), replacement);
+    return stream;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInObject(cJSON *object, const char *string, cJSON *newitem)
+CJSON_PUBLIC(cJSON_Stream *) cJSON_CreateStream(void)
 {
-    return replace_item_in_object(object, string, newitem, false);
+    return create_stream(&global_hooks);
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInObjectCaseSensitive(cJSON *object, const char *string, cJSON *newitem)
+CJSON_PUBLIC(cJSON_Stream *) cJSON_CreateStreamWithContext(cJSON_Context *context)
 {
-    return replace_item_in_object(object, string, newitem, true);
+    return create_stream((context != NULL) ? &context->hooks : &global_hooks);
 }
 
-/* Create basic types: */
-CJSON_PUBLIC(cJSON *) cJSON_CreateNull(void)
+CJSON_PUBLIC(int) cJSON_StreamAddPath(cJSON_Stream *stream, const char *path)
 {
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if(item)
+    stream_path *new_path = NULL;
+    size_t segment_count = 1;
+    size_t i = 0;
+    char *segment = NULL;
+
+    if ((stream == NULL) || (path == NULL) || (stream->consumed > 0) || (stream->state != STREAM_VALUE))
     {
-        item->type = cJSON_NULL;
+        return -1;
     }
 
-    return item;
-}
-
-CJSON_PUBLIC(cJSON *) cJSON_CreateTrue(void)
-{
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if(item)
+    for (i = 0; i < stream->path_count; i++)
     {
-        item->type = cJSON_True;
+        if (strcmp(stream->paths[i].copy, path) == 0)
+        {
+            return (int)i;
+        }
     }
-
-    return item;
-}
-
-CJSON_PUBLIC(cJSON *) cJSON_CreateFalse(void)
-{
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if(item)
+    if (stream->path_count >= CJSON_STREAM_MAX_PATHS)
     {
-        item->type = cJSON_False;
+        return -1;
     }
 
-    return item;
-}
+    new_path = &stream->paths[stream->path_count];
+    new_path->copy = (char*)cJSON_strdup((const unsigned char*)path, &stream->hooks);
+    if (new_path->copy == NULL)
+    {
+        return -1;
+    }
+    for (segment = new_path->copy; *segment != '\0'; segment++)
+    {
+        segment_count += (*segment == '/') ? 1 : 0;
+    }
+    new_path->segments = (char**)stream->hooks.allocate(segment_count * sizeof(char*));
+    if (new_path->segments == NULL)
+    {
+        stream->hooks.deallocate(new_path->copy);
+        new_path->copy = NULL;
+        return -1;
+    }
 
-CJSON_PUBLIC(cJSON *) cJSON_CreateBool(cJSON_bool boolean)
-{
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if(item)
+    /* split into segments in place, the empty path is the root */
+    new_path->segment_count = 0;
+    segment = new_path->copy;
+    while (*segment != '\0')
     {
-        item->type = boolean ? cJSON_True : cJSON_False;
+        char *segment_end = strchr(segment, '/');
+        new_path->segments[new_path->segment_count++] = segment;
+        if (segment_end == NULL)
+        {
+            break;
+        }
+        *segment_end = '\0';
+        segment = segment_end + 1;
     }
 
-    return item;
+    return (int)stream->path_count++;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_CreateNumber(double num)
+static cJSON_bool stream_append_token(cJSON_Stream * const stream, const unsigned char *bytes, size_t length)
 {
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if(item)
+    if ((stream->token_length + length + 1) > stream->token_capacity)
     {
-        item->type = cJSON_Number;
-        item->valuedouble = num;
+        size_t new_capacity = (stream->token_capacity > 0) ? stream->token_capacity : 64;
+        unsigned char *new_token = NULL;
 
-        /* use saturation in case of overflow */
-        if (num >= INT_MAX)
+        while (new_capacity < (stream->token_length + length + 1))
         {
-            item->valueint = INT_MAX;
+            if (new_capacity > (((size_t)-1) / 2))
+            {
+                return false;
+            }
+            new_capacity *= 2;
         }
-        else if (num <= (double)INT_MIN)
+
+        new_token = (unsigned char*)stream->hooks.allocate(new_capacity);
+        if (new_token == NULL)
         {
-            item->valueint = INT_MIN;
+            return false;
         }
-        else
+        if (stream->token != NULL)
         {
-            item->valueint = (int)num;
+            memcpy(new_token, stream->token, stream->token_length);
+            stream->hooks.deallocate(stream->token);
         }
+        stream->token = new_token;
+        stream->token_capacity = new_capacity;
     }
 
-    return item;
+    memcpy(stream->token + stream->token_length, bytes, length);
+    stream->token_length += length;
+    stream->token[stream->token_length] = '\0';
+
+    return true;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_CreateString(const char *string)
+static cJSON_bool stream_segment_matches(const char * const segment, const stream_frame * const parent, const char * const key)
 {
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if(item)
+    if (parent->type == '{')
     {
-        item->type = cJSON_String;
-        item->valuestring = (char*)cJSON_strdup((const unsigned char*)string, &global_hooks);
-        if(!item->valuestring)
-        {
-            cJSON_Delete(item);
-            return NULL;
-        }
+        return (key != NULL) && (strcmp(segment, key) == 0);
     }
+    else
+    {
+        size_t index = 0;
+        const char *digit = segment;
 
-    return item;
-}
+        if (*digit == '\0')
+        {
+            return false;
+        }
+        for (; *digit != '\0'; digit++)
+        {
+            if ((*digit < '0') || (*digit > '9') || (index > (((size_t)-1) / 10)))
+            {
+                return false;
+            }
+            index = (index * 10) + (size_t)(*digit - '0');
+        }
 
-CJSON_PUBLIC(cJSON *) cJSON_CreateStringReference(const char *string)
-{
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if (item != NULL)
-    {
-        item->type = cJSON_String | cJSON_IsReference;
-        item->valuestring = (char*)cast_away_const(string);
+        return index == parent->index;
     }
-
-    return item;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_CreateObjectReference(const cJSON *child)
+/* decide whether the value that starts now is built, and which paths it matches */
+static void stream_begin_value(cJSON_Stream * const stream)
 {
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if (item != NULL) {
-        item->type = cJSON_Object | cJSON_IsReference;
-        item->child = (cJSON*)cast_away_const(child);
-    }
+    stream_frame *parent = (stream->frame_count > 0) ? &stream->frames[stream->frame_count - 1] : NULL;
+    size_t i = 0;
 
-    return item;
-}
+    stream->value_matches = 0;
+    stream->value_alive = 0;
 
-CJSON_PUBLIC(cJSON *) cJSON_CreateArrayReference(const cJSON *child) {
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if (item != NULL) {
-        item->type = cJSON_Array | cJSON_IsReference;
-        item->child = (cJSON*)cast_away_const(child);
+    if ((parent != NULL) && (parent->container != NULL))
+    {
+        /* inside of a value that is built completely */
+        stream->value_materialize = true;
+        return;
     }
 
-    return item;
-}
-
-CJSON_PUBLIC(cJSON *) cJSON_CreateRaw(const char *raw)
-{
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if(item)
+    for (i = 0; i < stream->path_count; i++)
     {
-        item->type = cJSON_Raw;
-        item->valuestring = (char*)cJSON_strdup((const unsigned char*)raw, &global_hooks);
-        if(!item->valuestring)
+        const stream_path *path = &stream->paths[i];
+        unsigned int bit = 1u << i;
+        size_t depth = (parent != NULL) ? parent->depth : 0;
+
+        if (path->found || ((parent != NULL) && !(parent->alive & bit)))
         {
-            cJSON_Delete(item);
-            return NULL;
+            continue;
+        }
+        if (parent != NULL)
+        {
+            if ((path->segment_count <= depth) || !stream_segment_matches(path->segments[depth], parent, stream->key))
+            {
+                continue;
+            }
+            depth++;
         }
-    }
-
-    return item;
-}
 
-CJSON_PUBLIC(cJSON *) cJSON_CreateArray(void)
-{
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if(item)
-    {
-        item->type=cJSON_Array;
+        if (path->segment_count == depth)
+        {
+            stream->value_matches |= bit;
+        }
+        else
+        {
+            stream->value_alive |= bit;
+        }
     }
 
-    return item;
-}
-
-CJSON_PUBLIC(cJSON *) cJSON_CreateObject(void)
-{
-    cJSON *item = cJSON_New_Item(&global_hooks);
-    if (item)
+    for (i = 0; i < stream->path_count; i++)
     {
-        item->type = cJSON_Object;
+        if (stream->value_matches & (1u << i))
+        {
+            stream->paths[i].found = true;
+        }
     }
 
-    return item;
+    stream->value_materialize = (stream->value_matches != 0) || ((parent == NULL) && (stream->path_count == 0));
 }
 
-/* Create Arrays: */
-CJSON_PUBLIC(cJSON *) cJSON_CreateIntArray(const int *numbers, int count)
+/* hand a freshly created item to its parent, the matching paths or the root */
+static void stream_attach(cJSON_Stream * const stream, cJSON * const item)
 {
+    stream_frame *parent = (stream->frame_count > 0) ? &stream->frames[stream->frame_count - 1] : NULL;
     size_t i = 0;
-    cJSON *n = NULL;
-    cJSON *p = NULL;
-    cJSON *a = NULL;
-
-    if ((count < 0) || (numbers == NULL))
-    {
-        return NULL;
-    }
-
-    a = cJSON_CreateArray();
 
-    for(i = 0; a && (i < (size_t)count); i++)
+    if ((parent != NULL) && (parent->container != NULL))
     {
-        n = cJSON_CreateNumber(numbers[i]);
-        if (!n)
-        {
-            cJSON_Delete(a);
-            return NULL;
-        }
-        if(!i)
+        if (parent->type == '{')
         {
-            a->child = n;
+            item->string = stream->key;
+            stream->key = NULL;
         }
-        else
+        add_item_to_array(parent->container, item);
+    }
+    else if (stream->value_matches != 0)
+    {
+        /* the first matching path owns the value */
+        for (i = 0; i < stream->path_count; i++)
         {
-            suffix_object(p, n);
+            if (stream->value_matches & (1u << i))
+            {
+                stream->paths[i].value = item;
+                break;
+            }
         }
-        p = n;
     }
-
-    if (a && a->child) {
-        a->child->prev = n;
+    else
+    {
+        stream->root = item;
     }
-
-    return a;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_CreateFloatArray(const float *numbers, int count)
+static void stream_mark_complete(cJSON_Stream * const stream, unsigned int paths)
 {
     size_t i = 0;
-    cJSON *n = NULL;
-    cJSON *p = NULL;
-    cJSON *a = NULL;
-
-    if ((count < 0) || (numbers == NULL))
-    {
-        return NULL;
-    }
-
-    a = cJSON_CreateArray();
 
-    for(i = 0; a && (i < (size_t)count); i++)
+    for (i = 0; i < stream->path_count; i++)
     {
-        n = cJSON_CreateNumber((double)numbers[i]);
-        if(!n)
-        {
-            cJSON_Delete(a);
-            return NULL;
-        }
-        if(!i)
-        {
-            a->child = n;
-        }
-        else
+        if (paths & (1u << i))
         {
-            suffix_object(p, n);
+            stream->paths[i].complete = true;
         }
-        p = n;
     }
+}
 
-    if (a && a->child) {
-        a->child->prev = n;
+static void stream_end_value(cJSON_Stream * const stream)
+{
+    if (stream->key != NULL)
+    {
+        stream->hooks.deallocate(stream->key);
+        stream->key = NULL;
+    }
+    if (stream->frame_count > 0)
+    {
+        stream->frames[stream->frame_count - 1].index++;
     }
-
-    return a;
+    stream->state = STREAM_AFTER_VALUE;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_CreateDoubleArray(const double *numbers, int count)
+/* a scalar value was read completely, item is NULL if it isn't built */
+static void stream_end_scalar(cJSON_Stream * const stream, cJSON * const item)
 {
-    size_t i = 0;
-    cJSON *n = NULL;
-    cJSON *p = NULL;
-    cJSON *a = NULL;
-
-    if ((count < 0) || (numbers == NULL))
+    if (item != NULL)
     {
-        return NULL;
+        stream_attach(stream, item);
+        stream_mark_complete(stream, stream->value_matches);
     }
+    stream_end_value(stream);
+}
 
-    a = cJSON_CreateArray();
+static cJSON_bool stream_open_container(cJSON_Stream * const stream, unsigned char type)
+{
+    stream_frame *frame = NULL;
+    cJSON *container = NULL;
+    size_t depth = (stream->frame_count > 0) ? (stream->frames[stream->frame_count - 1].depth + 1) : 0;
 
-    for(i = 0; a && (i < (size_t)count); i++)
+    if (stream->frame_count >= CJSON_NESTING_LIMIT)
     {
-        n = cJSON_CreateNumber(numbers[i]);
-        if(!n)
+        return false; /* to deeply nested */
+    }
+    if (stream->frame_count >= stream->frame_capacity)
+    {
+        size_t new_capacity = (stream->frame_capacity > 0) ? (stream->frame_capacity * 2) : 16;
+        stream_frame *new_frames = (stream_frame*)stream->hooks.allocate(new_capacity * sizeof(stream_frame));
+        if (new_frames == NULL)
         {
-            cJSON_Delete(a);
-            return NULL;
+            return false;
         }
-        if(!i)
+        if (stream->frames != NULL)
         {
-            a->child = n;
+            memcpy(new_frames, stream->frames, stream->frame_count * sizeof(stream_frame));
+            stream->hooks.deallocate(stream->frames);
         }
-        else
+        stream->frames = new_frames;
+        stream->frame_capacity = new_capacity;
+    }
+
+    if (stream->value_materialize)
+    {
+        container = cJSON_New_Item(&stream->hooks);
+        if (container == NULL)
         {
-            suffix_object(p, n);
+            return false;
         }
-        p = n;
+        container->type = (type == '[') ? cJSON_Array : cJSON_Object;
+        stream_attach(stream, container);
+    }
+    if (stream->key != NULL)
+    {
+        stream->hooks.deallocate(stream->key);
+        stream->key = NULL;
     }
 
-    if (a && a->child) {
-        a->child->prev = n;
+    frame = &stream->frames[stream->frame_count++];
+    frame->container = container;
+    frame->depth = depth;
+    frame->index = 0;
+    frame->alive = (container != NULL) ? 0 : stream->value_alive;
+    frame->completes = stream->value_matches;
+    frame->type = type;
+
+    stream->state = (type == '[') ? STREAM_FIRST_VALUE_OR_END : STREAM_FIRST_KEY_OR_END;
+
+    return true;
+}
+
+static cJSON_bool stream_close_container(cJSON_Stream * const stream, unsigned char type)
+{
+    stream_frame *frame = NULL;
+
+    if ((stream->frame_count == 0) || (stream->frames[stream->frame_count - 1].type != type))
+    {
+        return false; /* mismatched bracket */
     }
 
-    return a;
+    frame = &stream->frames[--stream->frame_count];
+    stream_mark_complete(stream, frame->completes);
+    stream_end_value(stream);
+
+    return true;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_CreateStringArray(const char *const *strings, int count)
+static void stream_begin_string(cJSON_Stream * const stream, cJSON_bool is_key)
 {
-    size_t i = 0;
-    cJSON *n = NULL;
-    cJSON *p = NULL;
-    cJSON *a = NULL;
+    const stream_frame *parent = (stream->frame_count > 0) ? &stream->frames[stream->frame_count - 1] : NULL;
 
-    if ((count < 0) || (strings == NULL))
+    stream->token_is_key = is_key;
+    if (is_key)
     {
-        return NULL;
+        /* keys are needed to build the object or to match paths */
+        stream->keep_token = (parent != NULL) && ((parent->container != NULL) || (parent->alive != 0));
+    }
+    else
+    {
+        stream_begin_value(stream);
+        stream->keep_token = stream->value_materialize;
     }
+    stream->escaped = false;
+    stream->escape_pending = false;
+    stream->unicode_length = 0;
+    stream->token_length = 0;
+    stream->state = STREAM_STRING;
+}
 
-    a = cJSON_CreateArray();
+/* Check \u escapes as they come in, so that strings that are skipped are validated like parse_string would.
+ * Returns false for a lone or reversed surrogate. */
+static cJSON_bool stream_read_unicode(cJSON_Stream * const stream, unsigned char byte)
+{
+    unsigned int code = 0;
 
-    for (i = 0; a && (i < (size_t)count); i++)
+    stream->unicode[stream->unicode_length++] = byte;
+    if (stream->unicode_length == 6)
     {
-        n = cJSON_CreateString(strings[i]);
-        if(!n)
+        code = parse_hex4(stream->unicode + 2);
+        if ((code >= 0xDC00) && (code <= 0xDFFF))
         {
-            cJSON_Delete(a);
-            return NULL;
+            return false;
         }
-        if(!i)
+        if ((code < 0xD800) || (code > 0xDBFF))
         {
-            a->child = n;
+            stream->unicode_length = 0;
         }
-        else
+    }
+    else if (stream->unicode_length == 12)
+    {
+        code = parse_hex4(stream->unicode + 8);
+        if ((stream->unicode[6] != '\\') || (stream->unicode[7] != 'u') || (code < 0xDC00) || (code > 0xDFFF))
         {
-            suffix_object(p,n);
+            return false;
         }
-        p = n;
-    }
-
-    if (a && a->child) {
-        a->child->prev = n;
+        stream->unicode_length = 0;
     }
 
-    return a;
-}
-
-/* Duplication */
-cJSON * cJSON_Duplicate_rec(const cJSON *item, size_t depth, cJSON_bool recurse);
-
-CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
-{
-    return cJSON_Duplicate_rec(item, 0, recurse );
+    return true;
 }
 
-cJSON * cJSON_Duplicate_rec(const cJSON *item, size_t depth, cJSON_bool recurse)
+/* read string bytes up to the closing quote, returns how far the input was consumed */
+static const unsigned char *stream_read_string(cJSON_Stream * const stream, const unsigned char *input, const unsigned char * const input_end)
 {
-    cJSON *newitem = NULL;
-    cJSON *child = NULL;
-    cJSON *next = NULL;
-    cJSON *newchild = NULL;
+    const unsigned char *run_start = input;
+    cJSON_bool closed = false;
 
-    /* Bail on bad ptr */
-    if (!item)
-    {
-        goto fail;
-    }
-    /* Create new item */
-    newitem = cJSON_New_Item(&global_hooks);
-    if (!newitem)
+    if (stream->keep_token && (stream->token_length == 0) && !stream_append_token(stream, (const unsigned char*)"\"", 1))
     {
-        goto fail;
+        stream->state = STREAM_ERROR;
+        return input;
     }
-    /* Copy over all vars */
-    newitem->type = item->type & (~cJSON_IsReference);
-    newitem->valueint = item->valueint;
-    newitem->valuedouble = item->valuedouble;
-    if (item->valuestring)
+
+    for (; input < input_end; input++)
     {
-        newitem->valuestring = (char*)cJSON_strdup((unsigned char*)item->valuestring, &global_hooks);
-        if (!newitem->valuestring)
+        /* where the string ends: a backslash hides the next byte from the closing quote check */
+        if (stream->escaped)
         {
-            goto fail;
+            stream->escaped = false;
         }
-    }
-    if (item->string)
-    {
-        newitem->string = (item->type&cJSON_StringIsConst) ? item->string : (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
-        if (!newitem->string)
+        else if (*input == '\"')
         {
-            goto fail;
+            /* parse_string reads a backslash left open here as escaping the closing quote, only \u can't end like that */
+            if (stream->unicode_length > 0)
+            {
+                stream->state = STREAM_ERROR;
+                return input;
+            }
+            closed = true;
+            break;
+        }
+        else if (*input == '\\')
+        {
+            stream->escaped = true;
+        }
+
+        /* what the bytes mean, read the way parse_string decodes them: the 4 digits of \u are taken as they are */
+        if (stream->unicode_length > 0)
+        {
+            if (!stream_read_unicode(stream, *input))
+            {
+                stream->state = STREAM_ERROR;
+                return input;
+            }
+        }
+        else if (stream->escape_pending)
+        {
+            if ((*input == '\0') || (strchr("\"\\/bfnrtu", *input) == NULL))
+            {
+                stream->state = STREAM_ERROR;
+                return input;
+            }
+            if (*input == 'u')
+            {
+                stream->unicode[0] = '\\';
+                stream->unicode[1] = 'u';
+                stream->unicode_length = 2;
+            }
+            stream->escape_pending = false;
+        }
+        else if (*input == '\\')
+        {
+            stream->escape_pending = true;
         }
     }
-    /* If non-recursive, then we're done! */
-    if (!recurse)
+
+    if (stream->keep_token && !stream_append_token(stream, run_start, (size_t)(input - run_start) + (closed ? 1 : 0)))
     {
-        return newitem;
+        stream->state = STREAM_ERROR;
+        return input;
     }
-    /* Walk the ->next chain for the child. */
-    child = item->child;
-    while (child != NULL)
+    if (!closed)
     {
-        if(depth >= CJSON_CIRCULAR_LIMIT) {
-            goto fail;
-        }
-        newchild = cJSON_Duplicate_rec(child, depth + 1, true); /* Duplicate (with recurse) each item in the ->next chain */
-        if (!newchild)
+        return input;
+    }
+    input++;
+
+    if (stream->keep_token)
+    {
+        /* the token is a complete string literal now, unescape it with the regular parser */
+        parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
+        cJSON string_item;
+
+        memset(&string_item, '\0', sizeof(string_item));
+        buffer.content = stream->token;
+        buffer.length = stream->token_length;
+        buffer.hooks = stream->hooks;
+        if (!parse_string(&string_item, &buffer))
         {
-            goto fail;
+            stream->state = STREAM_ERROR;
+            return input;
         }
-        if (next != NULL)
+
+        if (stream->token_is_key)
         {
-            /* If newitem->child already set, then crosswire ->prev and ->next and move on */
-            next->next = newchild;
-            newchild->prev = next;
-            next = newchild;
+            stream->key = string_item.valuestring;
         }
         else
         {
-            /* Set newitem->child and move to it */
-            newitem->child = newchild;
-            next = newchild;
+            cJSON *item = cJSON_New_Item(&stream->hooks);
+            if (item == NULL)
+            {
+                stream->hooks.deallocate(string_item.valuestring);
+                stream->state = STREAM_ERROR;
+                return input;
+            }
+            item->type = cJSON_String;
+            item->valuestring = string_item.valuestring;
+            stream_end_scalar(stream, item);
         }
-        child = child->next;
     }
-    if (newitem && newitem->child)
+    else if (!stream->token_is_key)
     {
-        newitem->child->prev = newchild;
+        stream_end_scalar(stream, NULL);
     }
 
-    return newitem;
-
-fail:
-    if (newitem != NULL)
+    if (stream->token_is_key)
     {
-        cJSON_Delete(newitem);
+        stream->state = STREAM_COLON;
     }
 
-    return NULL;
+    return input;
 }
 
-static void skip_oneline_comment(char **input)
+static cJSON_bool stream_end_number(cJSON_Stream * const stream)
 {
-    *input += static_strlen("//");
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
+    cJSON number;
+    cJSON *item = NULL;
 
-    for (; (*input)[0] != '\0'; ++(*input))
+    /* numbers are validated even if they aren't built */
+    memset(&number, '\0', sizeof(number));
+    buffer.content = stream->token;
+    buffer.length = stream->token_length;
+    buffer.hooks = stream->hooks;
+    if (!parse_number(&number, &buffer) || (buffer.offset != buffer.length))
     {
-        if ((*input)[0] == '\n') {
-            *input += static_strlen("\n");
-            return;
+        return false;
+    }
+
+    if (stream->value_materialize)
+    {
+        item = cJSON_New_Item(&stream->hooks);
+        if (item == NULL)
+        {
+            return false;
         }
+        item->type = number.type;
+        item->valueint = number.valueint;
+        item->valuedouble = number.valuedouble;
     }
+
+    stream_end_scalar(stream, item);
+    return true;
 }
 
-static void skip_multiline_comment(char **input)
+static cJSON_bool stream_end_literal(cJSON_Stream * const stream)
 {
-    *input += static_strlen("/*");
+    cJSON *item = NULL;
 
-    for (; (*input)[0] != '\0'; ++(*input))
+    if (stream->value_materialize)
     {
-        if (((*input)[0] == '*') && ((*input)[1] == '/'))
+        item = cJSON_New_Item(&stream->hooks);
+        if (item == NULL)
         {
-            *input += static_strlen("*/");
-            return;
+            return false;
+        }
+        switch (stream->literal[0])
+        {
+            case 't':
+                item->type = cJSON_True;
+                item->valueint = 1;
+                break;
+            case 'f':
+                item->type = cJSON_False;
+                break;
+            default:
+                item->type = cJSON_NULL;
+                break;
         }
     }
-}
 
-static void minify_string(char **input, char **output) {
-    (*output)[0] = (*input)[0];
-    *input += static_strlen("\"");
-    *output += static_strlen("\"");
+    stream_end_scalar(stream, item);
+    return true;
+}
 
+/* start reading a value at its first byte, returns false if no value starts with it */
+static cJSON_bool stream_start_value(cJSON_Stream * const stream, unsigned char first)
+{
+    switch (first)
+    {
+        case '\"':
+            stream_begin_string(stream, false);
+            return true;
 
-    for (; (*input)[0] != '\0'; (void)++(*input), ++(*output)) {
-        (*output)[0] = (*input)[0];
+        case '[':
+        case '{':
+            stream_begin_value(stream);
+            return stream_open_container(stream, first);
+
+        case 't':
+        case 'f':
+        case 'n':
+            stream_begin_value(stream);
+            stream->literal = (first == 't') ? "true" : ((first == 'f') ? "false" : "null");
+            stream->literal_position = 1;
+            stream->state = STREAM_LITERAL;
+            return true;
 
-        if ((*input)[0] == '\"') {
-            (*output)[0] = '\"';
-            *input += static_strlen("\"");
-            *output += static_strlen("\"");
-            return;
-        } else if (((*input)[0] == '\\') && ((*input)[1] == '\"')) {
-            (*output)[1] = (*input)[1];
-            *input += static_strlen("\"");
-            *output += static_strlen("\"");
-        }
+        default:
+            if ((first == '-') || ((first >= '0') && (first <= '9')))
+            {
+                stream_begin_value(stream);
+                stream->token_length = 0;
+                stream->state = STREAM_NUMBER;
+                return stream_append_token(stream, &first, 1);
+            }
+            return false;
     }
 }
 
-CJSON_PUBLIC(void) cJSON_Minify(char *json)
+CJSON_PUBLIC(cJSON_bool) cJSON_StreamFeed(cJSON_Stream *stream, const char *chunk, size_t length)
 {
-    char *into = json;
+    const unsigned char *input = (const unsigned char*)chunk;
+    const unsigned char *input_end = input + length;
+
+    if ((stream == NULL) || ((chunk == NULL) && (length > 0)) || (stream->state == STREAM_ERROR))
+    {
+        return false;
+    }
+
+    while (input < input_end)
+    {
+        unsigned char current = *input;
+
+        switch (stream->state)
+        {
+            case STREAM_STRING:
+                input = stream_read_string(stream, input, input_end);
+                if (stream->state == STREAM_ERROR)
+                {
+                    goto fail;
+                }
+                continue;
+
+            case STREAM_NUMBER:
+                if (((current >= '0') && (current <= '9')) || (current == '.') || (current == 'e') || (current == 'E') || (current == '+') || (current == '-'))
+                {
+                    if (!stream_append_token(stream, input, 1))
+                    {
+                        goto fail;
+                    }
+                    input++;
+                }
+                else if (!stream_end_number(stream))
+                {
+                    goto fail;
+                }
+                continue;
+
+            case STREAM_LITERAL:
+                if (current != (unsigned char)stream->literal[stream->literal_position])
+                {
+                    goto fail;
+                }
+                input++;
+                stream->literal_position++;
+                if ((stream->literal[stream->literal_position] == '\0') && !stream_end_literal(stream))
+                {
+                    goto fail;
+                }
+                continue;
 
-    if (json == NULL)
-    {
-        return;
-    }
+            default:
+                break;
+        }
 
-    while (json[0] != '\0')
-    {
-        switch (json[0])
+        if (current <= 32)
         {
-            case ' ':
-            case '\t':
-            case '\r':
-            case '\n':
-                json++;
+            /* whitespace between tokens */
+            input++;
+            continue;
+        }
+
+        switch (stream->state)
+        {
+            case STREAM_FIRST_VALUE_OR_END:
+                if (current == ']')
+                {
+                    if (!stream_close_container(stream, '['))
+                    {
+                        goto fail;
+                    }
+                    input++;
+                    continue;
+                }
+                /* fall through */
+            case STREAM_VALUE:
+                if (!stream_start_value(stream, current))
+                {
+                    goto fail;
+                }
+                input++;
                 break;
 
-            case '/':
-                if (json[1] == '/')
+            case STREAM_FIRST_KEY_OR_END:
+                if (current == '}')
                 {
-                    skip_oneline_comment(&json);
+                    if (!stream_close_container(stream, '{'))
+                    {
+                        goto fail;
+                    }
+                    input++;
+                    continue;
                 }
-                else if (json[1] == '*')
+                /* fall through */
+            case STREAM_KEY:
+                if (current != '\"')
                 {
-                    skip_multiline_comment(&json);
-                } else {
-                    json++;
+                    goto fail;
                 }
+                stream_begin_string(stream, true);
+                input++;
                 break;
 
-            case '\"':
-                minify_string(&json, (char**)&into);
+            case STREAM_COLON:
+                if (current != ':')
+                {
+                    goto fail;
+                }
+                stream->state = STREAM_VALUE;
+                input++;
+                break;
+
+            case STREAM_AFTER_VALUE:
+                if (stream->frame_count == 0)
+                {
+                    /* the root value is complete, only whitespace may follow */
+                    stream->state = STREAM_DONE;
+                    continue;
+                }
+                if (current == ',')
+                {
+                    stream->state = (stream->frames[stream->frame_count - 1].type == '[') ? STREAM_VALUE : STREAM_KEY;
+                }
+                else if (((current != ']') && (current != '}')) || !stream_close_container(stream, (current == ']') ? '[' : '{'))
+                {
+                    goto fail;
+                }
+                input++;
                 break;
 
             default:
-                into[0] = json[0];
-                json++;
-                into++;
+                goto fail;
         }
     }
 
-    /* and null-terminate. */
-    *into = '\0';
-}
-
-CJSON_PUBLIC(cJSON_bool) cJSON_IsInvalid(const cJSON * const item)
-{
-    if (item == NULL)
-    {
-        return false;
-    }
+    stream->consumed += length;
+    return true;
 
-    return (item->type & 0xFF) == cJSON_Invalid;
+fail:
+    stream->error_offset = stream->consumed + (size_t)(input - (const unsigned char*)chunk);
+    stream->consumed += length;
+    stream->state = STREAM_ERROR;
+    return false;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_IsFalse(const cJSON * const item)
+CJSON_PUBLIC(cJSON_bool) cJSON_StreamFinish(cJSON_Stream *stream)
 {
-    if (item == NULL)
+    if (stream == NULL)
     {
         return false;
     }
 
-    return (item->type & 0xFF) == cJSON_False;
-}
-
-CJSON_PUBLIC(cJSON_bool) cJSON_IsTrue(const cJSON * const item)
-{
-    if (item == NULL)
+    /* a number at the very end is only terminated by the end of the input */
+    if ((stream->state == STREAM_NUMBER) && !stream_end_number(stream))
     {
-        return false;
+        stream->error_offset = stream->consumed;
+        stream->state = STREAM_ERROR;
     }
-
-    return (item->type & 0xff) == cJSON_True;
-}
-
-
-CJSON_PUBLIC(cJSON_bool) cJSON_IsBool(const cJSON * const item)
-{
-    if (item == NULL)
+    if ((stream->state == STREAM_AFTER_VALUE) && (stream->frame_count == 0))
     {
-        return false;
+        stream->state = STREAM_DONE;
     }
-
-    return (item->type & (cJSON_True | cJSON_False)) != 0;
-}
-CJSON_PUBLIC(cJSON_bool) cJSON_IsNull(const cJSON * const item)
-{
-    if (item == NULL)
+    if ((stream->state != STREAM_DONE) && (stream->state != STREAM_ERROR))
     {
-        return false;
+        /* input ended unexpectedly */
+        stream->error_offset = stream->consumed;
+        stream->state = STREAM_ERROR;
     }
 
-    return (item->type & 0xFF) == cJSON_NULL;
+    return stream->state == STREAM_DONE;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_IsNumber(const cJSON * const item)
+CJSON_PUBLIC(cJSON_bool) cJSON_StreamIsComplete(const cJSON_Stream *stream)
 {
-    if (item == NULL)
-    {
-        return false;
-    }
-
-    return (item->type & 0xFF) == cJSON_Number;
+    return (stream != NULL) && (stream->frame_count == 0) && ((stream->state == STREAM_AFTER_VALUE) || (stream->state == STREAM_DONE));
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_IsString(const cJSON * const item)
+CJSON_PUBLIC(size_t) cJSON_StreamGetErrorOffset(const cJSON_Stream *stream)
 {
-    if (item == NULL)
-    {
-        return false;
-    }
-
-    return (item->type & 0xFF) == cJSON_String;
+    return ((stream != NULL) && (stream->state == STREAM_ERROR)) ? stream->error_offset : 0;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_IsArray(const cJSON * const item)
+CJSON_PUBLIC(cJSON *) cJSON_StreamDetachRoot(cJSON_Stream *stream)
 {
-    if (item == NULL)
+    cJSON *root = NULL;
+
+    if ((stream == NULL) || !cJSON_StreamIsComplete(stream))
     {
-        return false;
+        return NULL;
     }
 
-    return (item->type & 0xFF) == cJSON_Array;
+    root = stream->root;
+    stream->root = NULL;
+
+    return root;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_IsObject(const cJSON * const item)
+CJSON_PUBLIC(cJSON *) cJSON_StreamDetachPathValue(cJSON_Stream *stream, int path)
 {
-    if (item == NULL)
+    cJSON *value = NULL;
+
+    if ((stream == NULL) || (path < 0) || ((size_t)path >= stream->path_count) || !stream->paths[path].complete)
     {
-        return false;
+        return NULL;
     }
 
-    return (item->type & 0xFF) == cJSON_Object;
+    value = stream->paths[path].value;
+    stream->paths[path].value = NULL;
+
+    return value;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_IsRaw(const cJSON * const item)
+CJSON_PUBLIC(void) cJSON_DeleteStream(cJSON_Stream *stream)
 {
-    if (item == NULL)
+    size_t i = 0;
+
+    if (stream == NULL)
     {
-        return false;
+        return;
     }
 
-    return (item->type & 0xFF) == cJSON_Raw;
-}
-
-CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * const b, const cJSON_bool case_sensitive)
-{
-    if ((a == NULL) || (b == NULL) || ((a->type & 0xFF) != (b->type & 0xFF)))
+    for (i = 0; i < stream->path_count; i++)
     {
-        return false;
+        delete_item(stream->paths[i].value, &stream->hooks);
+        stream->hooks.deallocate(stream->paths[i].segments);
+        stream->hooks.deallocate(stream->paths[i].copy);
     }
-
-    /* check if type is valid */
-    switch (a->type & 0xFF)
+    delete_item(stream->root, &stream->hooks);
+    if (stream->key != NULL)
     {
-        case cJSON_False:
-        case cJSON_True:
-        case cJSON_NULL:
-        case cJSON_Number:
-        case cJSON_String:
-        case cJSON_Raw:
-        case cJSON_Array:
-        case cJSON_Object:
-            break;
-
-        default:
-            return false;
+        stream->hooks.deallocate(stream->key);
     }
-
-    /* identical objects are equal */
-    if (a == b)
+    if (stream->token != NULL)
     {
-        return true;
+        stream->hooks.deallocate(stream->token);
     }
-
-    switch (a->type & 0xFF)
+    if (stream->frames != NULL)
     {
-        /* in these cases and equal type is enough */
-        case cJSON_False:
-        case cJSON_True:
-        case cJSON_NULL:
-            return true;
-
-        case cJSON_Number:
-            if (compare_double(a->valuedouble, b->valuedouble))
-            {
-                return true;
-            }
-            return false;
-
-        case cJSON_String:
-        case cJSON_Raw:
-            if ((a->valuestring == NULL) || (b->valuestring == NULL))
-            {
-                return false;
-            }
-            if (strcmp(a->valuestring, b->valuestring) == 0)
-            {
-                return true;
-            }
-
-            return false;
-
-        case cJSON_Array:
-        {
-            cJSON *a_element = a->child;
-            cJSON *b_element = b->child;
-
-            for (; (a_element != NULL) && (b_element != NULL);)
-            {
-                if (!cJSON_Compare(a_element, b_element, case_sensitive))
-                {
-                    return false;
-                }
-
-                a_element = a_element->next;
-                b_element = b_element->next;
-            }
-
-            /* one of the arrays is longer than the other */
-            if (a_element != b_element) {
-                return false;
-            }
-
-            return true;
-        }
-
-        case cJSON_Object:
-        {
-            cJSON *a_element = NULL;
-            cJSON *b_element = NULL;
-            cJSON_ArrayForEach(a_element, a)
-            {
-                /* TODO This has O(n^2) runtime, which is horrible! */
-                b_element = get_object_item(b, a_element->string, case_sensitive);
-                if (b_element == NULL)
-                {
-                    return false;
-                }
-
-                if (!cJSON_Compare(a_element, b_element, case_sensitive))
-                {
-                    return false;
-                }
-            }
-
-            /* doing this twice, once on a and b to prevent true comparison if a subset of b
-             * TODO: Do this the proper way, this is just a fix for now */
-            cJSON_ArrayForEach(b_element, b)
-            {
-                a_element = get_object_item(a, b_element->string, case_sensitive);
-                if (a_element == NULL)
-                {
-                    return false;
-                }
-
-                if (!cJSON_Compare(b_element, a_element, case_sensitive))
-                {
-                    return false;
-                }
-            }
-
-            return true;
-        }
-
-        default:
-            return false;
+        stream->hooks.deallocate(stream->frames);
     }
+    stream->hooks.deallocate(stream);
 }
 
 CJSON_PUBLIC(void *) cJSON_malloc(size_t size)
@@ -3189,3 +6844,14 @@ CJSON_PUBLIC(void) cJSON_free(void *object)
     global_hooks.deallocate(object);
     object = NULL;
 }
+
+CJSON_PUBLIC(void) cJSON_FreeWithContext(cJSON_Context *context, void *object)
+{
+    if (context == NULL)
+    {
+        global_hooks.deallocate(object);
+        return;
+    }
+
+    context->hooks.deallocate(object);
+}
@@ -120,6 +120,11 @@ typedef struct cJSON
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+
+    /* Lookup index over the children of a large array/object, built by cJSON_BuildIndex and kept in sync when the children change
+     * (or marked stale when it can't follow cheaply, lookups then walk the list until cJSON_BuildIndex refills it).
+     * Owned by cJSON, don't touch. If you relink child/next/prev or rename child->string by hand, call cJSON_InvalidateIndex. */
+    struct cJSON_Index *index;
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -137,6 +142,17 @@ typedef int cJSON_bool;
 #define CJSON_NESTING_LIMIT 1000
 #endif
 
+/* cJSON_BuildIndex gives objects with more children than this a hashed key index, and arrays a vector of their children.
+ * Defining this as (size_t)-1 turns indexing off. */
+#ifndef CJSON_INDEX_THRESHOLD
+#define CJSON_INDEX_THRESHOLD 16
+#endif
+
+/* Limits how many paths a cJSON_Stream can filter for. */
+#ifndef CJSON_STREAM_MAX_PATHS
+#define CJSON_STREAM_MAX_PATHS 8
+#endif
+
 /* Limits the length of circular references can be before cJSON rejects to parse them.
  * This is to prevent stack overflows. */
 #ifndef CJSON_CIRCULAR_LIMIT
@@ -149,6 +165,18 @@ CJSON_PUBLIC(const char*) cJSON_Version(void);
 /* Supply malloc, realloc and free functions to cJSON */
 CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks);
 
+/* A context carries its own hooks and error position, so threads with a context each can parse and print at the same time.
+ * Threads may look up items in the same tree at once, but any change to it (including cJSON_BuildIndex) needs the caller's lock.
+ * Trees parsed with a context are deleted with cJSON_DeleteWithContext, and printed text is freed with cJSON_FreeWithContext. hooks may be NULL for malloc/free. */
+typedef struct cJSON_Context cJSON_Context;
+CJSON_PUBLIC(cJSON_Context *) cJSON_CreateContext(const cJSON_Hooks *hooks);
+CJSON_PUBLIC(void) cJSON_DeleteContext(cJSON_Context *context);
+/* With key interning, every distinct object key parsed through the context is stored once in a table owned by the context and shared by all trees.
+ * Such keys are flagged cJSON_StringIsConst, so trees parsed this way must be deleted before the context is.
+ * cJSON_InternKey returns the shared copy of key (enabling interning if needed); lookups with it find interned keys by address. */
+CJSON_PUBLIC(cJSON_bool) cJSON_EnableKeyInterning(cJSON_Context *context);
+CJSON_PUBLIC(const char *) cJSON_InternKey(cJSON_Context *context, const char *key);
+
 /* Memory Management: the caller is always responsible to free the results from all variants of cJSON_Parse (with cJSON_Delete) and cJSON_Print (with stdlib free, cJSON_Hooks.free_fn, or cJSON_free as appropriate). The exception is cJSON_PrintPreallocated, where the caller has full responsibility of the buffer. */
 /* Supply a block of JSON, and this returns a cJSON object you can interrogate. */
 CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value);
@@ -157,19 +185,60 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 /* If you supply a ptr in return_parse_end and parsing fails, then return_parse_end will contain a pointer to the error so will match cJSON_GetErrorPtr(). */
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+/* ParseInSitu unescapes strings and keys inside of value instead of copying them, so parsing allocates no strings.
+ * The buffer is modified, must stay alive and unchanged until the result is deleted, and its content is undefined if parsing fails.
+ * String values are flagged cJSON_IsReference and keys cJSON_StringIsConst, so cJSON_Delete leaves them alone. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value, size_t buffer_length);
+/* Like cJSON_ParseWithLengthOpts, but with the hooks of context and its own error position (see cJSON_GetContextErrorPtr). */
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithContext(cJSON_Context *context, const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+CJSON_PUBLIC(const char *) cJSON_GetContextErrorPtr(const cJSON_Context *context);
+
+/* Extract a single value from JSON text without building a tree. Subtrees that are not on the path are skipped without allocating.
+ * path is a '/' separated list of object keys (case sensitive) and array indices, e.g. "candidates/0/content/parts/0/text". */
+/* ExtractPathView points value_start at the first byte of the value inside json (the opening quote for strings) and stores its raw length. Returns 1 if the value was found. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ExtractPathView(const char *json, size_t buffer_length, const char *path, const char **value_start, size_t *value_length);
+/* ExtractPath returns an unescaped copy of the string value at path, which the caller frees with cJSON_free. Returns NULL if the path is missing or not a string. */
+CJSON_PUBLIC(char *) cJSON_ExtractPath(const char *json, size_t buffer_length, const char *path);
+
+/* Incremental parsing: feed the JSON text in chunks of any size as it arrives (e.g. from a network callback) instead of collecting it first. */
+typedef struct cJSON_Stream cJSON_Stream;
+CJSON_PUBLIC(cJSON_Stream *) cJSON_CreateStream(void);
+/* A stream that allocates with the hooks of context; the values it hands over are deleted with cJSON_DeleteWithContext. */
+CJSON_PUBLIC(cJSON_Stream *) cJSON_CreateStreamWithContext(cJSON_Context *context);
+/* Only build the values at the given paths (same syntax as cJSON_ExtractPath, the first match counts). Everything else is scanned but never allocated.
+ * Must be called before the first chunk is fed. Returns an id for cJSON_StreamDetachPathValue, or -1. Paths inside the value of another path are not reported separately. */
+CJSON_PUBLIC(int) cJSON_StreamAddPath(cJSON_Stream *stream, const char *path);
+/* Returns 0 as soon as the input is known to be invalid, the position is available from cJSON_StreamGetErrorOffset. */
+CJSON_PUBLIC(cJSON_bool) cJSON_StreamFeed(cJSON_Stream *stream, const char *chunk, size_t length);
+/* Signals the end of the input. Returns 1 if it was exactly one valid JSON value. */
+CJSON_PUBLIC(cJSON_bool) cJSON_StreamFinish(cJSON_Stream *stream);
+/* Returns 1 once the root value has been closed. */
+CJSON_PUBLIC(cJSON_bool) cJSON_StreamIsComplete(const cJSON_Stream *stream);
+CJSON_PUBLIC(size_t) cJSON_StreamGetErrorOffset(const cJSON_Stream *stream);
+/* Hand over the parsed tree (without paths) or the value of a path to the caller, who frees it with cJSON_Delete. Values are available as soon as their last byte was fed. */
+CJSON_PUBLIC(cJSON *) cJSON_StreamDetachRoot(cJSON_Stream *stream);
+CJSON_PUBLIC(cJSON *) cJSON_StreamDetachPathValue(cJSON_Stream *stream, int path);
+CJSON_PUBLIC(void) cJSON_DeleteStream(cJSON_Stream *stream);
 
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. */
 CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item);
+/* Render a cJSON entity to text allocated with the hooks of context. */
+CJSON_PUBLIC(char *) cJSON_PrintWithContext(cJSON_Context *context, const cJSON *item, cJSON_bool format);
 /* Render a cJSON entity to text using a buffered strategy. prebuffer is a guess at the final size. guessing well reduces reallocation. fmt=0 gives unformatted, =1 gives formatted */
 CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt);
+/* Render a cJSON entity into a reusable buffer. *buffer (NULL or from an earlier call) is replaced by a block of the exact size only if the text doesn't fit into *capacity bytes.
+ * The caller frees *buffer with cJSON_free when done. Returns 1 on success and 0 on failure, in which case *buffer is still valid. */
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToBuffer(const cJSON *item, char **buffer, size_t *capacity, const cJSON_bool format);
 /* Render a cJSON entity to text using a buffer already allocated in memory with given length. Returns 1 on success and 0 on failure. */
 /* NOTE: cJSON is not always 100% accurate in estimating how much memory it will use, so to be safe allocate 5 bytes more than you actually need */
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format);
 /* Delete a cJSON entity and all subentities. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item);
+CJSON_PUBLIC(void) cJSON_DeleteWithContext(cJSON_Context *context, cJSON *item);
 
+/* Lookups never change the tree. Arrays and objects only use an index after cJSON_BuildIndex, otherwise they walk their children. */
 /* Returns the number of items in an array (or object). */
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array);
 /* Retrieve item number "index" from array "array". Returns NULL if unsuccessful. */
@@ -178,7 +247,15 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string);
+/* Index item and every array/object inside it with more than CJSON_INDEX_THRESHOLD children, so that item and key lookups on them take O(1).
+ * The index follows changes made through the cJSON API; call it again after changes it couldn't follow to refill it. Returns 0 if memory ran out. */
+CJSON_PUBLIC(cJSON_bool) cJSON_BuildIndex(cJSON *item);
+/* Like cJSON_BuildIndex, but the indexes are allocated (and later grown and freed) with the hooks of context. */
+CJSON_PUBLIC(cJSON_bool) cJSON_BuildIndexWithContext(cJSON_Context *context, cJSON *item);
+/* Drop the lookup index of an array/object. Only needed after changing its children without going through the cJSON API. */
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *item);
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
+/* The error position is kept per thread where the compiler supports thread local storage. */
 CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void);
 
 /* Check item type and return its value */
@@ -298,6 +375,7 @@ CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
 /* malloc/free objects using the malloc/free functions that have been set with cJSON_InitHooks */
 CJSON_PUBLIC(void *) cJSON_malloc(size_t size);
 CJSON_PUBLIC(void) cJSON_free(void *object);
+CJSON_PUBLIC(void) cJSON_FreeWithContext(cJSON_Context *context, void *object);
 
 #ifdef __cplusplus
 }
@@ -4,10 +4,16 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_ttf.h>
 
+#include "leaderboard.h"
+#include "leaderboard_concurrent.h"
+#include "leaderboard_store.h"
+#include "leaderboard_windows.h"
+
 #define MAX_INPUT_LENGTH 50
 #define NUM_THEMES 5
 #define SCREEN_WIDTH 1600
 #define SCREEN_HEIGHT 900
+#define LOCAL_PLAYER_NAME "Jogador" // nome de quem joga nesta máquina no placar
 
 typedef enum {
     STATE_MENU,
@@ -18,8 +24,6 @@ typedef enum {
     STATE_EXIT
 } GameState;
 
-typedef struct PlayerNode PlayerNode;
-
 typedef struct {
     SDL_Color bgColor;
     SDL_Color bgGradientEnd;
@@ -38,7 +42,10 @@ typedef struct {
     SDL_Renderer* renderer;
     TTF_Font* font_title;
     TTF_Font* font_body;
-    PlayerNode* leaderboard;
+    Leaderboard leaderboard;
+    LeaderboardStore leaderboardStore;
+    LeaderboardWindows leaderboardWindows; // últimas 24h e últimos 7 dias, só em memória
+    ConcurrentLeaderboard sharedLeaderboard; // por onde as telas leem e atualizam o placar
     char lastLetter;
     char lastThemes[NUM_THEMES][100];
     char lastAnswers[NUM_THEMES][MAX_INPUT_LENGTH];
@@ -3,106 +3,851 @@
 #include <stdlib.h>
 #include <string.h>
 
-PlayerNode* createPlayer(const char* name) {
-    PlayerNode* newNode = (PlayerNode*)malloc(sizeof(PlayerNode));
-    if (newNode) {
-        if (name) {
-            strncpy(newNode->name, name, sizeof(newNode->name) - 1);
-            newNode->name[sizeof(newNode->name) - 1] = '\0';
-        } else {
-            newNode->name[0] = '\0';
+#define CHUNK_NODES (1u << LEADERBOARD_CHUNK_SHIFT)
+#define NAME_BLOCK_BYTES (1u << LEADERBOARD_NAME_BLOCK_SHIFT)
+
+static PlayerNode* nodeAt(const Leaderboard* board, uint32_t index) {
+    if (index == LEADERBOARD_NO_PLAYER) {
+        return NULL;
+    }
+    index--;
+    return &board->chunks[index >> LEADERBOARD_CHUNK_SHIFT][index & (CHUNK_NODES - 1)];
+}
+
+static const char* nameText(const Leaderboard* board, uint32_t name) {
+    name--;
+    return board->nameBlocks[name >> LEADERBOARD_NAME_BLOCK_SHIFT] + (name & (NAME_BLOCK_BYTES - 1));
+}
+
+static uint32_t subtreeSize(const Leaderboard* board, uint32_t index) {
+    return index != LEADERBOARD_NO_PLAYER ? nodeAt(board, index)->size : 0;
+}
+
+static void updateSize(const Leaderboard* board, PlayerNode* node) {
+    node->size = 1 + subtreeSize(board, node->left) + subtreeSize(board, node->right);
+}
+
+// Verdadeiro se 'a' aparece antes de 'b' no placar
+static int ranksBefore(const PlayerNode* a, const PlayerNode* b) {
+    if (a->totalScore != b->totalScore) {
+        return a->totalScore > b->totalScore;
+    }
+    return a->sequence > b->sequence;
+}
+
+static uint32_t nextPriority(Leaderboard* board) {
+    // xorshift32; o estado zero nunca sai do zero, então começa de uma semente fixa
+    uint32_t x = board->randomState ? board->randomState : 2463534242u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    board->randomState = x;
+    return x;
+}
+
+// Pega um nó da lista de livres ou, se ela estiver vazia, o próximo do bloco atual
+static PlayerNode* allocateNode(Leaderboard* board) {
+    if (board->freeList != LEADERBOARD_NO_PLAYER) {
+        PlayerNode* node = nodeAt(board, board->freeList);
+        board->freeList = node->left;
+        return node;
+    }
+
+    uint32_t position = board->usedNodes;
+    if ((position & (CHUNK_NODES - 1)) == 0) {
+        if (board->chunkCount == board->chunkCapacity) {
+            int capacity = board->chunkCapacity ? board->chunkCapacity * 2 : 8;
+            PlayerNode** chunks = (PlayerNode**)realloc(board->chunks, sizeof(PlayerNode*) * (size_t)capacity);
+            if (chunks == NULL) {
+                return NULL;
+            }
+            board->chunks = chunks;
+            board->chunkCapacity = capacity;
         }
-        newNode->totalScore = 0;
-        newNode->next = NULL;
-        newNode->prev = NULL;
+        PlayerNode* chunk = (PlayerNode*)malloc(sizeof(PlayerNode) * CHUNK_NODES);
+        if (chunk == NULL) {
+            return NULL;
+        }
+        board->chunks[board->chunkCount++] = chunk;
     }
-    return newNode;
+
+    board->usedNodes++;
+    PlayerNode* node = nodeAt(board, board->usedNodes);
+    node->self = board->usedNodes;
+    return node;
+}
+
+static void releaseNode(Leaderboard* board, PlayerNode* node) {
+    node->left = board->freeList;
+    board->freeList = node->self;
 }
 
-void insertSorted(PlayerNode** head, PlayerNode* newNode) {
-    if (!head || !newNode) {
+// Separa a árvore nos nós que vêm antes de 'key' e nos que vêm depois, contando
+// quantos foram para cada lado. Os tamanhos saem dessas contas, sem ler o filho
+// que fica fora do caminho.
+static void splitTree(Leaderboard* board, uint32_t tree, const PlayerNode* key, uint32_t* before, uint32_t* after,
+                      uint32_t* beforeSize, uint32_t* afterSize) {
+    if (tree == LEADERBOARD_NO_PLAYER) {
+        *before = LEADERBOARD_NO_PLAYER;
+        *after = LEADERBOARD_NO_PLAYER;
+        *beforeSize = 0;
+        *afterSize = 0;
         return;
     }
+    PlayerNode* node = nodeAt(board, tree);
+    uint32_t total = node->size;
+    uint32_t innerBefore;
+    uint32_t innerAfter;
+    if (ranksBefore(node, key)) {
+        splitTree(board, node->right, key, &node->right, after, &innerBefore, &innerAfter);
+        *before = tree;
+        node->size = total - innerAfter;
+        *beforeSize = node->size;
+        *afterSize = innerAfter;
+    } else {
+        splitTree(board, node->left, key, before, &node->left, &innerBefore, &innerAfter);
+        *after = tree;
+        node->size = total - innerBefore;
+        *beforeSize = innerBefore;
+        *afterSize = node->size;
+    }
+}
+
+// Junta duas árvores em que todos os nós de 'first' vêm antes dos de 'second'
+static uint32_t mergeTrees(Leaderboard* board, uint32_t first, uint32_t second) {
+    if (first == LEADERBOARD_NO_PLAYER) {
+        return second;
+    }
+    if (second == LEADERBOARD_NO_PLAYER) {
+        return first;
+    }
+    PlayerNode* firstNode = nodeAt(board, first);
+    PlayerNode* secondNode = nodeAt(board, second);
+    if (firstNode->priority > secondNode->priority) {
+        firstNode->size += secondNode->size;
+        firstNode->right = mergeTrees(board, firstNode->right, second);
+        return first;
+    }
+    secondNode->size += firstNode->size;
+    secondNode->left = mergeTrees(board, first, secondNode->left);
+    return second;
+}
 
-    if (*head == NULL || (*head)->totalScore <= newNode->totalScore) {
-        newNode->next = *head;
-        if (*head != NULL) {
-            (*head)->prev = newNode;
+typedef struct {
+    LeaderboardEntry* out;
+    int k;
+    int count;
+    uint32_t skip;  // posições a pular antes de começar a copiar
+    int firstRank;
+} RangeCollector;
+
+// Percorre em ordem só até juntar k posições; as subárvores inteiramente dentro
+// do trecho pulado são descartadas pelo tamanho, sem visitar seus nós
+static void collectRange(const Leaderboard* board, uint32_t index, RangeCollector* collector) {
+    while (index != LEADERBOARD_NO_PLAYER && collector->count < collector->k) {
+        const PlayerNode* node = nodeAt(board, index);
+        uint32_t leftSize = subtreeSize(board, node->left);
+        if (collector->skip >= leftSize) {
+            collector->skip -= leftSize;
+        } else {
+            collectRange(board, node->left, collector);
+            if (collector->count >= collector->k) {
+                return;
+            }
         }
-        *head = newNode;
-    } else {
-        PlayerNode* current = *head;
-        while (current->next != NULL && current->next->totalScore > newNode->totalScore) {
-            current = current->next;
+        if (collector->skip > 0) {
+            collector->skip--;
+        } else {
+            LeaderboardEntry* entry = &collector->out[collector->count];
+            strcpy(entry->name, nameText(board, node->name));
+            entry->totalScore = node->totalScore;
+            entry->rank = collector->firstRank + collector->count;
+            entry->sequence = node->sequence;
+            collector->count++;
         }
-        newNode->next = current->next;
-        if (current->next != NULL) {
-            current->next->prev = newNode;
+        index = node->right;
+    }
+}
+
+static void visitInOrder(const Leaderboard* board, uint32_t index, void (*visit)(const PlayerNode* player, void* userData), void* userData) {
+    while (index != LEADERBOARD_NO_PLAYER) {
+        const PlayerNode* node = nodeAt(board, index);
+        visitInOrder(board, node->left, visit, userData);
+        visit(node, userData);
+        index = node->right;
+    }
+}
+
+uint32_t hashBytes(const void* bytes, size_t size) {
+    const unsigned char* data = (const unsigned char*)bytes;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t hashPlayerName(const char* name) {
+    size_t length = 0;
+    while (length < LEADERBOARD_NAME_MAX && name[length]) {
+        length++;
+    }
+    return hashBytes(name, length);
+}
+
+static int growNameIndex(Leaderboard* board, int capacity) {
+    uint32_t mask = (uint32_t)capacity - 1;
+    NameSlot* slots = (NameSlot*)calloc((size_t)capacity, sizeof(NameSlot));
+    if (slots == NULL) {
+        return 0;
+    }
+
+    for (int i = 0; i < board->nameCapacity; i++) {
+        if (board->nameSlots[i].name != 0) {
+            uint32_t index = board->nameSlots[i].hash & mask;
+            while (slots[index].name != 0) {
+                index = (index + 1) & mask;
+            }
+            slots[index] = board->nameSlots[i];
         }
-        current->next = newNode;
-        newNode->prev = current;
     }
+
+    free(board->nameSlots);
+    board->nameSlots = slots;
+    board->nameCapacity = capacity;
+    return 1;
 }
 
-PlayerNode* findByName(PlayerNode* head, const char* name) {
-    PlayerNode* current = head;
-    while (current != NULL) {
-        if (strcmp(current->name, name) == 0) {
-            return current;
+// Posição do nome na tabela ou, se ele ainda não estiver lá, a posição livre onde entraria
+static uint32_t findNameSlot(const Leaderboard* board, const char* name, uint32_t hash) {
+    uint32_t mask = (uint32_t)board->nameCapacity - 1;
+    uint32_t index = hash & mask;
+    while (board->nameSlots[index].name != 0) {
+        const NameSlot* slot = &board->nameSlots[index];
+        if (slot->hash == hash && strncmp(nameText(board, slot->name), name, LEADERBOARD_NAME_MAX) == 0) {
+            break;
         }
-        current = current->next;
+        index = (index + 1) & mask;
     }
-    return NULL;
+    return index;
 }
 
-void removePlayer(PlayerNode** head, PlayerNode* playerToRemove) {
-    if (!head || !*head || !playerToRemove) {
-        return;
+// Copia o texto para o último bloco de nomes (ou para um novo, se não couber); 0 se faltar memória
+static uint32_t storeNameText(Leaderboard* board, const char* name) {
+    uint32_t length = 0;
+    while (length < LEADERBOARD_NAME_MAX && name[length]) {
+        length++;
     }
 
-    if (*head == playerToRemove) {
-        *head = playerToRemove->next;
+    if (board->nameBlockCount == 0 || board->nameBlockUsed + length + 1 > NAME_BLOCK_BYTES) {
+        if (board->nameBlockCount == board->nameBlockCapacity) {
+            int capacity = board->nameBlockCapacity ? board->nameBlockCapacity * 2 : 8;
+            char** blocks = (char**)realloc(board->nameBlocks, sizeof(char*) * (size_t)capacity);
+            if (blocks == NULL) {
+                return 0;
+            }
+            board->nameBlocks = blocks;
+            board->nameBlockCapacity = capacity;
+        }
+        char* block = (char*)malloc(NAME_BLOCK_BYTES);
+        if (block == NULL) {
+            return 0;
+        }
+        board->nameBlocks[board->nameBlockCount++] = block;
+        board->nameBlockUsed = 0;
     }
-    if (playerToRemove->prev != NULL) {
-        playerToRemove->prev->next = playerToRemove->next;
+
+    uint32_t offset = board->nameBlockUsed;
+    char* text = board->nameBlocks[board->nameBlockCount - 1] + offset;
+    memcpy(text, name, length);
+    text[length] = '\0';
+    board->nameBlockUsed += length + 1;
+    return ((uint32_t)(board->nameBlockCount - 1) << LEADERBOARD_NAME_BLOCK_SHIFT | offset) + 1;
+}
+
+// Referência ao texto do nome, guardando-o na primeira vez; 0 se faltar memória
+static uint32_t internName(Leaderboard* board, const char* name) {
+    if ((board->nameCount + 1) * 2 > (uint32_t)board->nameCapacity &&
+        !growNameIndex(board, board->nameCapacity ? board->nameCapacity * 2 : 16)) {
+        return 0;
     }
-    if (playerToRemove->next != NULL) {
-        playerToRemove->next->prev = playerToRemove->prev;
+
+    uint32_t hash = hashPlayerName(name);
+    NameSlot* slot = &board->nameSlots[findNameSlot(board, name, hash)];
+    if (slot->name == 0) {
+        uint32_t text = storeNameText(board, name);
+        if (text == 0) {
+            return 0;
+        }
+        slot->hash = hash;
+        slot->name = text;
+        slot->player = LEADERBOARD_NO_PLAYER;
+        board->nameCount++;
     }
+    return slot->name;
+}
+
+// O nome já foi internado por createPlayer; só muda quem responde por ele
+static void setNameOwner(Leaderboard* board, const PlayerNode* player, uint32_t owner) {
+    const char* text = nameText(board, player->name);
+    board->nameSlots[findNameSlot(board, text, hashPlayerName(text))].player = owner;
+}
+
+static void addToNameIndex(Leaderboard* board, const PlayerNode* player) {
+    setNameOwner(board, player, player->self);
+}
 
-    playerToRemove->prev = NULL;
-    playerToRemove->next = NULL;
+static void removeFromNameIndex(Leaderboard* board, const PlayerNode* player) {
+    setNameOwner(board, player, LEADERBOARD_NO_PLAYER);
 }
 
-void freeLeaderboard(PlayerNode** head) {
-    if (!head) {
+// Pendura o nó na árvore sem mexer no índice de nomes
+static void attachToTree(Leaderboard* board, PlayerNode* newNode) {
+    newNode->priority = nextPriority(board);
+    newNode->sequence = ++board->nextSequence;
+
+    // Desce enquanto a prioridade dos nós for maior e pendura o novo nó ali,
+    // dividindo a subárvore que estava no lugar
+    uint32_t* link = &board->root;
+    while (*link != LEADERBOARD_NO_PLAYER) {
+        PlayerNode* node = nodeAt(board, *link);
+        if (node->priority < newNode->priority) {
+            break;
+        }
+        node->size++;
+        link = ranksBefore(newNode, node) ? &node->left : &node->right;
+    }
+    uint32_t beforeSize;
+    uint32_t afterSize;
+    splitTree(board, *link, newNode, &newNode->left, &newNode->right, &beforeSize, &afterSize);
+    newNode->size = beforeSize + afterSize + 1;
+    *link = newNode->self;
+    board->version++;
+    if (board->sketch != NULL) {
+        sketchAddScore(board->sketch, newNode->totalScore);
+    }
+}
+
+// Só para quem com certeza está na árvore
+static void unlinkFromTree(Leaderboard* board, PlayerNode* player) {
+    uint32_t* link = &board->root;
+    while (*link != player->self) {
+        PlayerNode* node = nodeAt(board, *link);
+        node->size--;
+        link = ranksBefore(player, node) ? &node->left : &node->right;
+    }
+    *link = mergeTrees(board, player->left, player->right);
+    board->version++;
+    if (board->sketch != NULL) {
+        sketchRemoveScore(board->sketch, player->totalScore);
+    }
+
+    player->left = LEADERBOARD_NO_PLAYER;
+    player->right = LEADERBOARD_NO_PLAYER;
+    player->size = 1;
+}
+
+static int detachFromTree(Leaderboard* board, PlayerNode* player) {
+    if (getPlayerRank(board, player) == 0) {
+        return 0;
+    }
+    unlinkFromTree(board, player);
+    return 1;
+}
+
+PlayerNode* createPlayer(Leaderboard* board, const char* name) {
+    if (!board) {
+        return NULL;
+    }
+
+    PlayerNode* newNode = allocateNode(board);
+    if (newNode) {
+        newNode->name = internName(board, name ? name : "");
+        if (newNode->name == 0) {
+            releaseNode(board, newNode);
+            return NULL;
+        }
+        newNode->totalScore = 0;
+        newNode->priority = 0;
+        newNode->sequence = 0;
+        newNode->size = 1;
+        newNode->left = LEADERBOARD_NO_PLAYER;
+        newNode->right = LEADERBOARD_NO_PLAYER;
+    }
+    return newNode;
+}
+
+void insertSorted(Leaderboard* board, PlayerNode* newNode) {
+    if (!board || !newNode) {
         return;
     }
 
-    PlayerNode* current = *head;
-    while (current != NULL) {
-        PlayerNode* nextNode = current->next;
-        free(current);
-        current = nextNode;
+    addToNameIndex(board, newNode);
+    attachToTree(board, newNode);
+}
+
+PlayerNode* findByName(const Leaderboard* board, const char* name) {
+    if (!board || !name || board->nameCapacity == 0) {
+        return NULL;
+    }
+
+    // Posição livre ou nome de quem saiu do placar: player é LEADERBOARD_NO_PLAYER
+    return nodeAt(board, board->nameSlots[findNameSlot(board, name, hashPlayerName(name))].player);
+}
+
+const char* getPlayerName(const Leaderboard* board, const PlayerNode* player) {
+    if (!board || !player || player->name == 0) {
+        return "";
     }
-    *head = NULL;
+    return nameText(board, player->name);
 }
 
-void updateScore(PlayerNode** head, const char* name, int pointsToAdd) {
-    if (!head || !name) {
+void removePlayer(Leaderboard* board, PlayerNode* playerToRemove) {
+    if (!board || !playerToRemove) {
         return;
     }
 
-    PlayerNode* player = findByName(*head, name);
-    if (player == NULL) {
-        player = createPlayer(name);
-    } else {
-        removePlayer(head, player);
+    if (detachFromTree(board, playerToRemove)) {
+        removeFromNameIndex(board, playerToRemove);
+        releaseNode(board, playerToRemove);
+    }
+}
+
+void freeLeaderboard(Leaderboard* board) {
+    if (!board) {
+        return;
+    }
+
+    // Os nós saem junto com os blocos, sem percorrer a árvore
+    for (int i = 0; i < board->chunkCount; i++) {
+        free(board->chunks[i]);
+    }
+    free(board->chunks);
+    free(board->nameSlots);
+    for (int i = 0; i < board->nameBlockCount; i++) {
+        free(board->nameBlocks[i]);
     }
+    free(board->nameBlocks);
+    uint32_t version = board->version;
+    ScoreSketch* sketch = board->sketch;
+    memset(board, 0, sizeof(*board));
+    board->version = version + 1;
+    board->sketch = sketch;
+    clearScoreSketch(sketch);
+}
 
+void updateScore(Leaderboard* board, const char* name, int pointsToAdd) {
+    if (!board || !name) {
+        return;
+    }
+
+    // Quem já está no placar só muda de lugar na árvore; o índice de nomes continua valendo
+    PlayerNode* player = findByName(board, name);
     if (player != NULL) {
+        unlinkFromTree(board, player);
         player->totalScore += pointsToAdd;
-        insertSorted(head, player);
+        attachToTree(board, player);
+        return;
+    }
+
+    player = createPlayer(board, name);
+    if (player != NULL) {
+        player->totalScore = pointsToAdd;
+        insertSorted(board, player);
     }
 }
 
+int getPlayerCount(const Leaderboard* board) {
+    return board ? (int)subtreeSize(board, board->root) : 0;
+}
+
+int getPlayerRank(const Leaderboard* board, const PlayerNode* player) {
+    if (!board || !player) {
+        return 0;
+    }
+
+    // Desce pela chave do jogador somando quem ficou à esquerda
+    int rank = 1;
+    uint32_t index = board->root;
+    while (index != LEADERBOARD_NO_PLAYER) {
+        const PlayerNode* node = nodeAt(board, index);
+        if (node == player) {
+            return rank + (int)subtreeSize(board, node->left);
+        }
+        if (ranksBefore(player, node)) {
+            index = node->left;
+        } else {
+            rank += (int)subtreeSize(board, node->left) + 1;
+            index = node->right;
+        }
+    }
+    return 0;
+}
+
+PlayerNode* getPlayerAtRank(const Leaderboard* board, int rank) {
+    if (!board || rank < 1 || rank > getPlayerCount(board)) {
+        return NULL;
+    }
+
+    uint32_t index = board->root;
+    while (index != LEADERBOARD_NO_PLAYER) {
+        PlayerNode* node = nodeAt(board, index);
+        int leftSize = (int)subtreeSize(board, node->left);
+        if (rank == leftSize + 1) {
+            return node;
+        }
+        if (rank <= leftSize) {
+            index = node->left;
+        } else {
+            rank -= leftSize + 1;
+            index = node->right;
+        }
+    }
+    return NULL;
+}
+
+// Ordenação radix estável (LSD, 8 bits por passada) de índices de nós pela
+// pontuação, maior primeiro; empates mantêm a ordem de entrada
+static int sortByScore(const Leaderboard* board, uint32_t* order, int count) {
+    uint32_t* keys = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)count * 2);
+    uint32_t* scratch = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)count);
+    if (keys == NULL || scratch == NULL) {
+        free(keys);
+        free(scratch);
+        return 0;
+    }
+
+    // Inverter a chave deixa a ordem crescente dos bytes igual à decrescente das pontuações
+    uint32_t* scratchKeys = keys + count;
+    for (int i = 0; i < count; i++) {
+        keys[i] = ~((uint32_t)nodeAt(board, order[i])->totalScore ^ 0x80000000u);
+    }
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        int offsets[257] = {0};
+        for (int i = 0; i < count; i++) {
+            offsets[((keys[i] >> shift) & 0xFF) + 1]++;
+        }
+        for (int bucket = 0; bucket < 256; bucket++) {
+            offsets[bucket + 1] += offsets[bucket];
+        }
+        for (int i = 0; i < count; i++) {
+            int position = offsets[(keys[i] >> shift) & 0xFF]++;
+            scratchKeys[position] = keys[i];
+            scratch[position] = order[i];
+        }
+        memcpy(keys, scratchKeys, sizeof(uint32_t) * (size_t)count);
+        memcpy(order, scratch, sizeof(uint32_t) * (size_t)count);
+    }
+
+    free(keys);
+    free(scratch);
+    return 1;
+}
+
+// Monta a treap de uma sequência já ordenada em tempo linear (árvore cartesiana
+// pelas prioridades), mantendo na pilha o caminho mais à direita. 'stack' precisa
+// de 'count' posições. Retorna a raiz.
+static uint32_t linkSorted(Leaderboard* board, const uint32_t* order, int count, uint32_t* stack) {
+    int top = 0;
+    for (int i = 0; i < count; i++) {
+        PlayerNode* node = nodeAt(board, order[i]);
+        node->priority = nextPriority(board);
+
+        // Quem sai da pilha já tem a subárvore completa
+        uint32_t last = LEADERBOARD_NO_PLAYER;
+        while (top > 0 && nodeAt(board, stack[top - 1])->priority < node->priority) {
+            last = stack[--top];
+            updateSize(board, nodeAt(board, last));
+        }
+        node->left = last;
+        node->right = LEADERBOARD_NO_PLAYER;
+        if (top > 0) {
+            nodeAt(board, stack[top - 1])->right = order[i];
+        }
+        stack[top++] = order[i];
+    }
+    while (top > 0) {
+        updateSize(board, nodeAt(board, stack[--top]));
+    }
+    return count > 0 ? stack[0] : LEADERBOARD_NO_PLAYER;
+}
+
+static int buildFromSorted(Leaderboard* board, const uint32_t* order, int count) {
+    uint32_t* stack = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)(count > 0 ? count : 1));
+    if (stack == NULL) {
+        return 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        PlayerNode* node = nodeAt(board, order[i]);
+        node->sequence = (uint32_t)(count - i); // quem vem antes nos empates tem sequência maior
+        if (board->sketch != NULL) {
+            sketchAddScore(board->sketch, node->totalScore);
+        }
+    }
+    board->root = linkSorted(board, order, count, stack);
+    board->nextSequence = (uint32_t)count;
+    board->version++;
+    free(stack);
+    return 1;
+}
+
+int bulkLoadLeaderboard(Leaderboard* board, const PlayerScore* players, int count) {
+    if (!board || getPlayerCount(board) != 0 || count < 0 || (count > 0 && !players)) {
+        return 0;
+    }
+
+    int capacity = 16;
+    while ((uint32_t)capacity < (board->nameCount + (uint32_t)count) * 2) {
+        capacity *= 2;
+    }
+    uint32_t* order = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)(count > 0 ? count : 1));
+    if (order == NULL || (capacity > board->nameCapacity && !growNameIndex(board, capacity))) {
+        free(order);
+        return 0;
+    }
+
+    // Nomes repetidos somam no mesmo jogador, como faria updateScore
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        PlayerNode* player = findByName(board, players[i].name);
+        if (player != NULL) {
+            player->totalScore += players[i].totalScore;
+            continue;
+        }
+        player = createPlayer(board, players[i].name);
+        if (player == NULL) {
+            free(order);
+            freeLeaderboard(board);
+            return 0;
+        }
+        player->totalScore = players[i].totalScore;
+        addToNameIndex(board, player);
+        order[unique++] = player->self;
+    }
+
+    if (!sortByScore(board, order, unique) || !buildFromSorted(board, order, unique)) {
+        free(order);
+        freeLeaderboard(board);
+        return 0;
+    }
+    free(order);
+    return 1;
+}
+
+int copyLeaderboardTree(const Leaderboard* board, Leaderboard* copy) {
+    if (!board || !copy) {
+        return 0;
+    }
+
+    memset(copy, 0, sizeof(*copy));
+    copy->root = board->root;
+    copy->version = board->version;
+    copy->nextSequence = board->nextSequence;
+    copy->randomState = board->randomState;
+    copy->usedNodes = board->usedNodes;
+    copy->freeList = board->freeList;
+    copy->nameBlockUsed = board->nameBlockUsed;
+
+    copy->chunks = (PlayerNode**)malloc(sizeof(PlayerNode*) * (size_t)(board->chunkCount + 1));
+    copy->nameBlocks = (char**)malloc(sizeof(char*) * (size_t)(board->nameBlockCount + 1));
+    if (copy->chunks == NULL || copy->nameBlocks == NULL) {
+        freeLeaderboard(copy);
+        memset(copy, 0, sizeof(*copy));
+        return 0;
+    }
+    copy->chunkCapacity = board->chunkCount + 1;
+    copy->nameBlockCapacity = board->nameBlockCount + 1;
+    for (int i = 0; i < board->chunkCount; i++) {
+        copy->chunks[i] = (PlayerNode*)malloc(sizeof(PlayerNode) * CHUNK_NODES);
+        if (copy->chunks[i] == NULL) {
+            freeLeaderboard(copy);
+            memset(copy, 0, sizeof(*copy));
+            return 0;
+        }
+        copy->chunkCount++;
+        memcpy(copy->chunks[i], board->chunks[i], sizeof(PlayerNode) * CHUNK_NODES);
+    }
+    for (int i = 0; i < board->nameBlockCount; i++) {
+        copy->nameBlocks[i] = (char*)malloc(NAME_BLOCK_BYTES);
+        if (copy->nameBlocks[i] == NULL) {
+            freeLeaderboard(copy);
+            memset(copy, 0, sizeof(*copy));
+            return 0;
+        }
+        copy->nameBlockCount++;
+        // Só o último bloco pode estar pela metade
+        memcpy(copy->nameBlocks[i], board->nameBlocks[i],
+               i + 1 < board->nameBlockCount ? NAME_BLOCK_BYTES : board->nameBlockUsed);
+    }
+    return 1;
+}
+
+#define BATCH_SMALL_SIZE 64 // até aqui os repetidos se acham numa busca linear, sem tabela
+
+// Jogador do lote, os pontos somados de todas as aparições e a última delas
+// (define o desempate)
+typedef struct {
+    PlayerNode* player;
+    int points;
+    int last;
+    int inTree; // 0 = criado agora pelo lote
+} BatchItem;
+
+static int compareLastUpdate(const void* a, const void* b) {
+    return ((const BatchItem*)a)->last - ((const BatchItem*)b)->last;
+}
+
+int applyScoreBatch(Leaderboard* board, const ScoreDelta* deltas, int count) {
+    if (!board || count < 0 || (count > 0 && !deltas)) {
+        return 0;
+    }
+    if (count == 0) {
+        return 1;
+    }
+    if (count == 1) {
+        updateScore(board, deltas[0].name, deltas[0].points);
+        return 1;
+    }
+
+    // Lotes grandes juntam os repetidos numa tabela local nó -> item, com no
+    // máximo metade das posições ocupadas; os tamanhos são contados em size_t
+    BatchItem smallItems[BATCH_SMALL_SIZE];
+    BatchItem* items = smallItems;
+    uint32_t* seen = NULL;
+    uint32_t seenMask = 0;
+    if (count > BATCH_SMALL_SIZE) {
+        if ((size_t)count > SIZE_MAX / 16 / sizeof(BatchItem)) {
+            return 0;
+        }
+        size_t seenCapacity = 16;
+        while (seenCapacity < (size_t)count * 2) {
+            seenCapacity *= 2;
+        }
+        items = (BatchItem*)malloc(sizeof(BatchItem) * (size_t)count);
+        seen = (uint32_t*)calloc(seenCapacity, sizeof(uint32_t));
+        if (items == NULL || seen == NULL) {
+            free(items);
+            free(seen);
+            return 0;
+        }
+        seenMask = (uint32_t)(seenCapacity - 1);
+    }
+
+    int itemCount = 0;
+    for (int i = 0; i < count; i++) {
+        if (!deltas[i].name) {
+            continue;
+        }
+        PlayerNode* player = findByName(board, deltas[i].name);
+        int inTree = player != NULL;
+        if (player == NULL) {
+            player = createPlayer(board, deltas[i].name);
+            if (player == NULL) {
+                continue;
+            }
+            addToNameIndex(board, player);
+        }
+
+        int item = 0;
+        if (seen != NULL) {
+            uint32_t slot = (player->self * 2654435761u) & seenMask;
+            while (seen[slot] != 0 && items[seen[slot] - 1].player != player) {
+                slot = (slot + 1) & seenMask;
+            }
+            item = seen[slot] != 0 ? (int)seen[slot] - 1 : itemCount;
+            seen[slot] = (uint32_t)item + 1;
+        } else {
+            while (item < itemCount && items[item].player != player) {
+                item++;
+            }
+        }
+        if (item == itemCount) {
+            items[item].player = player;
+            items[item].points = 0;
+            items[item].inTree = inTree;
+            itemCount++;
+        }
+        items[item].points += deltas[i].points;
+        items[item].last = i;
+    }
+
+    // Cada jogador muda de lugar uma vez só, na ordem da última aparição, para o
+    // desempate sair igual ao de updateScore chamado em ordem
+    qsort(items, (size_t)itemCount, sizeof(BatchItem), compareLastUpdate);
+    for (int i = 0; i < itemCount; i++) {
+        PlayerNode* player = items[i].player;
+        if (items[i].inTree) {
+            unlinkFromTree(board, player);
+        }
+        player->totalScore += items[i].points;
+        attachToTree(board, player);
+    }
+
+    if (items != smallItems) {
+        free(items);
+    }
+    free(seen);
+    return 1;
+}
+
+static void addToSketch(const PlayerNode* player, void* sketch) {
+    sketchAddScore((ScoreSketch*)sketch, player->totalScore);
+}
+
+void setScoreSketch(Leaderboard* board, ScoreSketch* sketch) {
+    if (!board) {
+        return;
+    }
+
+    board->sketch = sketch;
+    if (sketch != NULL) {
+        clearScoreSketch(sketch);
+        visitInOrder(board, board->root, addToSketch, sketch);
+    }
+}
+
+int getTopK(const Leaderboard* board, int k, LeaderboardEntry out[]) {
+    if (!board || !out || k <= 0) {
+        return 0;
+    }
+
+    return getRankRange(board, 1, k, out);
+}
+
+int getRankRange(const Leaderboard* board, int firstRank, int count, LeaderboardEntry out[]) {
+    if (!board || !out || count <= 0 || firstRank < 1) {
+        return 0;
+    }
+
+    RangeCollector collector = { out, count, 0, (uint32_t)firstRank - 1, firstRank };
+    collectRange(board, board->root, &collector);
+    return collector.count;
+}
+
+int getRank(const Leaderboard* board, const char* name) {
+    return getPlayerRank(board, findByName(board, name));
+}
+
+int getNeighborhood(const Leaderboard* board, const char* name, int k, LeaderboardEntry out[]) {
+    if (k < 0) {
+        return 0;
+    }
+
+    int rank = getRank(board, name);
+    if (rank == 0) {
+        return 0;
+    }
+    int below = getPlayerCount(board) - rank;
+    int first = rank > k ? rank - k : 1;
+    return getRankRange(board, first, rank - first + 1 + (below < k ? below : k), out);
+}
+
+void forEachPlayer(const Leaderboard* board, void (*visit)(const PlayerNode* player, void* userData), void* userData) {
+    if (!board || !visit) {
+        return;
+    }
+    visitInOrder(board, board->root, visit, userData);
+}
@@ -1,19 +1,137 @@
 #ifndef LEADERBOARD_H
 #define LEADERBOARD_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include "score_sketch.h"
+
+// Placar ordenado por pontuação (maior primeiro) guardado numa treap com
+// tamanho de subárvore, para atualizar, achar a posição e o k-ésimo em O(log n).
+// Entre pontuações iguais, quem foi atualizado por último fica na frente.
+// Uma tabela hash à parte acha o jogador pelo nome em O(1).
+//
+// Os nós moram em blocos contíguos do próprio placar (slab) e se ligam por
+// índices de 32 bits; o índice 0 (LEADERBOARD_NO_PLAYER) significa "nenhum".
+// O nó só tem o que a árvore usa (32 bytes, dois por linha de cache). Os nomes
+// ficam à parte, internados em blocos de texto: cada nome distinto é guardado
+// uma vez e o nó aponta para ele por uma referência de 32 bits.
+
+#define LEADERBOARD_NO_PLAYER 0u
+#define LEADERBOARD_CHUNK_SHIFT 10      // 1024 nós por bloco
+#define LEADERBOARD_NAME_BLOCK_SHIFT 16 // 64 KB de texto por bloco de nomes
+#define LEADERBOARD_NAME_MAX 49         // caracteres guardados de cada nome (o que cabe no char name[50])
+
 typedef struct PlayerNode {
-    char name[50];
     int totalScore;
-    struct PlayerNode* next;
-    struct PlayerNode* prev;
+    uint32_t sequence; // ordem de inserção, desempata pontuações iguais
+    uint32_t size;     // nós na subárvore, incluindo este
+    uint32_t left;     // nos nós livres, encadeia a lista de livres
+    uint32_t right;
+    uint32_t priority;
+    uint32_t self;     // índice deste nó no slab
+    uint32_t name;     // texto internado; leia com getPlayerName
 } PlayerNode;
 
-PlayerNode* createPlayer(const char* name);
-void insertSorted(PlayerNode** head, PlayerNode* newNode);
-PlayerNode* findByName(PlayerNode* head, const char* name);
-void removePlayer(PlayerNode** head, PlayerNode* playerToRemove);
-void freeLeaderboard(PlayerNode** head);
-void updateScore(PlayerNode** head, const char* name, int pointsToAdd);
+// Posição da tabela de nomes; o hash fica guardado para evitar a maioria dos strcmp.
+// Um nome ganha a sua posição na primeira vez que aparece e fica nela até o
+// freeLeaderboard, mesmo que o jogador saia do placar.
+typedef struct {
+    uint32_t hash;
+    uint32_t name;   // referência ao texto; 0 = posição livre
+    uint32_t player; // LEADERBOARD_NO_PLAYER = ninguém com esse nome no placar
+} NameSlot;
 
-#endif /* LEADERBOARD_H */
+// Cópia compacta de uma posição do placar, para quem só precisa exibir
+typedef struct {
+    char name[50];
+    int totalScore;
+    int rank;
+    uint32_t sequence; // do nó: entre pontuações iguais, a maior vem antes
+} LeaderboardEntry;
+
+// Entrada da carga em lote
+typedef struct {
+    const char* name;
+    int totalScore;
+} PlayerScore;
+
+// Um Leaderboard zerado ({0}) já é um placar vazio válido
+typedef struct Leaderboard {
+    uint32_t root;
+    uint32_t version;    // muda a cada alteração; quem guarda cópias compara para saber se ficaram velhas
+    uint32_t nextSequence;
+    uint32_t randomState;
+    PlayerNode** chunks; // blocos de (1 << LEADERBOARD_CHUNK_SHIFT) nós, nunca se movem
+    int chunkCount;
+    int chunkCapacity;
+    uint32_t usedNodes;  // nós já entregues alguma vez; os devolvidos vão para freeList
+    uint32_t freeList;
+    NameSlot* nameSlots; // endereçamento aberto com sondagem linear, no máximo meio cheio
+    int nameCapacity;    // potência de 2
+    uint32_t nameCount;  // nomes internados (posições ocupadas)
+    char** nameBlocks;   // texto dos nomes, blocos que nunca se movem
+    int nameBlockCount;
+    int nameBlockCapacity;
+    uint32_t nameBlockUsed; // bytes já usados no último bloco
+    ScoreSketch* sketch; // opcional; acompanha as pontuações de quem está na árvore
+} Leaderboard;
 
+// FNV-1a, o hash de todo o placar. hashPlayerName só olha os primeiros
+// LEADERBOARD_NAME_MAX caracteres, que é o que o placar guarda: nomes que só
+// diferem depois disso são o mesmo jogador e têm o mesmo hash em qualquer índice.
+uint32_t hashBytes(const void* bytes, size_t size);
+uint32_t hashPlayerName(const char* name);
+
+PlayerNode* createPlayer(Leaderboard* board, const char* name); // nó do slab, ainda fora do placar
+void insertSorted(Leaderboard* board, PlayerNode* newNode);    // nó vindo de createPlayer; não aloca nada
+PlayerNode* findByName(const Leaderboard* board, const char* name);
+const char* getPlayerName(const Leaderboard* board, const PlayerNode* player); // até 49 caracteres
+void removePlayer(Leaderboard* board, PlayerNode* playerToRemove); // o nó volta ao slab
+void freeLeaderboard(Leaderboard* board);
+void updateScore(Leaderboard* board, const char* name, int pointsToAdd);
+
+// Pontos de uma rodada para um jogador
+typedef struct {
+    const char* name;
+    int points;
+} ScoreDelta;
+
+// Aplica vários updateScore de uma vez: nomes repetidos são somados e cada jogador
+// muda de lugar uma vez só, então o ganho vem das repetições (um lote sem nomes
+// repetidos custa o mesmo que updateScore um a um). O resultado é o mesmo de
+// chamar updateScore na ordem. Retorna 0 se faltar memória para o lote (aí nada
+// muda); um jogador novo sem memória fica de fora, como em updateScore.
+int applyScoreBatch(Leaderboard* board, const ScoreDelta* deltas, int count);
+
+// Carrega um placar vazio de uma vez: ordena as pontuações (radix, O(n)) e monta
+// a árvore e o índice de nomes em tempo linear. Nomes repetidos são somados e,
+// nos empates, quem vem antes na entrada fica na frente. Retorna 0 se o placar
+// não estiver vazio ou se faltar memória (nesse caso ele termina vazio).
+int bulkLoadLeaderboard(Leaderboard* board, const PlayerScore* players, int count);
+
+// Copia só a árvore e o texto dos nomes (os blocos inteiros, sem percorrer nada),
+// sem o índice de nomes nem o histograma. A cópia responde a forEachPlayer,
+// getTopK, getPlayerName e afins mas não acha ninguém por nome; serve para ler um
+// retrato do placar em outra thread. 'copy' é sobrescrito; retorna 0 se faltar memória.
+int copyLeaderboardTree(const Leaderboard* board, Leaderboard* copy);
+
+// Liga um histograma ao placar (NULL desliga): ele é zerado, recebe os jogadores
+// atuais e daí em diante cada mudança de pontuação custa O(1) a mais. O placar
+// não é dono do histograma; freeLeaderboard só o zera.
+void setScoreSketch(Leaderboard* board, ScoreSketch* sketch);
+
+int getPlayerCount(const Leaderboard* board);
+int getPlayerRank(const Leaderboard* board, const PlayerNode* player); // 1 = primeiro, 0 = fora do placar
+PlayerNode* getPlayerAtRank(const Leaderboard* board, int rank);
+int getTopK(const Leaderboard* board, int k, LeaderboardEntry out[]); // retorna quantas posições foram copiadas
+int getRankRange(const Leaderboard* board, int firstRank, int count, LeaderboardEntry out[]); // O(log n + count)
+
+// Atalhos por nome, em O(log n): getRank dá 0 se o jogador não estiver no placar;
+// getNeighborhood copia até k posições acima e k abaixo dele, ele incluído
+// (out precisa de 2k + 1 posições), e retorna quantas copiou
+int getRank(const Leaderboard* board, const char* name);
+int getNeighborhood(const Leaderboard* board, const char* name, int k, LeaderboardEntry out[]);
+void forEachPlayer(const Leaderboard* board, void (*visit)(const PlayerNode* player, void* userData), void* userData); // em ordem de posição
+
+#endif /* LEADERBOARD_H */
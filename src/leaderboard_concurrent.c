@@ -0,0 +1,243 @@
+#include "leaderboard_concurrent.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lock_utils.h"
+
+static void fillView(SnapshotView* view, const Leaderboard* board, const char* localPlayer) {
+    view->version = board->version;
+    view->count = getTopK(board, CONCURRENT_TOP_ENTRIES, view->top);
+    view->neighborCount = localPlayer[0] ? getNeighborhood(board, localPlayer, CONCURRENT_NEIGHBORS, view->neighbors) : 0;
+}
+
+static LeaderboardSnapshot* takeSnapshot(const ConcurrentLeaderboard* shared) {
+    LeaderboardSnapshot* snapshot = (LeaderboardSnapshot*)calloc(1, sizeof(LeaderboardSnapshot));
+    if (snapshot) {
+        snapshot->playerCount = getPlayerCount(shared->board);
+        fillView(&snapshot->views[SNAPSHOT_ALL_TIME], shared->board, shared->localPlayer);
+        if (shared->windows != NULL) {
+            for (int i = 0; i < LEADERBOARD_WINDOW_COUNT; i++) {
+                fillView(&snapshot->views[1 + i], &shared->windows->windows[i].board, shared->localPlayer);
+            }
+        }
+        snapshot->nextRetired = NULL;
+        snapshot->retiredEpoch = 0;
+    }
+    return snapshot;
+}
+
+// Libera os snapshots aposentados antes da época mais antiga que algum leitor ainda anuncia
+static void reclaimSnapshots(ConcurrentLeaderboard* shared) {
+    uint64_t oldest = UINT64_MAX;
+    for (int i = 0; i < CONCURRENT_MAX_READERS; i++) {
+        uint64_t epoch = atomic_load(&shared->readerEpochs[i]);
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    LeaderboardSnapshot** link = &shared->retired;
+    while (*link != NULL) {
+        LeaderboardSnapshot* snapshot = *link;
+        if (snapshot->retiredEpoch < oldest) {
+            *link = snapshot->nextRetired;
+            free(snapshot);
+        } else {
+            link = &snapshot->nextRetired;
+        }
+    }
+}
+
+// Chamado com o mutex. Um leitor que anunciou a época E antes da troca pode
+// ainda estar com o snapshot antigo; quem anunciar depois do incremento já vê o novo.
+static void publishSnapshot(ConcurrentLeaderboard* shared) {
+    LeaderboardSnapshot* snapshot = takeSnapshot(shared);
+    if (snapshot == NULL) {
+        return; // os leitores continuam com o anterior até a próxima atualização
+    }
+
+    LeaderboardSnapshot* old = atomic_exchange(&shared->current, snapshot);
+    if (old != NULL) {
+        old->retiredEpoch = atomic_fetch_add(&shared->epoch, 1);
+        old->nextRetired = shared->retired;
+        shared->retired = old;
+    }
+    reclaimSnapshots(shared);
+}
+
+int initConcurrentLeaderboard(ConcurrentLeaderboard* shared, Leaderboard* board, LeaderboardStore* store, LeaderboardWindows* windows) {
+    if (!shared || !board) {
+        return 0;
+    }
+
+    shared->board = board;
+    shared->store = store;
+    shared->windows = windows;
+    shared->localPlayer[0] = '\0';
+    shared->retired = NULL;
+    atomic_init(&shared->windowsDueAt, windows ? nextWindowRotation(windows) : INT64_MAX);
+    atomic_init(&shared->epoch, 1);
+    for (int i = 0; i < CONCURRENT_MAX_READERS; i++) {
+        atomic_init(&shared->readerEpochs[i], 0);
+        atomic_init(&shared->readerInUse[i], 0);
+    }
+
+    shared->lock = createLock();
+    LeaderboardSnapshot* snapshot = takeSnapshot(shared);
+    if (shared->lock == NULL || snapshot == NULL) {
+        if (shared->lock) {
+            destroyLock(shared->lock);
+            shared->lock = NULL;
+        }
+        free(snapshot);
+        atomic_init(&shared->current, NULL);
+        return 0;
+    }
+    atomic_init(&shared->current, snapshot);
+    return 1;
+}
+
+void destroyConcurrentLeaderboard(ConcurrentLeaderboard* shared) {
+    if (!shared || shared->lock == NULL) {
+        return;
+    }
+
+    free(atomic_exchange(&shared->current, NULL));
+    while (shared->retired != NULL) {
+        LeaderboardSnapshot* next = shared->retired->nextRetired;
+        free(shared->retired);
+        shared->retired = next;
+    }
+    destroyLock(shared->lock);
+    shared->lock = NULL;
+}
+
+void concurrentUpdateScore(ConcurrentLeaderboard* shared, const char* name, int pointsToAdd) {
+    if (!shared || shared->lock == NULL || !name) {
+        return;
+    }
+
+    acquireLock(shared->lock);
+    if (shared->store != NULL) {
+        storeUpdateScore(shared->store, name, pointsToAdd);
+    } else {
+        updateScore(shared->board, name, pointsToAdd);
+    }
+    if (shared->windows != NULL) {
+        recordWindowScore(shared->windows, name, pointsToAdd, (int64_t)time(NULL));
+        atomic_store(&shared->windowsDueAt, nextWindowRotation(shared->windows));
+    }
+    publishSnapshot(shared);
+    releaseLock(shared->lock);
+}
+
+void concurrentApplyScoreBatch(ConcurrentLeaderboard* shared, const ScoreDelta* deltas, int count, char letter) {
+    if (!shared || shared->lock == NULL || !deltas || count <= 0) {
+        return;
+    }
+
+    acquireLock(shared->lock);
+    if (shared->store != NULL) {
+        storeApplyScoreBatch(shared->store, deltas, count, letter);
+    } else if (!applyScoreBatch(shared->board, deltas, count)) {
+        for (int i = 0; i < count; i++) {
+            updateScore(shared->board, deltas[i].name, deltas[i].points);
+        }
+    }
+    if (shared->windows != NULL) {
+        int64_t now = (int64_t)time(NULL);
+        for (int i = 0; i < count; i++) {
+            recordWindowScore(shared->windows, deltas[i].name, deltas[i].points, now);
+        }
+        atomic_store(&shared->windowsDueAt, nextWindowRotation(shared->windows));
+    }
+    publishSnapshot(shared); // um snapshot para o lote todo
+    releaseLock(shared->lock);
+}
+
+int concurrentGetPlayerRank(ConcurrentLeaderboard* shared, const char* name) {
+    if (!shared || shared->lock == NULL || !name) {
+        return 0;
+    }
+
+    acquireLock(shared->lock);
+    int rank = getPlayerRank(shared->board, findByName(shared->board, name));
+    releaseLock(shared->lock);
+    return rank;
+}
+
+void concurrentSetLocalPlayer(ConcurrentLeaderboard* shared, const char* name) {
+    if (!shared || shared->lock == NULL) {
+        return;
+    }
+
+    acquireLock(shared->lock);
+    if (name) {
+        strncpy(shared->localPlayer, name, sizeof(shared->localPlayer) - 1);
+        shared->localPlayer[sizeof(shared->localPlayer) - 1] = '\0';
+    } else {
+        shared->localPlayer[0] = '\0';
+    }
+    publishSnapshot(shared);
+    releaseLock(shared->lock);
+}
+
+void concurrentAdvanceWindows(ConcurrentLeaderboard* shared) {
+    if (!shared || shared->lock == NULL || shared->windows == NULL) {
+        return;
+    }
+
+    int64_t now = (int64_t)time(NULL);
+    if (now < atomic_load(&shared->windowsDueAt)) {
+        return;
+    }
+
+    acquireLock(shared->lock);
+    if (advanceLeaderboardWindows(shared->windows, now)) {
+        publishSnapshot(shared);
+    }
+    atomic_store(&shared->windowsDueAt, nextWindowRotation(shared->windows));
+    releaseLock(shared->lock);
+}
+
+int registerLeaderboardReader(ConcurrentLeaderboard* shared) {
+    if (!shared) {
+        return -1;
+    }
+
+    for (int i = 0; i < CONCURRENT_MAX_READERS; i++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&shared->readerInUse[i], &expected, 1)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void unregisterLeaderboardReader(ConcurrentLeaderboard* shared, int reader) {
+    if (!shared || reader < 0 || reader >= CONCURRENT_MAX_READERS) {
+        return;
+    }
+    atomic_store(&shared->readerEpochs[reader], 0);
+    atomic_store(&shared->readerInUse[reader], 0);
+}
+
+const LeaderboardSnapshot* beginLeaderboardRead(ConcurrentLeaderboard* shared, int reader) {
+    if (!shared || reader < 0 || reader >= CONCURRENT_MAX_READERS) {
+        return NULL;
+    }
+
+    // Anuncia a época antes de ler o ponteiro; quem escreve não libera nada
+    // aposentado a partir desta época enquanto o anúncio estiver de pé
+    atomic_store(&shared->readerEpochs[reader], atomic_load(&shared->epoch));
+    return atomic_load(&shared->current);
+}
+
+void endLeaderboardRead(ConcurrentLeaderboard* shared, int reader) {
+    if (!shared || reader < 0 || reader >= CONCURRENT_MAX_READERS) {
+        return;
+    }
+    atomic_store(&shared->readerEpochs[reader], 0);
+}
@@ -0,0 +1,76 @@
+#ifndef LEADERBOARD_CONCURRENT_H
+#define LEADERBOARD_CONCURRENT_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "leaderboard.h"
+#include "leaderboard_store.h"
+#include "leaderboard_windows.h"
+
+// Placar compartilhado entre threads. Quem escreve passa por um mutex e, a cada
+// alteração, publica um snapshot imutável do topo. Quem lê pega o snapshot atual
+// com uma leitura atômica, sem nunca esperar pelo mutex. Snapshots antigos só são
+// liberados quando nenhum leitor pode mais estar com eles (reclamação por épocas).
+// Se houver janelas (24h / 7 dias), o snapshot leva também o topo de cada uma, e
+// cada visão leva as posições em volta do jogador local.
+
+#define CONCURRENT_TOP_ENTRIES 10
+#define CONCURRENT_NEIGHBORS 1 // posições acima e abaixo do jogador local
+#define CONCURRENT_MAX_READERS 16
+
+// views[SNAPSHOT_ALL_TIME] é o placar geral; views[1 + janela], as janelas
+#define SNAPSHOT_ALL_TIME 0
+#define SNAPSHOT_VIEW_COUNT (LEADERBOARD_WINDOW_COUNT + 1)
+
+typedef struct {
+    uint32_t version; // do Leaderboard de onde a visão saiu
+    int count;
+    LeaderboardEntry top[CONCURRENT_TOP_ENTRIES];
+    int neighborCount; // 0 = jogador local fora deste placar
+    LeaderboardEntry neighbors[2 * CONCURRENT_NEIGHBORS + 1];
+} SnapshotView;
+
+typedef struct LeaderboardSnapshot {
+    int playerCount;
+    SnapshotView views[SNAPSHOT_VIEW_COUNT];
+    struct LeaderboardSnapshot* nextRetired;
+    uint64_t retiredEpoch;
+} LeaderboardSnapshot;
+
+typedef struct {
+    Leaderboard* board;      // só é tocado com o mutex
+    LeaderboardStore* store; // opcional; se houver, as atualizações passam pelo WAL
+    LeaderboardWindows* windows; // opcional, só com o mutex
+    _Atomic int64_t windowsDueAt; // quando alguma janela precisa girar
+    char localPlayer[50];         // só com o mutex; vazio = sem vizinhança
+    void* lock;
+    _Atomic(LeaderboardSnapshot*) current;
+    _Atomic uint64_t epoch;
+    _Atomic uint64_t readerEpochs[CONCURRENT_MAX_READERS]; // 0 = leitor fora de uma leitura
+    _Atomic int readerInUse[CONCURRENT_MAX_READERS];
+    LeaderboardSnapshot* retired; // aguardando os leitores, só com o mutex
+} ConcurrentLeaderboard;
+
+// 'store' e 'windows' podem ser NULL. Publica o primeiro snapshot a partir do que já está em 'board'.
+int initConcurrentLeaderboard(ConcurrentLeaderboard* shared, Leaderboard* board, LeaderboardStore* store, LeaderboardWindows* windows);
+void destroyConcurrentLeaderboard(ConcurrentLeaderboard* shared); // sem leitores ativos
+
+void concurrentUpdateScore(ConcurrentLeaderboard* shared, const char* name, int pointsToAdd);
+void concurrentApplyScoreBatch(ConcurrentLeaderboard* shared, const ScoreDelta* deltas, int count, char letter); // uma rodada
+int concurrentGetPlayerRank(ConcurrentLeaderboard* shared, const char* name); // passa pelo mutex
+void concurrentSetLocalPlayer(ConcurrentLeaderboard* shared, const char* name); // republica o snapshot
+
+// Gira as janelas que venceram e publica um snapshot novo. Fora do vencimento
+// é só uma leitura atômica, então pode ser chamada a cada quadro.
+void concurrentAdvanceWindows(ConcurrentLeaderboard* shared);
+
+// Cada thread leitora pega uma vaga (-1 se acabarem) e a devolve ao terminar
+int registerLeaderboardReader(ConcurrentLeaderboard* shared);
+void unregisterLeaderboardReader(ConcurrentLeaderboard* shared, int reader);
+
+// O snapshot vale até endLeaderboardRead; nunca bloqueia
+const LeaderboardSnapshot* beginLeaderboardRead(ConcurrentLeaderboard* shared, int reader);
+void endLeaderboardRead(ConcurrentLeaderboard* shared, int reader);
+
+#endif /* LEADERBOARD_CONCURRENT_H */
@@ -0,0 +1,224 @@
+#include "leaderboard_sharded.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lock_utils.h"
+
+// Usa os bits altos do hash: o índice de nomes de cada shard usa os baixos, e
+// se os dois usassem os mesmos bits cada shard só veria uma fração das posições.
+// O hash corta o nome como os placares cortam, então o mesmo jogador cai sempre no mesmo shard.
+static int shardOf(const ShardedLeaderboard* sharded, const char* name) {
+    return (int)(((uint64_t)hashPlayerName(name) * (uint64_t)sharded->shardCount) >> 32);
+}
+
+int initShardedLeaderboard(ShardedLeaderboard* sharded, int shardCount) {
+    if (!sharded || shardCount < 1 || shardCount > MAX_SHARDS) {
+        return 0;
+    }
+
+    sharded->shards = (LeaderboardShard*)calloc((size_t)shardCount, sizeof(LeaderboardShard));
+    sharded->shardCount = 0;
+    atomic_init(&sharded->nextSequence, 0);
+    if (sharded->shards == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < shardCount; i++) {
+        sharded->shards[i].lock = createLock();
+        if (sharded->shards[i].lock == NULL) {
+            freeShardedLeaderboard(sharded);
+            return 0;
+        }
+        setScoreSketch(&sharded->shards[i].board, &sharded->shards[i].sketch);
+        sharded->shardCount++;
+    }
+    return 1;
+}
+
+void freeShardedLeaderboard(ShardedLeaderboard* sharded) {
+    if (!sharded || sharded->shards == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < sharded->shardCount; i++) {
+        freeLeaderboard(&sharded->shards[i].board);
+        destroyLock(sharded->shards[i].lock);
+    }
+    free(sharded->shards);
+    sharded->shards = NULL;
+    sharded->shardCount = 0;
+}
+
+int bulkLoadShardedLeaderboard(ShardedLeaderboard* sharded, const PlayerScore* players, int count) {
+    if (!sharded || sharded->shards == NULL || (count > 0 && !players) || count < 0) {
+        return 0;
+    }
+
+    // Separa por shard mantendo a ordem de entrada (contagem + prefixos)
+    int starts[MAX_SHARDS + 1] = {0};
+    int* shardIndex = (int*)malloc(sizeof(int) * (size_t)(count > 0 ? count : 1));
+    int* origin = (int*)malloc(sizeof(int) * (size_t)(count > 0 ? count : 1));
+    PlayerScore* grouped = (PlayerScore*)malloc(sizeof(PlayerScore) * (size_t)(count > 0 ? count : 1));
+    if (shardIndex == NULL || origin == NULL || grouped == NULL) {
+        free(shardIndex);
+        free(origin);
+        free(grouped);
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        shardIndex[i] = shardOf(sharded, players[i].name);
+        starts[shardIndex[i] + 1]++;
+    }
+    for (int s = 0; s < sharded->shardCount; s++) {
+        starts[s + 1] += starts[s];
+    }
+    int next[MAX_SHARDS];
+    memcpy(next, starts, sizeof(int) * (size_t)sharded->shardCount);
+    for (int i = 0; i < count; i++) {
+        origin[next[shardIndex[i]]] = i;
+        grouped[next[shardIndex[i]]++] = players[i];
+    }
+
+    int ok = 1;
+    for (int s = 0; s < sharded->shardCount && ok; s++) {
+        LeaderboardShard* shard = &sharded->shards[s];
+        acquireLock(shard->lock);
+        ok = bulkLoadLeaderboard(&shard->board, grouped + starts[s], starts[s + 1] - starts[s]);
+        // A carga numera as sequências só dentro do shard; renumera pela posição na
+        // entrada inteira, como um placar só faria (a primeira aparição do nome vale).
+        // Nos empates a ordem dentro do shard é a mesma, então a árvore continua válida.
+        for (int i = starts[s + 1] - 1; ok && i >= starts[s]; i--) {
+            findByName(&shard->board, grouped[i].name)->sequence = (uint32_t)(count - origin[i]);
+        }
+        releaseLock(shard->lock);
+    }
+    atomic_store(&sharded->nextSequence, (uint32_t)count);
+
+    free(shardIndex);
+    free(origin);
+    free(grouped);
+    return ok;
+}
+
+void shardedUpdateScore(ShardedLeaderboard* sharded, const char* name, int pointsToAdd) {
+    if (!sharded || sharded->shards == NULL || !name) {
+        return;
+    }
+
+    LeaderboardShard* shard = &sharded->shards[shardOf(sharded, name)];
+    acquireLock(shard->lock);
+    // updateScore dá ao jogador a sequência seguinte à do placar; aqui ela vem do contador global
+    shard->board.nextSequence = atomic_fetch_add(&sharded->nextSequence, 1);
+    updateScore(&shard->board, name, pointsToAdd);
+    releaseLock(shard->lock);
+}
+
+int shardedGetPlayerCount(ShardedLeaderboard* sharded) {
+    if (!sharded || sharded->shards == NULL) {
+        return 0;
+    }
+
+    int total = 0;
+    for (int s = 0; s < sharded->shardCount; s++) {
+        acquireLock(sharded->shards[s].lock);
+        total += getPlayerCount(&sharded->shards[s].board);
+        releaseLock(sharded->shards[s].lock);
+    }
+    return total;
+}
+
+// Cabeça de cada lista no heap; o maior totalScore (e, no empate, a maior sequência) fica na raiz
+typedef struct {
+    const LeaderboardEntry* entry;
+    const LeaderboardEntry* end;
+} MergeCursor;
+
+static int cursorBefore(const MergeCursor* a, const MergeCursor* b) {
+    if (a->entry->totalScore != b->entry->totalScore) {
+        return a->entry->totalScore > b->entry->totalScore;
+    }
+    return a->entry->sequence > b->entry->sequence;
+}
+
+static void siftDown(MergeCursor* heap, int size, int index) {
+    for (;;) {
+        int best = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+        if (left < size && cursorBefore(&heap[left], &heap[best])) {
+            best = left;
+        }
+        if (right < size && cursorBefore(&heap[right], &heap[best])) {
+            best = right;
+        }
+        if (best == index) {
+            return;
+        }
+        MergeCursor swap = heap[index];
+        heap[index] = heap[best];
+        heap[best] = swap;
+        index = best;
+    }
+}
+
+int shardedGetTopK(ShardedLeaderboard* sharded, int k, LeaderboardEntry out[]) {
+    if (!sharded || sharded->shards == NULL || !out || k <= 0) {
+        return 0;
+    }
+
+    // Nenhum shard contribui com mais de k posições; o lock de cada um só fica
+    // preso enquanto o seu top-K é copiado
+    LeaderboardEntry* lists = (LeaderboardEntry*)malloc(sizeof(LeaderboardEntry) * (size_t)k * (size_t)sharded->shardCount);
+    if (lists == NULL) {
+        return 0;
+    }
+
+    MergeCursor heap[MAX_SHARDS];
+    int heapSize = 0;
+    for (int s = 0; s < sharded->shardCount; s++) {
+        LeaderboardShard* shard = &sharded->shards[s];
+        LeaderboardEntry* list = lists + (size_t)k * (size_t)s;
+        acquireLock(shard->lock);
+        int count = getTopK(&shard->board, k, list);
+        releaseLock(shard->lock);
+        if (count > 0) {
+            heap[heapSize].entry = list;
+            heap[heapSize].end = list + count;
+            heapSize++;
+        }
+    }
+    for (int i = heapSize / 2 - 1; i >= 0; i--) {
+        siftDown(heap, heapSize, i);
+    }
+
+    int count = 0;
+    while (count < k && heapSize > 0) {
+        out[count] = *heap[0].entry;
+        out[count].rank = count + 1;
+        count++;
+        if (++heap[0].entry == heap[0].end) {
+            heap[0] = heap[--heapSize];
+        }
+        siftDown(heap, heapSize, 0);
+    }
+
+    free(lists);
+    return count;
+}
+
+void shardedGetScoreSketch(ShardedLeaderboard* sharded, ScoreSketch* out) {
+    if (!out) {
+        return;
+    }
+
+    clearScoreSketch(out);
+    if (!sharded || sharded->shards == NULL) {
+        return;
+    }
+    for (int s = 0; s < sharded->shardCount; s++) {
+        acquireLock(sharded->shards[s].lock);
+        mergeScoreSketch(out, &sharded->shards[s].sketch);
+        releaseLock(sharded->shards[s].lock);
+    }
+}
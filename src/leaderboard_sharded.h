@@ -0,0 +1,47 @@
+#ifndef LEADERBOARD_SHARDED_H
+#define LEADERBOARD_SHARDED_H
+
+#include <stdatomic.h>
+
+#include "leaderboard.h"
+
+// Placar dividido em N pedaços (shards) pelo hash do nome, cada um com o seu
+// mutex. Atualizações de jogadores em shards diferentes não disputam o mesmo
+// lock; o top-K global junta o top-K de cada shard com um heap (merge de k vias).
+// O resultado não é um retrato atômico: cada shard é lido no seu próprio lock.
+// As sequências de desempate vêm de um contador único, então empates saem na
+// mesma ordem do placar sem shards: quem foi atualizado por último na frente.
+// Cada shard mantém também um histograma de pontuações; juntando os de todos dá
+// posição e percentil aproximados do placar inteiro.
+
+#define MAX_SHARDS 64
+
+typedef struct {
+    Leaderboard board;
+    ScoreSketch sketch;
+    void* lock;
+    char padding[64]; // afasta os campos quentes de shards vizinhos (false sharing)
+} LeaderboardShard;
+
+typedef struct {
+    LeaderboardShard* shards;
+    int shardCount;
+    _Atomic uint32_t nextSequence; // última sequência dada em qualquer shard
+} ShardedLeaderboard;
+
+int initShardedLeaderboard(ShardedLeaderboard* sharded, int shardCount); // 0 se faltar memória
+void freeShardedLeaderboard(ShardedLeaderboard* sharded);
+
+// Distribui os jogadores pelos shards e carrega cada um com bulkLoadLeaderboard
+int bulkLoadShardedLeaderboard(ShardedLeaderboard* sharded, const PlayerScore* players, int count);
+
+void shardedUpdateScore(ShardedLeaderboard* sharded, const char* name, int pointsToAdd);
+int shardedGetPlayerCount(ShardedLeaderboard* sharded);
+
+// Até k posições do placar inteiro, renumeradas de 1 em diante
+int shardedGetTopK(ShardedLeaderboard* sharded, int k, LeaderboardEntry out[]);
+
+// Soma os histogramas dos shards em 'out'
+void shardedGetScoreSketch(ShardedLeaderboard* sharded, ScoreSketch* out);
+
+#endif /* LEADERBOARD_SHARDED_H */
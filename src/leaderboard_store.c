@@ -0,0 +1,705 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // fileno, fsync
+#endif
+
+#include "leaderboard_store.h"
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lock_utils.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define SNAPSHOT_MAGIC "PLACAR01"
+#define SNAPSHOT_VERSION 1
+#define WAL_MAGIC "EVENTOS1"
+#define DEFAULT_SYNC_BATCH 32
+#define DEFAULT_COMPACT_EVERY 4096
+#define REPLAY_BATCH 1024
+
+// Formatos em disco (ordem de bytes da própria máquina)
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint32_t lastSequence; // último evento do WAL já incluído neste snapshot
+    uint32_t lastRoundId;  // 0 nos snapshots de antes do log de eventos
+} SnapshotHeader;
+
+typedef struct {
+    char name[50];
+    char reserved[2];
+    int32_t totalScore;
+} SnapshotRecord;
+
+// Cada segmento do WAL começa com WAL_MAGIC, seguido dos eventos gravados campo
+// a campo, sem preenchimento: sequência (4), rodada (4), horário (8), pontos (4),
+// letra (1), tamanho do nome (1), o nome sem '\0' e o checksum (4) dos bytes
+// anteriores, que detecta evento cortado por uma queda. "Jogador" ocupa 33 bytes.
+#define EVENT_HEADER_SIZE 22
+#define EVENT_MAX_SIZE (EVENT_HEADER_SIZE + LEADERBOARD_NAME_MAX + 4)
+
+typedef struct {
+    uint32_t sequence;
+    uint32_t roundId; // 0 = fora de rodada
+    int64_t timestamp;
+    int32_t points;
+    char letter;
+    char name[50];
+} ScoreEvent;
+
+// WAL de antes dos eventos (sem cabeçalho, registros fixos); ainda lido ao abrir
+typedef struct {
+    uint32_t sequence;
+    int32_t pointsToAdd;
+    char name[50];
+    char reserved[2];
+    uint32_t checksum;
+} LegacyWalRecord;
+
+// Eventos reaplicados em lotes de applyScoreBatch
+typedef struct {
+    ScoreDelta deltas[REPLAY_BATCH];
+    char names[REPLAY_BATCH][50];
+    int count;
+} ReplayBatch;
+
+// Snapshot a gravar. Em segundo plano, 'board' aponta para 'copy', um retrato da
+// árvore tirado na hora em que o WAL foi fechado.
+struct CompactionJob {
+    const Leaderboard* board;
+    Leaderboard copy;
+    uint32_t lastSequence;
+    uint32_t lastRoundId;
+    char snapshotPath[260];
+    char sealedPath[264];
+    int sync;
+    int ok;
+    atomic_int done;
+};
+
+typedef struct {
+    const unsigned char* data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} MappedFile;
+
+typedef struct {
+    FILE* file;
+    const Leaderboard* board;
+    int ok;
+} SnapshotWriter;
+
+static size_t encodeEvent(const ScoreEvent* event, unsigned char* buffer) {
+    uint8_t letter = (uint8_t)event->letter;
+    uint8_t nameLength = (uint8_t)strnlen(event->name, sizeof(event->name) - 1);
+    memcpy(buffer, &event->sequence, 4);
+    memcpy(buffer + 4, &event->roundId, 4);
+    memcpy(buffer + 8, &event->timestamp, 8);
+    memcpy(buffer + 16, &event->points, 4);
+    buffer[20] = letter;
+    buffer[21] = nameLength;
+    memcpy(buffer + EVENT_HEADER_SIZE, event->name, nameLength);
+
+    uint32_t checksum = hashBytes(buffer, EVENT_HEADER_SIZE + nameLength);
+    memcpy(buffer + EVENT_HEADER_SIZE + nameLength, &checksum, 4);
+    return EVENT_HEADER_SIZE + nameLength + 4;
+}
+
+// Bytes ocupados pelo evento; 0 se estiver cortado ou corrompido
+static size_t decodeEvent(const unsigned char* data, size_t available, ScoreEvent* event) {
+    if (available < EVENT_HEADER_SIZE) {
+        return 0;
+    }
+    size_t nameLength = data[21];
+    if (nameLength >= sizeof(event->name) || available < EVENT_HEADER_SIZE + nameLength + 4) {
+        return 0;
+    }
+    uint32_t checksum;
+    memcpy(&checksum, data + EVENT_HEADER_SIZE + nameLength, 4);
+    if (checksum != hashBytes(data, EVENT_HEADER_SIZE + nameLength)) {
+        return 0;
+    }
+
+    memcpy(&event->sequence, data, 4);
+    memcpy(&event->roundId, data + 4, 4);
+    memcpy(&event->timestamp, data + 8, 8);
+    memcpy(&event->points, data + 16, 4);
+    event->letter = (char)data[20];
+    memcpy(event->name, data + EVENT_HEADER_SIZE, nameLength);
+    event->name[nameLength] = '\0';
+    return EVENT_HEADER_SIZE + nameLength + 4;
+}
+
+static void syncFile(FILE* file) {
+    fflush(file);
+#ifdef _WIN32
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+}
+
+// Mapeia o arquivo inteiro só para leitura; 0 se não existir ou estiver vazio
+static int mapFile(const char* path, MappedFile* mapped) {
+    memset(mapped, 0, sizeof(*mapped));
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return 0;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    const void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (data == NULL) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return 0;
+    }
+    mapped->file = file;
+    mapped->mapping = mapping;
+    mapped->data = (const unsigned char*)data;
+    mapped->size = (size_t)size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+    void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return 0;
+    }
+    mapped->data = (const unsigned char*)data;
+    mapped->size = (size_t)info.st_size;
+#endif
+    return 1;
+}
+
+static void unmapFile(MappedFile* mapped) {
+#ifdef _WIN32
+    UnmapViewOfFile(mapped->data);
+    CloseHandle(mapped->mapping);
+    CloseHandle(mapped->file);
+#else
+    munmap((void*)mapped->data, mapped->size);
+#endif
+    mapped->data = NULL;
+}
+
+// Troca o snapshot antigo pelo novo de uma vez só
+static int replaceFile(const char* from, const char* to) {
+#ifdef _WIN32
+    return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (rename(from, to) != 0) {
+        return 0;
+    }
+
+    // O rename só está garantido no disco depois do fsync da pasta
+    char directory[260];
+    const char* slash = strrchr(to, '/');
+    if (slash == NULL) {
+        strcpy(directory, ".");
+    } else if (slash == to) {
+        strcpy(directory, "/");
+    } else {
+        snprintf(directory, sizeof(directory), "%.*s", (int)(slash - to), to);
+    }
+    int fd = open(directory, O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+    return 1;
+#endif
+}
+
+static void loadSnapshot(LeaderboardStore* store) {
+    MappedFile mapped;
+    if (!mapFile(store->snapshotPath, &mapped)) {
+        return;
+    }
+
+    const SnapshotHeader* header = (const SnapshotHeader*)mapped.data;
+    if (mapped.size < sizeof(SnapshotHeader) ||
+        memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != SNAPSHOT_VERSION ||
+        mapped.size != sizeof(SnapshotHeader) + (size_t)header->count * sizeof(SnapshotRecord)) {
+        fprintf(stderr, "Aviso: snapshot do placar inválido (%s), ignorando\n", store->snapshotPath);
+        unmapFile(&mapped);
+        return;
+    }
+
+    // Os registros já estão em ordem de posição, que a carga em lote preserva nos empates.
+    // Os nomes apontam direto para o arquivo mapeado, então cada um precisa terminar dentro do registro
+    const SnapshotRecord* records = (const SnapshotRecord*)(header + 1);
+    PlayerScore* players = (PlayerScore*)malloc(sizeof(PlayerScore) * (header->count > 0 ? header->count : 1));
+    if (players == NULL) {
+        fprintf(stderr, "Erro: falha ao alocar memória para o placar\n");
+        unmapFile(&mapped);
+        return;
+    }
+    for (uint32_t i = 0; i < header->count; i++) {
+        if (memchr(records[i].name, '\0', sizeof(records[i].name)) == NULL) {
+            fprintf(stderr, "Aviso: snapshot do placar inválido (%s), ignorando\n", store->snapshotPath);
+            free(players);
+            unmapFile(&mapped);
+            return;
+        }
+        players[i].name = records[i].name;
+        players[i].totalScore = records[i].totalScore;
+    }
+
+    if (bulkLoadLeaderboard(store->board, players, (int)header->count)) {
+        store->lastSequence = header->lastSequence;
+        store->lastRoundId = header->lastRoundId;
+    } else {
+        fprintf(stderr, "Erro: falha ao alocar memória para o placar\n");
+    }
+    free(players);
+
+    unmapFile(&mapped);
+}
+
+static void flushReplayBatch(LeaderboardStore* store, ReplayBatch* batch) {
+    if (!applyScoreBatch(store->board, batch->deltas, batch->count)) {
+        for (int i = 0; i < batch->count; i++) {
+            updateScore(store->board, batch->deltas[i].name, batch->deltas[i].points);
+        }
+    }
+    batch->count = 0;
+}
+
+// Eventos já cobertos pelo snapshot (queda entre gravá-lo e descartar o WAL) são pulados
+static int replayEvent(LeaderboardStore* store, ReplayBatch* batch, const ScoreEvent* event) {
+    if (event->sequence <= store->lastSequence) {
+        return 1;
+    }
+
+    if (batch != NULL) {
+        memcpy(batch->names[batch->count], event->name, sizeof(event->name));
+        batch->deltas[batch->count].name = batch->names[batch->count];
+        batch->deltas[batch->count].points = event->points;
+        if (++batch->count == REPLAY_BATCH) {
+            flushReplayBatch(store, batch);
+        }
+    } else {
+        updateScore(store->board, event->name, event->points);
+    }
+    store->lastSequence = event->sequence;
+    if (event->roundId > store->lastRoundId) {
+        store->lastRoundId = event->roundId;
+    }
+    store->walRecords++;
+    return 0;
+}
+
+// Reaplica um segmento do WAL; retorna 1 se ele precisa ser reescrito
+// (final cortado, eventos já no snapshot ou formato antigo)
+static int replaySegment(LeaderboardStore* store, ReplayBatch* batch, const char* path) {
+    MappedFile mapped;
+    if (!mapFile(path, &mapped)) {
+        return 0;
+    }
+
+    int needsCompaction = 0;
+    size_t offset;
+    ScoreEvent event;
+    memset(&event, 0, sizeof(event));
+    if (mapped.size >= sizeof(WAL_MAGIC) - 1 && memcmp(mapped.data, WAL_MAGIC, sizeof(WAL_MAGIC) - 1) == 0) {
+        offset = sizeof(WAL_MAGIC) - 1;
+        while (offset < mapped.size) {
+            size_t used = decodeEvent(mapped.data + offset, mapped.size - offset, &event);
+            if (used == 0) {
+                break;
+            }
+            needsCompaction |= replayEvent(store, batch, &event);
+            offset += used;
+        }
+    } else {
+        needsCompaction = 1;
+        for (offset = 0; offset + sizeof(LegacyWalRecord) <= mapped.size; offset += sizeof(LegacyWalRecord)) {
+            LegacyWalRecord record;
+            memcpy(&record, mapped.data + offset, sizeof(record));
+            if (record.checksum != hashBytes((const unsigned char*)&record, offsetof(LegacyWalRecord, checksum))) {
+                break;
+            }
+            event.sequence = record.sequence;
+            event.points = record.pointsToAdd;
+            memcpy(event.name, record.name, sizeof(event.name));
+            event.name[sizeof(event.name) - 1] = '\0';
+            replayEvent(store, batch, &event);
+        }
+    }
+    if (offset != mapped.size) {
+        fprintf(stderr, "Aviso: final do WAL do placar incompleto, descartando o último registro\n");
+        needsCompaction = 1;
+    }
+
+    unmapFile(&mapped);
+    return needsCompaction;
+}
+
+// O segmento fechado (se uma compactação em segundo plano não terminou) vem antes do atual
+static int replayWal(LeaderboardStore* store) {
+    ReplayBatch* batch = (ReplayBatch*)malloc(sizeof(ReplayBatch));
+    if (batch != NULL) {
+        batch->count = 0;
+    }
+
+    MappedFile sealed;
+    int needsCompaction = 0;
+    if (mapFile(store->sealedPath, &sealed)) {
+        unmapFile(&sealed);
+        store->sealedPending = 1;
+        needsCompaction = 1;
+        replaySegment(store, batch, store->sealedPath);
+    }
+    needsCompaction |= replaySegment(store, batch, store->walPath);
+
+    if (batch != NULL) {
+        flushReplayBatch(store, batch);
+        free(batch);
+    }
+    return needsCompaction;
+}
+
+// Segmento novo e vazio do WAL, já com o cabeçalho
+static FILE* createWalSegment(const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (file != NULL && fwrite(WAL_MAGIC, sizeof(WAL_MAGIC) - 1, 1, file) != 1) {
+        fclose(file);
+        file = NULL;
+    }
+    return file;
+}
+
+static void writeRecord(const PlayerNode* player, void* userData) {
+    SnapshotWriter* writer = (SnapshotWriter*)userData;
+    SnapshotRecord record;
+    memset(&record, 0, sizeof(record));
+    strncpy(record.name, getPlayerName(writer->board, player), sizeof(record.name) - 1);
+    record.totalScore = player->totalScore;
+    if (writer->ok && fwrite(&record, sizeof(record), 1, writer->file) != 1) {
+        writer->ok = 0;
+    }
+}
+
+// Em segundo plano, a árvore é copiada bloco a bloco (memcpy sequencial) e
+// percorrida depois na thread; na hora, o próprio placar é percorrido
+static CompactionJob* prepareCompaction(LeaderboardStore* store, int background) {
+    CompactionJob* job = (CompactionJob*)calloc(1, sizeof(CompactionJob));
+    if (job == NULL || (background && !copyLeaderboardTree(store->board, &job->copy))) {
+        fprintf(stderr, "Erro: falha ao alocar memória para o snapshot do placar\n");
+        free(job);
+        return NULL;
+    }
+
+    job->board = background ? &job->copy : store->board;
+    job->lastSequence = store->lastSequence;
+    job->lastRoundId = store->lastRoundId;
+    memcpy(job->snapshotPath, store->snapshotPath, sizeof(job->snapshotPath));
+    memcpy(job->sealedPath, store->sealedPath, sizeof(job->sealedPath));
+    job->sync = store->syncMode != STORE_SYNC_OFF;
+    atomic_init(&job->done, 0);
+    return job;
+}
+
+// Grava o snapshot e, com ele no lugar, apaga o segmento fechado que ele cobre.
+// Só mexe nos arquivos do snapshot e no segmento fechado, então roda em outra thread.
+static void runCompaction(void* argument) {
+    CompactionJob* job = (CompactionJob*)argument;
+    char temporaryPath[270];
+    snprintf(temporaryPath, sizeof(temporaryPath), "%s.tmp", job->snapshotPath);
+
+    FILE* file = fopen(temporaryPath, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Erro ao criar %s\n", temporaryPath);
+    } else {
+        SnapshotHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.count = (uint32_t)getPlayerCount(job->board);
+        header.lastSequence = job->lastSequence;
+        header.lastRoundId = job->lastRoundId;
+
+        SnapshotWriter writer = { file, job->board, fwrite(&header, sizeof(header), 1, file) == 1 };
+        forEachPlayer(job->board, writeRecord, &writer);
+        job->ok = writer.ok;
+        if (job->ok && job->sync) {
+            syncFile(file);
+        }
+        if (fclose(file) != 0) {
+            job->ok = 0;
+        }
+        if (!job->ok || !replaceFile(temporaryPath, job->snapshotPath)) {
+            fprintf(stderr, "Erro ao gravar o snapshot do placar\n");
+            remove(temporaryPath);
+            job->ok = 0;
+        } else {
+            remove(job->sealedPath);
+        }
+    }
+    atomic_store(&job->done, 1);
+}
+
+static void finishCompaction(LeaderboardStore* store, CompactionJob* job) {
+    if (job->ok) {
+        store->sealedPending = 0;
+    }
+    freeLeaderboard(&job->copy);
+    free(job);
+}
+
+static void waitBackgroundCompaction(LeaderboardStore* store) {
+    if (store->compactionThread != NULL) {
+        joinThread(store->compactionThread);
+        store->compactionThread = NULL;
+    }
+    if (store->compaction != NULL) {
+        finishCompaction(store, store->compaction);
+        store->compaction = NULL;
+    }
+}
+
+// Fecha o segmento atual do WAL (vira o segmento fechado), abre um novo e grava o
+// snapshot numa thread. Aqui só fica a cópia da árvore.
+static int compactInBackground(LeaderboardStore* store) {
+    if (store->sealedPending) {
+        return compactLeaderboardStore(store); // o segmento fechado anterior ainda não tem snapshot
+    }
+
+    CompactionJob* job = prepareCompaction(store, 1);
+    if (job == NULL) {
+        return 0;
+    }
+
+    if (store->syncMode != STORE_SYNC_OFF) {
+        syncFile(store->wal);
+    }
+    fclose(store->wal);
+    store->wal = NULL;
+    if (!replaceFile(store->walPath, store->sealedPath)) {
+        store->wal = fopen(store->walPath, "ab");
+        finishCompaction(store, job);
+        return 0;
+    }
+    store->sealedPending = 1;
+    store->walRecords = 0;
+    store->unsyncedRecords = 0;
+    store->wal = createWalSegment(store->walPath);
+    if (store->wal == NULL) {
+        fprintf(stderr, "Aviso: não foi possível reabrir %s; o placar não será salvo\n", store->walPath);
+    }
+
+    store->compaction = job;
+    store->compactionThread = startThread(runCompaction, job);
+    if (store->compactionThread == NULL) {
+        runCompaction(job);
+    }
+    return 1;
+}
+
+static void compactIfDue(LeaderboardStore* store) {
+    if (store->compaction != NULL && atomic_load(&store->compaction->done)) {
+        waitBackgroundCompaction(store);
+    }
+    if (store->wal == NULL || store->compactEvery <= 0 || store->walRecords < store->compactEvery) {
+        return;
+    }
+
+    if (!store->backgroundCompaction) {
+        compactLeaderboardStore(store);
+    } else if (store->compaction == NULL) {
+        compactInBackground(store);
+    }
+    // Com uma compactação ainda rodando, tenta de novo no próximo evento
+}
+
+int openLeaderboardStore(LeaderboardStore* store, Leaderboard* board, const char* basePath, StoreSyncMode syncMode) {
+    if (!store || !board || !basePath) {
+        return 0;
+    }
+
+    memset(store, 0, sizeof(*store));
+    snprintf(store->snapshotPath, sizeof(store->snapshotPath), "%s.dat", basePath);
+    snprintf(store->walPath, sizeof(store->walPath), "%s.wal", basePath);
+    snprintf(store->sealedPath, sizeof(store->sealedPath), "%s.1", store->walPath);
+    store->syncMode = syncMode;
+    store->syncBatch = DEFAULT_SYNC_BATCH;
+    store->compactEvery = DEFAULT_COMPACT_EVERY;
+    store->backgroundCompaction = 1;
+    store->board = board;
+
+    loadSnapshot(store);
+    int needsCompaction = replayWal(store);
+
+    store->wal = fopen(store->walPath, "ab");
+    if (store->wal == NULL) {
+        fprintf(stderr, "Aviso: não foi possível abrir %s; o placar não será salvo\n", store->walPath);
+        return 0;
+    }
+    fseek(store->wal, 0, SEEK_END);
+    if (ftell(store->wal) == 0 && fwrite(WAL_MAGIC, sizeof(WAL_MAGIC) - 1, 1, store->wal) != 1) {
+        needsCompaction = 1;
+    }
+
+    // Não dá para continuar acrescentando depois de um evento cortado
+    if (needsCompaction && !compactLeaderboardStore(store)) {
+        if (store->wal != NULL) {
+            fclose(store->wal);
+            store->wal = NULL;
+        }
+        return 0;
+    }
+    return 1;
+}
+
+static void appendEvent(LeaderboardStore* store, const char* name, int pointsToAdd, uint32_t roundId, char letter, int64_t timestamp) {
+    ScoreEvent event;
+    memset(&event, 0, sizeof(event));
+    event.sequence = store->lastSequence + 1;
+    event.roundId = roundId;
+    event.timestamp = timestamp;
+    event.points = pointsToAdd;
+    event.letter = letter;
+    strncpy(event.name, name, sizeof(event.name) - 1);
+
+    unsigned char buffer[EVENT_MAX_SIZE];
+    size_t size = encodeEvent(&event, buffer);
+    if (fwrite(buffer, 1, size, store->wal) == size) {
+        store->lastSequence = event.sequence;
+        store->walRecords++;
+        store->unsyncedRecords++;
+    } else {
+        fprintf(stderr, "Erro ao gravar no WAL do placar\n");
+    }
+}
+
+// Um fsync (ou só fflush) para todos os eventos acrescentados desde o último
+static void flushWal(LeaderboardStore* store) {
+    if (store->syncMode == STORE_SYNC_ALWAYS ||
+        (store->syncMode == STORE_SYNC_BATCHED && store->unsyncedRecords >= store->syncBatch)) {
+        syncFile(store->wal);
+        store->unsyncedRecords = 0;
+    } else {
+        fflush(store->wal);
+    }
+}
+
+void storeUpdateScore(LeaderboardStore* store, const char* name, int pointsToAdd) {
+    if (!store || !name) {
+        return;
+    }
+
+    // Primeiro o log, depois a memória
+    if (store->wal != NULL) {
+        appendEvent(store, name, pointsToAdd, 0, '\0', (int64_t)time(NULL));
+        flushWal(store);
+    }
+
+    updateScore(store->board, name, pointsToAdd);
+    compactIfDue(store);
+}
+
+void storeApplyScoreBatch(LeaderboardStore* store, const ScoreDelta* deltas, int count, char letter) {
+    if (!store || !deltas || count <= 0) {
+        return;
+    }
+
+    // Um evento por ponto recebido (a reaplicação soma do mesmo jeito), um fsync só
+    uint32_t roundId = ++store->lastRoundId;
+    if (store->wal != NULL) {
+        int64_t now = (int64_t)time(NULL);
+        for (int i = 0; i < count; i++) {
+            if (deltas[i].name) {
+                appendEvent(store, deltas[i].name, deltas[i].points, roundId, letter, now);
+            }
+        }
+        flushWal(store);
+    }
+
+    if (!applyScoreBatch(store->board, deltas, count)) {
+        for (int i = 0; i < count; i++) {
+            updateScore(store->board, deltas[i].name, deltas[i].points);
+        }
+    }
+    compactIfDue(store);
+}
+
+int compactLeaderboardStore(LeaderboardStore* store) {
+    if (!store || !store->board) {
+        return 0;
+    }
+
+    waitBackgroundCompaction(store);
+    CompactionJob* job = prepareCompaction(store, 0);
+    if (job == NULL) {
+        return 0;
+    }
+    runCompaction(job);
+    int ok = job->ok;
+    finishCompaction(store, job);
+    if (!ok) {
+        return 0;
+    }
+
+    // Tudo até lastSequence está no snapshot, então o WAL recomeça vazio
+    if (store->wal != NULL) {
+        fclose(store->wal);
+        store->wal = createWalSegment(store->walPath);
+        if (store->wal == NULL) {
+            fprintf(stderr, "Aviso: não foi possível reabrir %s; o placar não será salvo\n", store->walPath);
+        }
+    }
+    store->walRecords = 0;
+    store->unsyncedRecords = 0;
+    return 1;
+}
+
+void closeLeaderboardStore(LeaderboardStore* store) {
+    if (!store) {
+        return;
+    }
+
+    waitBackgroundCompaction(store);
+    if (store->wal == NULL) {
+        return;
+    }
+
+    if (!compactLeaderboardStore(store) && store->wal != NULL && store->syncMode != STORE_SYNC_OFF) {
+        syncFile(store->wal);
+    }
+    if (store->wal != NULL) {
+        fclose(store->wal);
+        store->wal = NULL;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef LEADERBOARD_STORE_H
+#define LEADERBOARD_STORE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "leaderboard.h"
+
+// Persistência do placar como log de eventos: cada pontuação vira um evento
+// (jogador, rodada, letra, pontos, horário) acrescentado a um log binário
+// compacto (o WAL). O placar em memória é só uma visão materializada desse log:
+// ao abrir, o último snapshot (registros fixos, mapeado na memória) é carregado
+// e a cauda do log reaplicada por cima. Compactar grava um snapshot novo e
+// descarta os eventos que ele já cobre; por padrão o snapshot é gravado numa
+// thread, enquanto os eventos novos vão para um segmento de log novo.
+
+typedef enum {
+    STORE_SYNC_ALWAYS,  // fsync a cada atualização
+    STORE_SYNC_BATCHED, // fsync a cada syncBatch atualizações, ao compactar e ao fechar
+    STORE_SYNC_OFF      // o sistema grava quando quiser
+} StoreSyncMode;
+
+typedef struct CompactionJob CompactionJob;
+
+typedef struct {
+    char snapshotPath[260];
+    char walPath[260];
+    char sealedPath[264];      // segmento fechado do WAL, até o snapshot que o cobre ser gravado
+    StoreSyncMode syncMode;
+    int syncBatch;             // usado em STORE_SYNC_BATCHED
+    int compactEvery;          // compacta sozinho quando o WAL chega a tantos eventos (0 = nunca)
+    int backgroundCompaction;  // 1 (padrão) = a compactação automática grava o snapshot numa thread
+    FILE* wal;                 // NULL = só em memória (não foi possível abrir o arquivo)
+    uint32_t lastSequence;
+    uint32_t lastRoundId;
+    int walRecords;
+    int unsyncedRecords;
+    int sealedPending;         // sealedPath existe e ainda não entrou em nenhum snapshot
+    Leaderboard* board;
+    void* compactionThread;    // NULL = nenhuma compactação em segundo plano rodando
+    CompactionJob* compaction;
+} LeaderboardStore;
+
+// Carrega snapshot + WAL em 'board' (que deve estar vazio) e deixa o WAL aberto.
+// 'basePath' sem extensão: usa basePath.dat e basePath.wal. Retorna 0 se não
+// conseguir abrir o WAL; o placar continua funcionando só em memória.
+int openLeaderboardStore(LeaderboardStore* store, Leaderboard* board, const char* basePath, StoreSyncMode syncMode);
+
+// Grava o evento no WAL e aplica no placar (fora de rodada: rodada 0, sem letra)
+void storeUpdateScore(LeaderboardStore* store, const char* name, int pointsToAdd);
+
+// Os pontos de uma rodada com a letra sorteada: ganham o próximo número de
+// rodada e um fsync só para o lote todo
+void storeApplyScoreBatch(LeaderboardStore* store, const ScoreDelta* deltas, int count, char letter);
+
+// Compacta na hora, esperando antes a compactação em segundo plano, se houver
+int compactLeaderboardStore(LeaderboardStore* store);
+
+// Compacta e fecha o WAL; o placar continua na memória
+void closeLeaderboardStore(LeaderboardStore* store);
+
+#endif /* LEADERBOARD_STORE_H */
@@ -0,0 +1,220 @@
+#include "leaderboard_windows.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const int windowBuckets[LEADERBOARD_WINDOW_COUNT] = { 24, 7 };
+static const int64_t windowBucketSeconds[LEADERBOARD_WINDOW_COUNT] = { 60 * 60, 24 * 60 * 60 };
+
+static int growBucketSlots(ScoreBucket* bucket, int capacity) {
+    uint32_t mask = (uint32_t)capacity - 1;
+    uint32_t* slots = (uint32_t*)calloc((size_t)capacity, sizeof(uint32_t));
+    if (slots == NULL) {
+        return 0;
+    }
+
+    for (int i = 0; i < bucket->count; i++) {
+        uint32_t index = bucket->entries[i].hash & mask;
+        while (slots[index] != 0) {
+            index = (index + 1) & mask;
+        }
+        slots[index] = (uint32_t)i + 1;
+    }
+
+    free(bucket->slots);
+    bucket->slots = slots;
+    bucket->slotCapacity = capacity;
+    return 1;
+}
+
+// Soma os pontos na entrada do jogador, criando-a se preciso; 0 se faltar memória
+static int addToBucket(ScoreBucket* bucket, const char* name, int pointsToAdd) {
+    char truncated[50];
+    strncpy(truncated, name, sizeof(truncated) - 1);
+    truncated[sizeof(truncated) - 1] = '\0';
+
+    uint32_t hash = hashPlayerName(truncated);
+    if (bucket->slotCapacity > 0) {
+        uint32_t mask = (uint32_t)bucket->slotCapacity - 1;
+        uint32_t index = hash & mask;
+        while (bucket->slots[index] != 0) {
+            BucketEntry* entry = &bucket->entries[bucket->slots[index] - 1];
+            if (entry->hash == hash && strcmp(entry->name, truncated) == 0) {
+                entry->points += pointsToAdd;
+                return 1;
+            }
+            index = (index + 1) & mask;
+        }
+    }
+
+    if (bucket->count == bucket->capacity) {
+        int capacity = bucket->capacity ? bucket->capacity * 2 : 16;
+        BucketEntry* entries = (BucketEntry*)realloc(bucket->entries, sizeof(BucketEntry) * (size_t)capacity);
+        if (entries == NULL) {
+            return 0;
+        }
+        bucket->entries = entries;
+        bucket->capacity = capacity;
+    }
+    if ((bucket->count + 1) * 2 > bucket->slotCapacity &&
+        !growBucketSlots(bucket, bucket->slotCapacity ? bucket->slotCapacity * 2 : 32)) {
+        return 0;
+    }
+
+    BucketEntry* entry = &bucket->entries[bucket->count];
+    entry->hash = hash;
+    entry->points = pointsToAdd;
+    memcpy(entry->name, truncated, sizeof(entry->name));
+
+    uint32_t mask = (uint32_t)bucket->slotCapacity - 1;
+    uint32_t index = hash & mask;
+    while (bucket->slots[index] != 0) {
+        index = (index + 1) & mask;
+    }
+    bucket->slots[index] = (uint32_t)++bucket->count;
+    return 1;
+}
+
+// Desconta o balde do placar da janela e o deixa vazio (a memória fica para o próximo uso)
+static void drainBucket(RollingWindow* window, ScoreBucket* bucket) {
+    for (int i = 0; i < bucket->count; i++) {
+        const BucketEntry* entry = &bucket->entries[i];
+        PlayerNode* player = findByName(&window->board, entry->name);
+        if (player == NULL) {
+            continue;
+        }
+        if (player->totalScore - entry->points == 0) {
+            removePlayer(&window->board, player);
+        } else {
+            updateScore(&window->board, entry->name, -entry->points);
+        }
+    }
+
+    bucket->count = 0;
+    if (bucket->slots != NULL) {
+        memset(bucket->slots, 0, sizeof(uint32_t) * (size_t)bucket->slotCapacity);
+    }
+}
+
+static int advanceWindow(RollingWindow* window, int64_t now) {
+    int64_t target = now / window->bucketSeconds;
+    if (target <= window->newestBucket) {
+        return 0; // relógio parado ou voltando: continua no balde atual
+    }
+
+    // Os baldes que vão receber os números newestBucket+1..target ainda guardam
+    // os mais velhos da janela; passado um giro inteiro, todos já saíram
+    int64_t steps = target - window->newestBucket;
+    if (steps > window->bucketCount) {
+        steps = window->bucketCount;
+    }
+    int changed = 0;
+    for (int64_t step = 1; step <= steps; step++) {
+        ScoreBucket* bucket = &window->buckets[(window->newestBucket + step) % window->bucketCount];
+        changed |= bucket->count > 0;
+        drainBucket(window, bucket);
+    }
+    window->newestBucket = target;
+    return changed;
+}
+
+int initLeaderboardWindows(LeaderboardWindows* windows, int64_t now) {
+    if (!windows) {
+        return 0;
+    }
+
+    memset(windows, 0, sizeof(LeaderboardWindows));
+    for (int i = 0; i < LEADERBOARD_WINDOW_COUNT; i++) {
+        RollingWindow* window = &windows->windows[i];
+        window->buckets = (ScoreBucket*)calloc((size_t)windowBuckets[i], sizeof(ScoreBucket));
+        if (window->buckets == NULL) {
+            freeLeaderboardWindows(windows);
+            return 0;
+        }
+        window->bucketCount = windowBuckets[i];
+        window->bucketSeconds = windowBucketSeconds[i];
+        window->newestBucket = now / window->bucketSeconds;
+    }
+    return 1;
+}
+
+void freeLeaderboardWindows(LeaderboardWindows* windows) {
+    if (!windows) {
+        return;
+    }
+
+    for (int i = 0; i < LEADERBOARD_WINDOW_COUNT; i++) {
+        RollingWindow* window = &windows->windows[i];
+        if (window->buckets != NULL) {
+            for (int b = 0; b < window->bucketCount; b++) {
+                free(window->buckets[b].entries);
+                free(window->buckets[b].slots);
+            }
+            free(window->buckets);
+            window->buckets = NULL;
+        }
+        freeLeaderboard(&window->board);
+    }
+}
+
+void recordWindowScore(LeaderboardWindows* windows, const char* name, int pointsToAdd, int64_t now) {
+    if (!windows || !name) {
+        return;
+    }
+
+    for (int i = 0; i < LEADERBOARD_WINDOW_COUNT; i++) {
+        RollingWindow* window = &windows->windows[i];
+        if (window->buckets == NULL) {
+            continue;
+        }
+        advanceWindow(window, now);
+        // Sem o balde, o desconto futuro não existiria; então o placar da janela também não muda
+        if (addToBucket(&window->buckets[window->newestBucket % window->bucketCount], name, pointsToAdd)) {
+            updateScore(&window->board, name, pointsToAdd);
+        }
+    }
+}
+
+int advanceLeaderboardWindows(LeaderboardWindows* windows, int64_t now) {
+    if (!windows) {
+        return 0;
+    }
+
+    int changed = 0;
+    for (int i = 0; i < LEADERBOARD_WINDOW_COUNT; i++) {
+        if (windows->windows[i].buckets != NULL) {
+            changed |= advanceWindow(&windows->windows[i], now);
+        }
+    }
+    return changed;
+}
+
+int64_t nextWindowRotation(const LeaderboardWindows* windows) {
+    int64_t next = INT64_MAX;
+    if (!windows) {
+        return next;
+    }
+
+    for (int i = 0; i < LEADERBOARD_WINDOW_COUNT; i++) {
+        const RollingWindow* window = &windows->windows[i];
+        if (window->buckets != NULL) {
+            int64_t boundary = (window->newestBucket + 1) * window->bucketSeconds;
+            if (boundary < next) {
+                next = boundary;
+            }
+        }
+    }
+    return next;
+}
+
+const Leaderboard* getWindowBoard(LeaderboardWindows* windows, LeaderboardWindow window, int64_t now) {
+    if (!windows || window < 0 || window >= LEADERBOARD_WINDOW_COUNT) {
+        return NULL;
+    }
+
+    RollingWindow* rolling = &windows->windows[window];
+    if (rolling->buckets != NULL) {
+        advanceWindow(rolling, now);
+    }
+    return &rolling->board;
+}
@@ -0,0 +1,62 @@
+#ifndef LEADERBOARD_WINDOWS_H
+#define LEADERBOARD_WINDOWS_H
+
+#include <stdint.h>
+
+#include "leaderboard.h"
+
+// Placares de janela deslizante (últimas 24h, últimos 7 dias) mantidos aos poucos.
+// Cada janela tem o seu próprio Leaderboard com a soma dos pontos dentro dela e
+// uma fila circular de baldes com o que entrou em cada hora (ou dia). Quando o
+// tempo passa de um balde, só o balde mais velho é descontado do placar da
+// janela; nada é recalculado a partir do histórico. Top-K e posição numa janela
+// custam o mesmo que no placar geral, porque é a mesma estrutura.
+
+typedef enum {
+    WINDOW_DAILY,  // 24 baldes de 1 hora
+    WINDOW_WEEKLY, // 7 baldes de 1 dia
+    LEADERBOARD_WINDOW_COUNT
+} LeaderboardWindow;
+
+// Pontos de um jogador dentro de um balde
+typedef struct {
+    uint32_t hash;
+    int points;
+    char name[50];
+} BucketEntry;
+
+typedef struct {
+    BucketEntry* entries;
+    int count;
+    int capacity;
+    uint32_t* slots;  // índice + 1 da entrada, 0 = livre; no máximo meio cheio
+    int slotCapacity; // potência de 2
+} ScoreBucket;
+
+typedef struct {
+    Leaderboard board;      // soma dos baldes vivos; quem volta a 0 ponto sai
+    ScoreBucket* buckets;   // fila circular: o balde de número b fica em b % bucketCount
+    int bucketCount;
+    int64_t bucketSeconds;
+    int64_t newestBucket;   // número (tempo / bucketSeconds) do balde que recebe os pontos agora
+} RollingWindow;
+
+typedef struct {
+    RollingWindow windows[LEADERBOARD_WINDOW_COUNT];
+} LeaderboardWindows;
+
+// 'now' em segundos (time(NULL)). Retorna 0 se faltar memória.
+int initLeaderboardWindows(LeaderboardWindows* windows, int64_t now);
+void freeLeaderboardWindows(LeaderboardWindows* windows);
+
+// Soma os pontos em todas as janelas, girando antes as que ficaram para trás
+void recordWindowScore(LeaderboardWindows* windows, const char* name, int pointsToAdd, int64_t now);
+
+// Descarta os baldes que saíram das janelas; retorna 1 se algum placar mudou
+int advanceLeaderboardWindows(LeaderboardWindows* windows, int64_t now);
+int64_t nextWindowRotation(const LeaderboardWindows* windows); // quando o próximo balde vence
+
+// Placar da janela já girado até 'now'; use getTopK, getPlayerRank etc. nele
+const Leaderboard* getWindowBoard(LeaderboardWindows* windows, LeaderboardWindow window, int64_t now);
+
+#endif /* LEADERBOARD_WINDOWS_H */
@@ -0,0 +1,108 @@
+#include "lock_utils.h"
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+typedef struct {
+    void (*function)(void*);
+    void* argument;
+#ifdef _WIN32
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+} Thread;
+
+void* createLock(void) {
+#ifdef _WIN32
+    CRITICAL_SECTION* lock = (CRITICAL_SECTION*)malloc(sizeof(CRITICAL_SECTION));
+    if (lock) {
+        InitializeCriticalSection(lock);
+    }
+    return lock;
+#else
+    pthread_mutex_t* lock = (pthread_mutex_t*)malloc(sizeof(pthread_mutex_t));
+    if (lock && pthread_mutex_init(lock, NULL) != 0) {
+        free(lock);
+        return NULL;
+    }
+    return lock;
+#endif
+}
+
+void destroyLock(void* lock) {
+#ifdef _WIN32
+    DeleteCriticalSection((CRITICAL_SECTION*)lock);
+#else
+    pthread_mutex_destroy((pthread_mutex_t*)lock);
+#endif
+    free(lock);
+}
+
+void acquireLock(void* lock) {
+#ifdef _WIN32
+    EnterCriticalSection((CRITICAL_SECTION*)lock);
+#else
+    pthread_mutex_lock((pthread_mutex_t*)lock);
+#endif
+}
+
+void releaseLock(void* lock) {
+#ifdef _WIN32
+    LeaveCriticalSection((CRITICAL_SECTION*)lock);
+#else
+    pthread_mutex_unlock((pthread_mutex_t*)lock);
+#endif
+}
+
+#ifdef _WIN32
+static DWORD WINAPI runThread(LPVOID argument) {
+    Thread* thread = (Thread*)argument;
+    thread->function(thread->argument);
+    return 0;
+}
+#else
+static void* runThread(void* argument) {
+    Thread* thread = (Thread*)argument;
+    thread->function(thread->argument);
+    return NULL;
+}
+#endif
+
+void* startThread(void (*function)(void*), void* argument) {
+    Thread* thread = (Thread*)malloc(sizeof(Thread));
+    if (thread == NULL) {
+        return NULL;
+    }
+    thread->function = function;
+    thread->argument = argument;
+#ifdef _WIN32
+    thread->handle = CreateThread(NULL, 0, runThread, thread, 0, NULL);
+    if (thread->handle == NULL) {
+        free(thread);
+        return NULL;
+    }
+#else
+    if (pthread_create(&thread->handle, NULL, runThread, thread) != 0) {
+        free(thread);
+        return NULL;
+    }
+#endif
+    return thread;
+}
+
+void joinThread(void* thread) {
+    Thread* running = (Thread*)thread;
+#ifdef _WIN32
+    WaitForSingleObject(running->handle, INFINITE);
+    CloseHandle(running->handle);
+#else
+    pthread_join(running->handle, NULL);
+#endif
+    free(running);
+}
@@ -0,0 +1,15 @@
+#ifndef LOCK_UTILS_H
+#define LOCK_UTILS_H
+
+// Mutex e threads do sistema (pthread ou Win32) atrás de ponteiros opacos,
+// para os módulos do placar não dependerem da SDL
+
+void* createLock(void); // NULL se faltar memória
+void destroyLock(void* lock);
+void acquireLock(void* lock);
+void releaseLock(void* lock);
+
+void* startThread(void (*function)(void*), void* argument); // NULL se não conseguir criar
+void joinThread(void* thread); // espera a thread terminar e libera o handle
+
+#endif /* LOCK_UTILS_H */
@@ -3,9 +3,13 @@
 #include <curl/curl.h>
 
 #include <stdio.h>
+#include <time.h>
 
 #include "game.h"
 #include "leaderboard.h"
+#include "leaderboard_concurrent.h"
+#include "leaderboard_store.h"
+#include "leaderboard_windows.h"
 #include "states/leaderboard_state.h"
 #include "states/menu_state.h"
 #include "states/options_state.h"
@@ -78,9 +82,37 @@ int main(int argc, char* argv[]) {
         context.isLetterEnabled[i] = 1;
     }
 
-    updateScore(&(context.leaderboard), "CPU 1", 50);
-    updateScore(&(context.leaderboard), "Jogador", 20);
-    updateScore(&(context.leaderboard), "CPU 2", 80);
+    openLeaderboardStore(&context.leaderboardStore, &context.leaderboard, "placar", STORE_SYNC_BATCHED);
+
+    // Os jogadores de exemplo só entram quando ainda não há placar salvo
+    if (getPlayerCount(&context.leaderboard) == 0) {
+        storeUpdateScore(&context.leaderboardStore, "CPU 1", 50);
+        storeUpdateScore(&context.leaderboardStore, LOCAL_PLAYER_NAME, 20);
+        storeUpdateScore(&context.leaderboardStore, "CPU 2", 80);
+    }
+
+    // As janelas de 24h e 7 dias começam vazias a cada execução
+    LeaderboardWindows* windows = &context.leaderboardWindows;
+    if (!initLeaderboardWindows(windows, (int64_t)time(NULL))) {
+        SDL_Log("Aviso: sem memória para os placares do dia e da semana.");
+        windows = NULL;
+    }
+
+    if (!initConcurrentLeaderboard(&context.sharedLeaderboard, &context.leaderboard, &context.leaderboardStore, windows)) {
+        SDL_Log("Erro fatal: não foi possível criar o placar compartilhado.");
+        freeLeaderboardWindows(&context.leaderboardWindows);
+        closeLeaderboardStore(&context.leaderboardStore);
+        freeLeaderboard(&(context.leaderboard));
+        TTF_CloseFont(context.font_title);
+        TTF_CloseFont(context.font_body);
+        SDL_DestroyRenderer(context.renderer);
+        SDL_DestroyWindow(context.window);
+        curl_global_cleanup();
+        TTF_Quit();
+        SDL_Quit();
+        return 1;
+    }
+    concurrentSetLocalPlayer(&context.sharedLeaderboard, LOCAL_PLAYER_NAME);
 
     GameState currentState = STATE_MENU;
     while (currentState != STATE_EXIT) {
@@ -107,6 +139,9 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    destroyConcurrentLeaderboard(&context.sharedLeaderboard);
+    freeLeaderboardWindows(&context.leaderboardWindows);
+    closeLeaderboardStore(&context.leaderboardStore);
     freeLeaderboard(&(context.leaderboard));
     TTF_CloseFont(context.font_title);
     TTF_CloseFont(context.font_body);
@@ -0,0 +1,183 @@
+#include "score_sketch.h"
+
+#include <string.h>
+
+#define SKETCH_MAGIC "ESBOCO01"
+
+static int highestBit(uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 31 - __builtin_clz(value);
+#else
+    int bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// Pontuações >= 0; as menores que SKETCH_SUB_BUCKETS têm balde próprio
+static int bucketOf(int score) {
+    uint32_t value = (uint32_t)score;
+    if (value < SKETCH_SUB_BUCKETS) {
+        return (int)value;
+    }
+    int shift = highestBit(value) - SKETCH_SUB_BITS;
+    return (shift + 1) * SKETCH_SUB_BUCKETS + (int)((value >> shift) - SKETCH_SUB_BUCKETS);
+}
+
+static int64_t bucketLow(int bucket) {
+    if (bucket < SKETCH_SUB_BUCKETS) {
+        return bucket;
+    }
+    int shift = bucket / SKETCH_SUB_BUCKETS - 1;
+    return (int64_t)(SKETCH_SUB_BUCKETS + bucket % SKETCH_SUB_BUCKETS) << shift;
+}
+
+static int64_t bucketWidth(int bucket) {
+    return bucket < SKETCH_SUB_BUCKETS ? 1 : (int64_t)1 << (bucket / SKETCH_SUB_BUCKETS - 1);
+}
+
+void clearScoreSketch(ScoreSketch* sketch) {
+    if (sketch) {
+        memset(sketch, 0, sizeof(*sketch));
+    }
+}
+
+void sketchAddScore(ScoreSketch* sketch, int score) {
+    if (!sketch) {
+        return;
+    }
+    if (score < 0) {
+        sketch->negative++;
+    } else {
+        sketch->counts[bucketOf(score)]++;
+    }
+    sketch->total++;
+}
+
+void sketchRemoveScore(ScoreSketch* sketch, int score) {
+    if (!sketch) {
+        return;
+    }
+    if (score < 0) {
+        sketch->negative--;
+    } else {
+        sketch->counts[bucketOf(score)]--;
+    }
+    sketch->total--;
+}
+
+void mergeScoreSketch(ScoreSketch* into, const ScoreSketch* from) {
+    if (!into || !from) {
+        return;
+    }
+
+    into->total += from->total;
+    into->negative += from->negative;
+    for (int i = 0; i < SKETCH_BUCKETS; i++) {
+        into->counts[i] += from->counts[i];
+    }
+}
+
+int64_t sketchApproximateRank(const ScoreSketch* sketch, int score) {
+    if (!sketch || sketch->total <= 0) {
+        return 1;
+    }
+
+    // Quantos ficam acima: os baldes de cima inteiros mais a fração do próprio balde
+    double above = 0.0;
+    if (score < 0) {
+        above = (double)(sketch->total - sketch->negative) + sketch->negative / 2.0;
+    } else {
+        int bucket = bucketOf(score);
+        for (int i = bucket + 1; i < SKETCH_BUCKETS; i++) {
+            above += (double)sketch->counts[i];
+        }
+        int64_t highest = bucketLow(bucket) + bucketWidth(bucket) - 1;
+        above += (double)sketch->counts[bucket] * (double)(highest - score) / (double)bucketWidth(bucket);
+    }
+    return 1 + (int64_t)(above + 0.5);
+}
+
+double sketchTopPercent(const ScoreSketch* sketch, int score) {
+    if (!sketch || sketch->total <= 0) {
+        return 100.0;
+    }
+    return 100.0 * (double)sketchApproximateRank(sketch, score) / (double)sketch->total;
+}
+
+int sketchScoreAtPercentile(const ScoreSketch* sketch, double percentile) {
+    if (!sketch || sketch->total <= 0) {
+        return 0;
+    }
+    if (percentile < 0.0) {
+        percentile = 0.0;
+    } else if (percentile > 100.0) {
+        percentile = 100.0;
+    }
+
+    // Sobe pelos baldes até acumular a fração pedida e interpola dentro do balde
+    double target = percentile / 100.0 * (double)sketch->total;
+    double seen = (double)sketch->negative;
+    if (target <= seen && sketch->negative > 0) {
+        return -1;
+    }
+    for (int i = 0; i < SKETCH_BUCKETS; i++) {
+        if (sketch->counts[i] <= 0) {
+            continue;
+        }
+        if (seen + (double)sketch->counts[i] >= target) {
+            double inside = (target - seen) / (double)sketch->counts[i];
+            int64_t score = bucketLow(i) + (int64_t)(inside * (double)(bucketWidth(i) - 1) + 0.5);
+            return score > INT32_MAX ? INT32_MAX : (int)score;
+        }
+        seen += (double)sketch->counts[i];
+    }
+    return INT32_MAX;
+}
+
+int writeScoreSketch(const ScoreSketch* sketch, FILE* file) {
+    if (!sketch || !file) {
+        return 0;
+    }
+
+    uint32_t buckets = SKETCH_BUCKETS;
+    return fwrite(SKETCH_MAGIC, 1, 8, file) == 8 &&
+           fwrite(&buckets, sizeof(buckets), 1, file) == 1 &&
+           fwrite(&sketch->total, sizeof(int64_t), 1, file) == 1 &&
+           fwrite(&sketch->negative, sizeof(int64_t), 1, file) == 1 &&
+           fwrite(sketch->counts, sizeof(int64_t), SKETCH_BUCKETS, file) == SKETCH_BUCKETS;
+}
+
+int readScoreSketch(ScoreSketch* sketch, FILE* file) {
+    if (!sketch || !file) {
+        return 0;
+    }
+
+    char magic[8];
+    uint32_t buckets = 0;
+    ScoreSketch loaded;
+    if (fread(magic, 1, 8, file) != 8 || memcmp(magic, SKETCH_MAGIC, 8) != 0 ||
+        fread(&buckets, sizeof(buckets), 1, file) != 1 || buckets != SKETCH_BUCKETS ||
+        fread(&loaded.total, sizeof(int64_t), 1, file) != 1 ||
+        fread(&loaded.negative, sizeof(int64_t), 1, file) != 1 ||
+        fread(loaded.counts, sizeof(int64_t), SKETCH_BUCKETS, file) != SKETCH_BUCKETS) {
+        return 0;
+    }
+
+    // Contagens precisam fechar com o total
+    int64_t sum = loaded.negative;
+    for (int i = 0; i < SKETCH_BUCKETS; i++) {
+        if (loaded.counts[i] < 0) {
+            return 0;
+        }
+        sum += loaded.counts[i];
+    }
+    if (loaded.negative < 0 || sum != loaded.total) {
+        return 0;
+    }
+
+    *sketch = loaded;
+    return 1;
+}
@@ -0,0 +1,41 @@
+#ifndef SCORE_SKETCH_H
+#define SCORE_SKETCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Histograma de pontuações com baldes fixos, para perguntas como "você está no
+// top 3%" sem depender do tamanho do placar. Até 32 os baldes são exatos; depois,
+// cada potência de 2 é dividida em 32 baldes iguais, então o erro relativo da
+// pontuação fica abaixo de ~3%. Pontuações negativas caem todas num balde só.
+// Adicionar ou tirar uma pontuação é O(1); as consultas percorrem os baldes
+// (número fixo). Dois histogramas se juntam somando os baldes, então shards e
+// processos diferentes podem ser combinados.
+
+#define SKETCH_SUB_BITS 5
+#define SKETCH_SUB_BUCKETS (1 << SKETCH_SUB_BITS)
+#define SKETCH_BUCKETS ((31 - SKETCH_SUB_BITS + 1) * SKETCH_SUB_BUCKETS)
+
+// Um ScoreSketch zerado ({0}) já é um histograma vazio válido
+typedef struct {
+    int64_t total;
+    int64_t negative;
+    int64_t counts[SKETCH_BUCKETS];
+} ScoreSketch;
+
+void clearScoreSketch(ScoreSketch* sketch);
+void sketchAddScore(ScoreSketch* sketch, int score);
+void sketchRemoveScore(ScoreSketch* sketch, int score);
+void mergeScoreSketch(ScoreSketch* into, const ScoreSketch* from);
+
+// Posição aproximada de quem tem 'score' (1 = primeiro), supondo as pontuações
+// espalhadas por igual dentro de cada balde
+int64_t sketchApproximateRank(const ScoreSketch* sketch, int score);
+double sketchTopPercent(const ScoreSketch* sketch, int score); // 3.0 = "top 3%"
+int sketchScoreAtPercentile(const ScoreSketch* sketch, double percentile); // 50.0 = mediana
+
+// Formato binário (cabeçalho + contagens) para juntar histogramas de outros processos
+int writeScoreSketch(const ScoreSketch* sketch, FILE* file);
+int readScoreSketch(ScoreSketch* sketch, FILE* file); // 0 se o arquivo não for um histograma válido
+
+#endif /* SCORE_SKETCH_H */
@@ -3,11 +3,87 @@
 #include <SDL3/SDL.h>
 
 #include <stdio.h>
+#include <string.h>
 
-#include "leaderboard.h"
+#include "leaderboard_concurrent.h"
 #include "render_utils.h"
 #include "text_utils.h"
 
+#define TOP_ENTRIES 5
+#define MAX_LINES (TOP_ENTRIES + 2 * CONCURRENT_NEIGHBORS + 1)
+
+// Visão 0 é o placar geral; as seguintes são as janelas, na ordem de LeaderboardWindow
+static const char* viewLabels[SNAPSHOT_VIEW_COUNT] = { "< Geral >", "< Últimas 24 horas >", "< Últimos 7 dias >" };
+
+// Linhas do top 5 (e da vizinhança do jogador local) já rasterizadas; só são
+// refeitas quando a visão ou a versão do placar muda
+typedef struct {
+    SDL_Texture* textures[MAX_LINES];
+    SDL_FRect rects[MAX_LINES];
+    int count;
+    int view;
+    uint32_t version;
+    int valid;
+} TopEntriesCache;
+
+static void destroyTopEntries(TopEntriesCache* cache) {
+    for (int i = 0; i < cache->count; i++) {
+        SDL_DestroyTexture(cache->textures[i]);
+        cache->textures[i] = NULL;
+    }
+    cache->count = 0;
+}
+
+static void addEntryLine(GameContext* context, TopEntriesCache* cache, const LeaderboardEntry* entry, int yPos) {
+    char scoreEntry[100];
+    sprintf(scoreEntry, "%d. %s - %d Pontos", entry->rank, entry->name, entry->totalScore);
+    SDL_Color color = strcmp(entry->name, LOCAL_PLAYER_NAME) == 0 ? context->colors.titleColor : context->colors.textColor;
+    int line = cache->count++;
+    createTextTexture(context, 0, scoreEntry, &cache->textures[line], &cache->rects[line], 0, yPos, color);
+    cache->rects[line].x = (SCREEN_WIDTH - cache->rects[line].w) / 2;
+}
+
+// O jogador local aparece destacado; se estiver abaixo do top 5, as posições em
+// volta dele vêm depois de um espaço
+static void rebuildTopEntries(GameContext* context, TopEntriesCache* cache, const SnapshotView* view) {
+    int count = view->count < TOP_ENTRIES ? view->count : TOP_ENTRIES;
+
+    destroyTopEntries(cache);
+    int yPos = 250;
+    for (int i = 0; i < count; i++) {
+        addEntryLine(context, cache, &view->top[i], yPos);
+        yPos += 50;
+    }
+
+    yPos += 20;
+    for (int i = 0; i < view->neighborCount; i++) {
+        if (view->neighbors[i].rank > count) {
+            addEntryLine(context, cache, &view->neighbors[i], yPos);
+            yPos += 50;
+        }
+    }
+}
+
+// Lê o snapshot publicado sem travar quem atualiza o placar
+static void refreshTopEntries(GameContext* context, TopEntriesCache* cache, int reader, int view) {
+    const LeaderboardSnapshot* snapshot = beginLeaderboardRead(&context->sharedLeaderboard, reader);
+    if (snapshot != NULL) {
+        const SnapshotView* current = &snapshot->views[view];
+        if (!cache->valid || cache->view != view || cache->version != current->version) {
+            rebuildTopEntries(context, cache, current);
+            cache->view = view;
+            cache->version = current->version;
+            cache->valid = 1;
+        }
+    }
+    endLeaderboardRead(&context->sharedLeaderboard, reader);
+}
+
+static void createViewLabel(GameContext* context, int view, SDL_Texture** texture, SDL_FRect* rect) {
+    createTextTexture(context, 0, viewLabels[view], texture, rect, 0, 180, context->colors.textColor);
+    rect->x = (SCREEN_WIDTH - rect->w) / 2;
+}
+
 GameState runLeaderboard(GameContext* context) {
     if (!context) {
         return STATE_EXIT;
@@ -24,14 +100,26 @@ GameState runLeaderboard(GameContext* context) {
 
     SDL_Texture* subtitleTexture = NULL;
     SDL_FRect subtitleRect;
-    createTextTexture(context, 0, "Pressione ESC para voltar", &subtitleTexture, &subtitleRect, 0, 650, white);
+    createTextTexture(context, 0, "Setas trocam o período - ESC para voltar", &subtitleTexture, &subtitleRect, 0, 650, white);
     subtitleRect.x = (SCREEN_WIDTH - subtitleRect.w) / 2;
 
+    int view = 0;
+    SDL_Texture* viewTexture = NULL;
+    SDL_FRect viewRect;
+    createViewLabel(context, view, &viewTexture, &viewRect);
+
+    int reader = registerLeaderboardReader(&context->sharedLeaderboard);
+    TopEntriesCache topEntries = {0};
+    refreshTopEntries(context, &topEntries, reader, view);
+
     int running_leaderboard = 1;
     SDL_Event event;
     while (running_leaderboard) {
         while (SDL_PollEvent(&event)) {
             if (event.type == SDL_EVENT_QUIT) {
+                unregisterLeaderboardReader(&context->sharedLeaderboard, reader);
+                destroyTopEntries(&topEntries);
+                SDL_DestroyTexture(viewTexture);
                 SDL_DestroyTexture(titleTexture);
                 SDL_DestroyTexture(subtitleTexture);
                 return STATE_EXIT;
@@ -39,6 +127,9 @@ GameState runLeaderboard(GameContext* context) {
             if (event.type == SDL_EVENT_KEY_DOWN) {
                 if (event.key.key == SDLK_ESCAPE) {
                     running_leaderboard = 0;
+                } else if (event.key.key == SDLK_RIGHT || event.key.key == SDLK_LEFT) {
+                    view = (view + (event.key.key == SDLK_RIGHT ? 1 : SNAPSHOT_VIEW_COUNT - 1)) % SNAPSHOT_VIEW_COUNT;
+                    createViewLabel(context, view, &viewTexture, &viewRect);
                 }
             }
         }
@@ -47,26 +138,19 @@ GameState runLeaderboard(GameContext* context) {
 
         SDL_RenderTexture(renderer, titleTexture, NULL, &titleRect);
         SDL_RenderTexture(renderer, subtitleTexture, NULL, &subtitleRect);
+        SDL_RenderTexture(renderer, viewTexture, NULL, &viewRect);
 
-        PlayerNode* current = context->leaderboard;
-        int yPos = 250;
-        int rank = 1;
-        while (current != NULL && rank <= 5) {
-            char scoreEntry[100];
-            sprintf(scoreEntry, "%d. %s - %d Pontos", rank, current->name, current->totalScore);
-            SDL_Texture* entryTexture = NULL;
-            SDL_FRect entryRect;
-            createTextTexture(context, 0, scoreEntry, &entryTexture, &entryRect, 0, yPos, white);
-            entryRect.x = (SCREEN_WIDTH - entryRect.w) / 2;
-            SDL_RenderTexture(renderer, entryTexture, NULL, &entryRect);
-            SDL_DestroyTexture(entryTexture);
-            current = current->next;
-            yPos += 50;
-            rank++;
+        concurrentAdvanceWindows(&context->sharedLeaderboard);
+        refreshTopEntries(context, &topEntries, reader, view);
+        for (int i = 0; i < topEntries.count; i++) {
+            SDL_RenderTexture(renderer, topEntries.textures[i], NULL, &topEntries.rects[i]);
         }
         SDL_RenderPresent(renderer);
     }
 
+    unregisterLeaderboardReader(&context->sharedLeaderboard, reader);
+    destroyTopEntries(&topEntries);
+    SDL_DestroyTexture(viewTexture);
     SDL_DestroyTexture(titleTexture);
     SDL_DestroyTexture(subtitleTexture);
     return STATE_MENU;
@@ -7,7 +7,7 @@
 #include <string.h>
 
 #include "ai_service.h"
-#include "leaderboard.h"
+#include "leaderboard_concurrent.h"
 #include "text_utils.h"
 
 static void trimTrailingWhitespace(char* str) {
@@ -100,7 +100,10 @@ GameState runScoring(GameContext* context) {
         }
     }
 
-    updateScore(&(context->leaderboard), "Jogador", scoreThisRound);
+    // Os pontos da rodada entram no placar como um lote só, registrado com a letra
+    ScoreDelta roundDeltas[] = { { LOCAL_PLAYER_NAME, scoreThisRound } };
+    concurrentApplyScoreBatch(&context->sharedLeaderboard, roundDeltas, (int)(sizeof(roundDeltas) / sizeof(roundDeltas[0])),
+                              context->lastLetter);
 
     SDL_Texture* titleTexture = NULL;
     SDL_FRect titleRect;